@@ -1,527 +1,1968 @@
-////////////////////////////////////////////////////////////////////////////////
-/// @file LoadMap.cpp
-///     Implementation of an IDA plugin, which loads a VC++/BCC map file.
-/// @par Purpose:
-///     An IDA plugin, which loads a VC/Borland/Dede map file into IDA Database.
-///     Based on the idea of loadmap plugin by Toshiyuki Tega.
-/// @author TQN <truong_quoc_ngan@yahoo.com>
-/// @author TL <mefistotelis@gmail.com>
-/// @date 2004.09.11 - 2018.11.08
-/// @version 1.3 - 2018.11.08 - Compiling in VS2010, SDK from IDA 7.0
-/// @version 1.2 - 2012.07.18 - Loading GCC MAP files, compiling in IDA 6.2
-/// @version 1.1 - 2011.09.13 - Loading Watcom MAP files, compiling in IDA 6.1
-/// @version 1.0 - 2004.09.11 - Initial release
-/// @par  Copying and copyrights:
-///     This program is free software; you can redistribute it and/or modify
-///     it under the terms of the GNU General Public License as published by
-///     the Free Software Foundation; either version 2 of the License, or
-///     (at your option) any later version.
-///     IDA Pro SDK by Hex-rays is required to use this software; that
-///     SDK has more complex licensing situation, and is not under GPL.
-////////////////////////////////////////////////////////////////////////////////
-#define PLUG_VERSION "1.4"
-//  standard library headers.
-#include <cstdio>
-// Makes gcc stdlib to not define non-underscored versions of non-ANSI functions (ie memicmp, strlwr)
-#define _NO_OLDNAMES
-#include <cstring>
-#undef _NO_OLDNAMES
-
-//  other headers.
-#include  "MAPReader.h"
-#include "stdafx.h"
-
-//#define USE_STANDARD_FILE_FUNCTIONS
-//#define USE_DANGEROUS_FUNCTIONS
-
-// IDA SDK Header Files
-#include <ida.hpp>
-#include <idp.hpp>
-#include <loader.hpp>
-#include <kernwin.hpp>
-#include <diskio.hpp>
-#include <bytes.hpp>
-#include <name.hpp>
-#include <entry.hpp>
-#include <fpro.h>
-#include <err.h> // for qerrstr()
-#include <prodir.h> // just for MAXPATH
-
-
-typedef struct _tagPLUGIN_OPTIONS {
-    int bNameApply;    //< true - apply to name, false - apply to comment
-    int bReplace;      //< replace the existing name or comment
-    int bVerbose;      //< show detail messages
-} PLUGIN_OPTIONS;
-
-const size_t g_minLineLen = 14; // For a "xxxx:xxxxxxxx " line
-
-/// @brief Global variable for options of plugin
-static PLUGIN_OPTIONS g_options = { 0 };
-
-static const cfgopt_t g_optsinfo[] =
-{
-    cfgopt_t("NAME_APPLY", &g_options.bNameApply, 0, 1),
-    cfgopt_t("REPLACE_EXISTING", &g_options.bReplace, 0, 1),
-    cfgopt_t("VERBOSE_MESSAGES", &g_options.bVerbose, 0, 1),
-};
-
-////////////////////////////////////////////////////////////////////////////////
-/// @name Ini Section and Key names
-/// @{
-static char g_szLoadMapSection[] = "LoadMap";
-static char g_szOptionsKey[] = "Options";
-/// @}
-
-#ifdef __EA64__
-void linearAddressToSymbolAddr(MapFile::MAPSymbol &sym, unsigned long long linear_addr)
-#else
-void linearAddressToSymbolAddr(MapFile::MAPSymbol &sym, unsigned long linear_addr)
-#endif
-{
-    sym.seg = get_segm_num(linear_addr);
-    segment_t * sseg = getnseg((int) sym.seg);
-    if (sseg != NULL)
-        sym.addr = linear_addr - sseg->start_ea;
-    else
-        sym.addr = -1;
-}
-
-
-////////////////////////////////////////////////////////////////////////////////
-/// @brief Output a formatted string to messages window [analog of printf()]
-///     only when the verbose flag of plugin's options is true
-/// @param  format const char * printf() style message string.
-/// @return void
-/// @author TQN
-/// @date 2004.09.11
- ////////////////////////////////////////////////////////////////////////////////
-void showMsg(const char *format, ...)
-{
-    if (g_options.bVerbose)
-    {
-        va_list va;
-        va_start(va, format);
-        (void) vmsg(format, va);
-        va_end(va);
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-/// @brief Show options dialog for getting user desired options
-/// @return void
-/// @author TQN
-/// @date 2004.09.11
-////////////////////////////////////////////////////////////////////////////////
-static void showOptionsDlg(void)
-{
-    // Build the format string constant used to create the dialog
-    const char format[] =
-        "STARTITEM 0\n"                             // TabStop
-        "LoadMap Options\n"                         // Title
-        "<Apply Map Symbols for Name:R>\n"          // Radio Button 0
-        "<Apply Map Symbols for Comment:R>>\n"    // Radio Button 1
-        "<Replace Existing Names/Comments:C>>\n"  // Checkbox Button
-        "<Show verbose messages:C>>\n\n";           // Checkbox Button
-
-    // Create the option dialog.
-    short name = (g_options.bNameApply ? 0 : 1);
-    short replace = (g_options.bReplace ? 1 : 0);
-    short verbose = (g_options.bVerbose ? 1 : 0);
-    if (ask_form(format, &name, &replace, &verbose))
-    {
-        g_options.bNameApply = (0 == name);
-        g_options.bReplace = (1 == replace);
-        g_options.bVerbose = (1 == verbose);
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-/// @brief Write-side equivalent of read_config_file() from IDA API
-/// @return True if saved
-/// @author TL
-/// @date 2023.11.22
- ////////////////////////////////////////////////////////////////////////////////
-bool write_config_file(
-        const char *filename,
-        const cfgopt_t opts[],
-        size_t nopts)
-{
-    char szLine[120];
-    char szIniPath[MAXPATH] = { 0 };
-    int fh, i;
-
-    // Get the full path to user config dir
-    qstrncpy(szIniPath, get_user_idadir(), sizeof(szIniPath));
-    qstrncat(szIniPath, "/", sizeof(szIniPath));
-    qstrncat(szIniPath, filename, sizeof(szIniPath));
-    qstrncat(szIniPath, ".cfg", sizeof(szIniPath));
-    szIniPath[sizeof(szIniPath) - 1] = '\0';
-
-    fh = qcreate(szIniPath, 0644);
-    if (fh == -1)
-        return false;
-
-    qsnprintf(szLine, sizeof(szLine), "//\n// LoadMap Plugin auto-saved configuration file\n//\n");
-    qwrite(fh, szLine, qstrlen(szLine));
-
-    // Write config in normal IDA format (like the files in IDA/cfg folder).
-    // IDA Pro does not provide an API for that - only for reading.
-
-    for (i = 0; i < nopts; i++)
-    {
-        const cfgopt_t *opt = &opts[i];
-
-        qsnprintf(szLine, sizeof(szLine), "%s = %d\n", opt->name, *(int *)(opt->ptr));
-        qwrite(fh, szLine, qstrlen(szLine));
-    }
-    qclose(fh);
-
-    return true;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-/// @brief Plugin initialize function
-/// @return PLUGIN_KEEP always
-/// @author TQN
-/// @date 2004.09.11
- ////////////////////////////////////////////////////////////////////////////////
-static plugmod_t *idaapi init()
-{
-    msg("\nLoadMap: Plugin v%s init.\n\n", PLUG_VERSION);
-
-    // Get options saved in cfg file; IDA Pro will find the file, it does
-    // not need the full path nor extension, only base name.
-    if (!read_config_file("loadmap", g_optsinfo, qnumber(g_optsinfo), NULL))
-    {
-        msg("LoadMap: Plugin config file '%s.cfg' read failed: %s.\n", "loadmap", qerrstr());
-    }
-
-#if IDA_SDK_VERSION >= 800
-    switch (inf_get_filetype())
-#else
-    switch (inf.filetype)
-#endif
-    {
-    case f_ZIP:
-        return PLUGIN_SKIP;
-    }
-    return PLUGIN_KEEP;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-/// @brief Plugin run function, which does the actual job
-/// @param   int    Not used
-/// @return void
-/// @author TQN
-/// @date 2004.09.11
-////////////////////////////////////////////////////////////////////////////////
-bool idaapi run(size_t)
-{
-    static char mapFileName[_MAX_PATH] = { 0 };
-
-    { // If user press shift key, show options dialog
-#if IDA_SDK_VERSION >= 800
-        input_event_t input_event;
-        if (get_user_input_event(&input_event) && (input_event.modifiers & VES_SHIFT))
-#else
-        // Windows-only method
-        if (GetAsyncKeyState(VK_SHIFT) & 0x8000)
-#endif
-        {
-            showOptionsDlg();
-        }
-    }
-
-    unsigned long numOfSegs = get_segm_qty();
-    if (0 == numOfSegs)
-    {
-        warning("Not found any segments");
-        return false;
-    }
-
-    if ('\0' == mapFileName[0])
-    {
-        // First run (after all, mapFileName is static)
-        get_input_file_path(mapFileName, sizeof(mapFileName));
-        pathExtensionSwitch(mapFileName, ".map", sizeof(mapFileName));
-    }
-
-    // Show open map file dialog
-    char *fname = ask_file(0, mapFileName, "Open MAP file");
-    if (NULL == fname)
-    {
-        msg("LoadMap: User cancel\n");
-        return false;
-    }
-
-    // Open the map file
-    char * pMapStart = NULL;
-    size_t mapSize = INVALID_MAPFILE_SIZE;
-    MapFile::MAPResult eRet = MapFile::openMAP(fname, pMapStart, mapSize);
-    switch (eRet)
-    {
-        case MapFile::WIN32_ERROR:
-            warning("Could not open file '%s'.\nWin32 Error Code = 0x%08X",
-                    fname, GetLastError());
-            return false;
-
-        case MapFile::FILE_EMPTY_ERROR:
-            warning("File '%s' is empty, zero size", fname);
-            return false;
-
-        case MapFile::FILE_BINARY_ERROR:
-            warning("File '%s' seem to be a binary or Unicode file", fname);
-            return false;
-
-        case MapFile::OPEN_NO_ERROR:
-        default:
-            break;
-    }
-
-    MapFile::SectionType sectnHdr = MapFile::NO_SECTION;
-    unsigned long sectnNumber = 0;
-    unsigned long validSyms = 0;
-    unsigned long invalidSyms = 0;
-
-    // The mark pointer to the end of memory map file
-    // all below code must not read or write at and over it
-    const char * pMapEnd = pMapStart + mapSize;
-
-    show_wait_box("Parsing and applying symbols from the Map file '%s'", fname);
-
-    try
-    {
-        const char * pLine = pMapStart;
-        const char * pEOL = pMapStart;
-        MapFile::MAPSymbol sym;
-        MapFile::MAPSymbol prvsym;
-        sym.seg = SREG_NUM;
-        sym.addr = BADADDR;
-        sym.name[0] = '\0';
-        while (pLine < pMapEnd)
-        {
-            // Skip the spaces, '\r', '\n' characters, blank lines, seek to the
-            // non space character at the beginning of a non blank line
-            pLine = MapFile::skipSpaces(pEOL, pMapEnd);
-
-            // Find the EOL '\r' or '\n' characters
-            pEOL = MapFile::findEOL(pLine, pMapEnd);
-
-            size_t lineLen = (size_t) (pEOL - pLine);
-            if (lineLen < g_minLineLen)
-            {
-                continue;
-            }
-            char fmt[80];
-            fmt[0] = '\0';
-
-            // Check if we're on section header or section end
-            if (sectnHdr == MapFile::NO_SECTION)
-            {
-                sectnHdr = MapFile::recognizeSectionStart(pLine, lineLen);
-                if (sectnHdr != MapFile::NO_SECTION)
-                {
-                    sectnNumber++;
-                    qsnprintf(fmt, sizeof(fmt), "Section start line: '%%.%ds'.\n", lineLen);
-                    showMsg(fmt, pLine);
-                    continue;
-                }
-            } else
-            {
-                sectnHdr = MapFile::recognizeSectionEnd(sectnHdr, pLine, lineLen);
-                if (sectnHdr == MapFile::NO_SECTION)
-                {
-                    qsnprintf(fmt, sizeof(fmt), "Section end line: '%%.%ds'.\n", lineLen);
-                    showMsg(fmt, pLine);
-                    continue;
-                }
-            }
-            MapFile::ParseResult parsed;
-            prvsym.seg = sym.seg;
-            prvsym.addr = sym.addr;
-            qstrncpy(prvsym.name,sym.name,sizeof(sym.name));
-            sym.seg = SREG_NUM;
-            sym.addr = BADADDR;
-            sym.name[0] = '\0';
-            parsed = MapFile::INVALID_LINE;
-
-            switch (sectnHdr)
-            {
-            case MapFile::NO_SECTION:
-                parsed = MapFile::SKIP_LINE;
-                break;
-            case MapFile::MSVC_MAP:
-            case MapFile::BCCL_NAM_MAP:
-            case MapFile::BCCL_VAL_MAP:
-                parsed = parseMsSymbolLine(sym,pLine,lineLen,g_minLineLen,numOfSegs);
-                break;
-            case MapFile::WATCOM_MAP:
-                parsed = parseWatcomSymbolLine(sym,pLine,lineLen,g_minLineLen,numOfSegs);
-                break;
-            case MapFile::GCC_MAP:
-                parsed = parseGccSymbolLine(sym,pLine,lineLen,g_minLineLen,numOfSegs);
-                break;
-            }
-
-            if (parsed == MapFile::SKIP_LINE)
-            {
-                qsnprintf(fmt, sizeof(fmt), "Skipping line: '%%.%ds'.\n", lineLen);
-                showMsg(fmt, pLine);
-                continue;
-            }
-            if (parsed == MapFile::FINISHING_LINE)
-            {
-                sectnHdr = MapFile::NO_SECTION;
-                // we have parsed to end of value/name symbols table or reached EOF
-                qsnprintf(fmt, sizeof(fmt), "Parsing finished at line: '%%.%ds'.\n", lineLen);
-                showMsg(fmt, pLine);
-                continue;
-            }
-            if (parsed == MapFile::INVALID_LINE)
-            {
-                invalidSyms++;
-                qsnprintf(fmt, sizeof(fmt), "Invalid map line: %%.%ds.\n", lineLen);
-                showMsg(fmt, pLine);
-                continue;
-            }
-            // If shouldn't apply names
-            bool bNameApply = (g_options.bNameApply != 0);
-            if (parsed == MapFile::COMMENT_LINE)
-            {
-                qsnprintf(fmt, sizeof(fmt), "Comment line: %%.%ds.\n", lineLen);
-                showMsg(fmt, pLine);
-                if (BADADDR == sym.addr)
-                    continue;
-            }
-            // Determine the DeDe map file
-            char *pname = sym.name;
-            if (('<' == pname[0]) && ('-' == pname[1]))
-            {
-                // Functions indicator symbol of DeDe map
-                pname += 2;
-                bNameApply = true;
-            }
-            else if ('*' == pname[0])
-            {
-                // VCL controls indicator symbol of DeDe map
-                pname++;
-                bNameApply = false;
-            }
-            else if (('-' == pname[0]) && ('>' == pname[1]))
-            {
-                // VCL methods indicator symbol of DeDe map
-                pname += 2;
-                bNameApply = false;
-            }
-
-            ea_t la = sym.addr + getnseg((int) sym.seg)->start_ea;
-            flags_t f = get_full_flags(la);
-
-            bool didOk;
-            if (bNameApply) // Apply symbols for name
-            {
-                //  Add name if there's no meaningful name assigned.
-                if (g_options.bReplace ||
-                    (!has_name(f) || has_dummy_name(f) || has_auto_name(f)))
-                {
-                    didOk = set_name(la, pname, SN_NOCHECK | SN_NOWARN);
-#ifdef __EA64__
-                    showMsg("%04lX:%08llX - Change name to '%s' %s\n",
-                        sym.seg, la, pname, didOk ? "succeeded" : "failed");
-#else
-                    showMsg("%04lX:%08lX - Change name to '%s' %s\n",
-                        sym.seg, la, pname, didOk ? "succeeded" : "failed");
-#endif
-                }
-            }
-            else if (g_options.bReplace || !has_cmt(f))
-            {
-                // Apply symbols for comment
-                didOk = set_cmt(la, pname, false);
-#ifdef __EA64__
-                showMsg("%04lX:%08llX - Change comment to '%s' %s\n",
-                    sym.seg, la, pname, didOk ? "succeeded" : "failed");
-#else
-                showMsg("%04lX:%08lX - Change comment to '%s' %s\n",
-                    sym.seg, la, pname, didOk ? "succeeded" : "failed");
-#endif
-            }
-            if (didOk)
-                validSyms++;
-            else
-                invalidSyms++;
-        }
-
-    }
-    catch (...)
-    {
-        warning("Exception while parsing MAP file '%s'");
-        invalidSyms++;
-    }
-    MapFile::closeMAP(pMapStart);
-    hide_wait_box();
-
-    if (sectnNumber == 0)
-    {
-        warning("File '%s' is not a valid Map file; publics section header wasn't found", fname);
-    }
-    else
-    {
-        // Save file name for next askfile_c dialog
-        qstrncpy(mapFileName, fname, sizeof(mapFileName));
-
-        // Show the result
-        msg("Result of loading and parsing the Map file '%s'\n"
-            "   Number of Symbols applied: %d\n"
-            "   Number of Invalid Symbols: %d\n\n",
-            fname, validSyms, invalidSyms);
-    }
-    return true;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-/// @brief Plugin terminate callback function
-/// @return void
-/// @author TQN
-/// @date 2004.09.11
-////////////////////////////////////////////////////////////////////////////////
-void idaapi term(void)
-{
-    msg("LoadMap: Plugin v%s terminate.\n", PLUG_VERSION);
-
-    // Write the plugin's options to cfg file
-    if (!write_config_file("loadmap", g_optsinfo, qnumber(g_optsinfo)))
-    {
-        msg("LoadMap: Plugin config file '%s.cfg' save failed: %s.\n", "loadmap", qerrstr());
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-/// @name Plugin information
-/// @{
-char wanted_name[]   = "Load Symbols From MAP File";
-char wanted_hotkey[] = "Ctrl-M";
-char comment[]       = "LoadMap loads symbols from a VC/BC/Watcom/Dede map file.";
-char help[]          = "LoadMap " PLUG_VERSION ", Visual C/Borland C/Watcom C/Dede map file import plugin."
-                              "This module reads selected map file, and loads symbols\n"
-                              "into IDA database. Click it while holding Shift to see options.";
-/// @}
-
-////////////////////////////////////////////////////////////////////////////////
-/// @brief Plugin description block
-extern "C" {
-plugin_t PLUGIN =
-{
-    IDP_INTERFACE_VERSION,
-    0,                    // Plugin flags
-    init,                 // Initialize
-    term,                 // Terminate
-    run,                  // Main function
-    comment,              // Comment about the plugin
-    help,
-    wanted_name,          // preferred short name of the plugin
-    wanted_hotkey         // preferred hotkey to run the plugin
-};
-};
-////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+/// @file LoadMap.cpp
+///     Implementation of an IDA plugin, which loads a VC++/BCC map file.
+/// @par Purpose:
+///     An IDA plugin, which loads a VC/Borland/Dede map file into IDA Database.
+///     Based on the idea of loadmap plugin by Toshiyuki Tega.
+/// @author TQN <truong_quoc_ngan@yahoo.com>
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2004.09.11 - 2018.11.08
+/// @version 1.3 - 2018.11.08 - Compiling in VS2010, SDK from IDA 7.0
+/// @version 1.2 - 2012.07.18 - Loading GCC MAP files, compiling in IDA 6.2
+/// @version 1.1 - 2011.09.13 - Loading Watcom MAP files, compiling in IDA 6.1
+/// @version 1.0 - 2004.09.11 - Initial release
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+///     IDA Pro SDK by Hex-rays is required to use this software; that
+///     SDK has more complex licensing situation, and is not under GPL.
+////////////////////////////////////////////////////////////////////////////////
+#define PLUG_VERSION "1.4"
+//  standard library headers.
+#include <cstdio>
+// Makes gcc stdlib to not define non-underscored versions of non-ANSI functions (ie memicmp, strlwr)
+#define _NO_OLDNAMES
+#include <cstring>
+#undef _NO_OLDNAMES
+#include <algorithm>
+#include <chrono>
+
+//  other headers.
+#include  "MAPReader.h"
+#include  "MAPParser.h"
+#include  "MAPSymbols.h"
+#include  "MAPSegments.h"
+#include  "MAPLogger.h"
+#include  "MAPCache.h"
+#include  "MAPHash.h"
+#include  "MAPHistory.h"
+#include  "MAPStream.h"
+#include  "MAPDemangle.h"
+#include  "MAPProgress.h"
+#include  "MAPMetrics.h"
+#include  "MAPJournal.h"
+#include  "MAPWriter.h"
+#include  "MAPFilter.h"
+#include "stdafx.h"
+
+//#define USE_STANDARD_FILE_FUNCTIONS
+//#define USE_DANGEROUS_FUNCTIONS
+
+// IDA SDK Header Files
+#include <ida.hpp>
+#include <idp.hpp>
+#include <loader.hpp>
+#include <kernwin.hpp>
+#include <diskio.hpp>
+#include <bytes.hpp>
+#include <name.hpp>
+#include <netnode.hpp>
+#include <nalt.hpp>
+#include <lines.hpp>
+#include <auto.hpp>
+#include <entry.hpp>
+#include <demangle.hpp>
+#include <fpro.h>
+#include <err.h> // for qerrstr()
+#include <prodir.h> // just for MAXPATH
+
+
+typedef struct _tagPLUGIN_OPTIONS {
+    int bNameApply;    //< true - apply to name, false - apply to comment
+    int bReplace;      //< replace the existing name or comment
+    int bVerbose;      //< show detail messages
+    int parseThreads;  //< amount of parsing threads, 0 - one per CPU core
+    int bLogToFile;    //< copy messages to a log file next to the MAP file
+    int bUseCache;     //< keep parsed symbols in index file next to the MAP file
+    int bIncremental;  //< only touch symbols which changed since previous import
+    int bStreamInput;  //< read the MAP file in blocks instead of mapping it to memory
+    int bMultiFile;    //< ask for a list of MAP files instead of a single file
+    int mergePolicy;   //< which file wins at conflicting addresses, MapFile::MAPMergePolicy
+    int demangleNames; //< where demangled names are put, DEMANGLE_TARGET
+    int bWriteMetrics; //< append timing and counters of each import to a JSON Lines file
+    int bLineNumbers;  //< import source line numbers and files from line number tables
+    int bDeferAnalysis; //< suspend auto-analysis while applying, then reanalyse changed ranges once
+    int bFilterSymbols; //< ask for a filter selecting symbols to import by segment, address, object or name
+} PLUGIN_OPTIONS;
+
+/// Where demangled forms of symbol names are stored.
+typedef enum {
+    DEMANGLE_OFF = 0,       //< names are not demangled
+    DEMANGLE_TO_COMMENT,    //< regular comment, or repeatable if symbol is applied as comment
+    DEMANGLE_TO_REPEATABLE, //< repeatable comment
+} DEMANGLE_TARGET;
+
+const size_t g_minLineLen = 14; // For a "xxxx:xxxxxxxx " line
+const size_t g_applyPollSymbols = 256; // Symbols applied between checks for cancel
+const size_t g_applyPollLines = 4096; // Line numbers applied between checks for cancel
+const size_t g_exportPollNames = 65536; // Names exported between checks for cancel
+const ea_t g_reanalysisGap = 0x1000; // Largest gap between changed items joined into one reanalysis range
+
+
+/// @brief Global variable for options of plugin
+static PLUGIN_OPTIONS g_options = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+static const cfgopt_t g_optsinfo[] =
+{
+    cfgopt_t("NAME_APPLY", &g_options.bNameApply, 0, 1),
+    cfgopt_t("REPLACE_EXISTING", &g_options.bReplace, 0, 1),
+    cfgopt_t("VERBOSE_MESSAGES", &g_options.bVerbose, 0, 1),
+    cfgopt_t("PARSE_THREADS", &g_options.parseThreads, 0, 256),
+    cfgopt_t("LOG_TO_FILE", &g_options.bLogToFile, 0, 1),
+    cfgopt_t("USE_INDEX_CACHE", &g_options.bUseCache, 0, 1),
+    cfgopt_t("INCREMENTAL_IMPORT", &g_options.bIncremental, 0, 1),
+    cfgopt_t("STREAM_INPUT", &g_options.bStreamInput, 0, 1),
+    cfgopt_t("MULTI_FILE_INPUT", &g_options.bMultiFile, 0, 1),
+    cfgopt_t("MERGE_POLICY", &g_options.mergePolicy, 0, 2),
+    cfgopt_t("DEMANGLE_NAMES", &g_options.demangleNames, 0, 2),
+    cfgopt_t("WRITE_METRICS", &g_options.bWriteMetrics, 0, 1),
+    cfgopt_t("LINE_NUMBERS", &g_options.bLineNumbers, 0, 1),
+    cfgopt_t("DEFER_ANALYSIS", &g_options.bDeferAnalysis, 0, 1),
+    cfgopt_t("FILTER_SYMBOLS", &g_options.bFilterSymbols, 0, 1),
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Ini Section and Key names
+/// @{
+static char g_szLoadMapSection[] = "LoadMap";
+static char g_szOptionsKey[] = "Options";
+/// @}
+
+/// @brief File in user IDA folder which receives metrics of imports
+static char g_szMetricsFileName[] = "loadmap_metrics.jsonl";
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Netnodes which keep record of symbols applied by previous import;
+/// there is one for each set of MAP files, named by hash of the file names
+/// @{
+static char g_szHistoryNodePrefix[] = "$ loadmap ";
+static const uchar g_historyTag = 'A';
+/// Netnode listing the record netnodes, most recently used first
+static char g_szHistoryIndexName[] = "$ loadmap history index";
+/// Records kept; older ones are removed from the database
+static const size_t g_historyNodeLimit = 8;
+/// @}
+
+/// @name Journal of changes made by the last import, to revert it
+/// @{
+static char g_szJournalNodeName[] = "$ loadmap journal";
+static const uchar g_journalTag = 'J';
+/// @}
+
+/// @brief Actions of the plugin, selected by its argument or in options dialog
+typedef enum {
+    ACTION_IMPORT = 0,      //< import symbols from MAP files
+    ACTION_REVERT,          //< revert changes made by the last import
+    ACTION_EXPORT_JOURNAL,  //< write journal of the last import to a file
+    ACTION_REPLAY_JOURNAL,  //< make changes from a journal file in this database
+    ACTION_EXPORT_MAP,      //< write names of this database to a MAP file
+    ACTION_COUNT
+} PLUGIN_ACTION;
+
+/// @brief MAP file selected for loading, with its parsing state
+typedef struct _tagMAP_INPUT {
+    std::string fileName;
+    char * pMapStart;
+    size_t mapSize;
+    bool mapped;        //< file is memory mapped, and waits for parsing
+    bool loaded;        //< symbols were taken from the file
+    bool useCache;
+    MapFile::MAPCacheKey cacheKey;
+    MapFile::MAPParseResult parsed;
+    unsigned long numSymbols;
+    std::string problem; //< reason why the file was not loaded
+} MAP_INPUT;
+
+/// @brief Address range of changed items, to be analysed again after the import
+typedef struct _tagREANALYSIS_RANGE {
+    ea_t start;
+    ea_t end;
+} REANALYSIS_RANGE;
+
+/// @brief Messages of the plugin; verbose ones are only enabled by plugin's options
+static MapFile::MAPLogger g_log;
+
+/// @brief Demangled names, kept between imports
+static MapFile::MAPDemangleCache g_demangleCache;
+
+/// @brief Timing and counters of the current import
+static MapFile::MAPMetrics g_metrics;
+
+/// @brief Seconds per applied symbol of the last import with auto-analysis
+/// running, including the wait for the analysis to finish; used to estimate
+/// time saved by suspending it; negative if not known
+static double g_analysisApplyCost = -1.0;
+
+/// @brief Amount of names and comments set or failed by the current import
+static unsigned long long appliedItemCount(void)
+{
+    return g_metrics.counter(MapFile::METRIC_NAMES_SET) + g_metrics.counter(MapFile::METRIC_NAMES_FAILED) +
+        g_metrics.counter(MapFile::METRIC_COMMENTS_SET) + g_metrics.counter(MapFile::METRIC_COMMENTS_FAILED);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Outputs a block of collected messages to messages window
+/// @param  text NUL-terminated text of the messages
+/// @return void
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void outputWindowSink(const char *text)
+{
+    msg("%s", text);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Demangles a name with IDA demangler; for MAPDemangleCache
+/// @param  name The mangled name
+/// @param  demangled Receives the demangled name
+/// @return True if the name was demangled
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool idaDemangle(const char *name, std::string &demangled)
+{
+    qstring text;
+    if (demangle_name(&text, name, MNG_LONG_FORM, DQT_FULL) <= 0)
+        return false;
+    demangled.assign(text.c_str(), text.length());
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Shows progress of the import in the wait box; for MAPProgress
+/// @param  progress The progress to show
+/// @return False if user pressed Cancel in the wait box
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool idaShowProgress(const MapFile::MAPProgress &progress)
+{
+    const double bytesPerMB = 1024.0 * 1024.0;
+    char amount[128] = "";
+    if (progress.inBytes())
+    {
+        if (progress.total() > 0)
+        {
+            qsnprintf(amount, sizeof(amount), "\n%.1f of %.1f MB, %.1f MB/s", progress.done() / bytesPerMB,
+                progress.total() / bytesPerMB, progress.rate() / bytesPerMB);
+        }
+        else
+        {
+            qsnprintf(amount, sizeof(amount), "\n%.1f MB, %.1f MB/s", progress.done() / bytesPerMB,
+                progress.rate() / bytesPerMB);
+        }
+    }
+    else if (progress.total() > 0)
+    {
+        qsnprintf(amount, sizeof(amount), "\n%lu of %lu symbols, %.0f symbols/s", (unsigned long)progress.done(),
+            (unsigned long)progress.total(), progress.rate());
+    }
+    char timeLeft[48] = "";
+    double secondsLeft = progress.secondsLeft();
+    if (secondsLeft >= 0.0)
+        qsnprintf(timeLeft, sizeof(timeLeft), ", %lu s left", (unsigned long)(secondsLeft + 0.5));
+    replace_wait_box("%s%s%s", progress.phase(), amount, timeLeft);
+    return !user_cancelled();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives name of netnode with record of imports of given MAP files
+/// @param  inputs The MAP files; only the loaded ones are taken into account
+/// @param  nodeName Receives the netnode name
+/// @return void
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void historyNodeName(const std::vector<MAP_INPUT> &inputs, qstring &nodeName)
+{
+    // Base names are used, so that a MAP file rebuilt in another folder matches
+    std::string key;
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        if (!inputs[i].loaded)
+            continue;
+        key.append(qbasename(inputs[i].fileName.c_str()));
+        key.push_back(';');
+    }
+    char hashText[24];
+    qsnprintf(hashText, sizeof(hashText), "%016llX",
+        MapFile::hashBuffer(key.data(), key.size(), 0));
+    nodeName = g_szHistoryNodePrefix;
+    nodeName += hashText;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads record of symbols applied by previous import from the database
+/// @param  nodeName Name of the netnode with the record, from historyNodeName()
+/// @param  prevApplied Receives the applied symbols
+/// @return True if a valid record was found
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool loadImportHistory(const char *nodeName, MapFile::MAPSymbolTable &prevApplied)
+{
+    prevApplied.clear();
+    netnode node(nodeName, 0, false);
+    if (node == BADNODE)
+        return false;
+    bytevec_t blob;
+    if ((node.getblob(&blob, 0, g_historyTag) <= 0) || blob.empty())
+        return false;
+    return MapFile::deserializeAppliedSymbols(&blob[0], blob.size(), prevApplied);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Stores record of symbols applied by current import in the database.
+/// Only records of the most recently imported sets of files are kept.
+/// @param  nodeName Name of the netnode with the record, from historyNodeName()
+/// @param  applied The applied symbols
+/// @return True if the record was saved
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool saveImportHistory(const char *nodeName, const MapFile::MAPSymbolTable &applied)
+{
+    // Record of this set of files goes first in the index, records beyond the limit are removed
+    netnode index(g_szHistoryIndexName, 0, true);
+    std::vector<qstring> recent;
+    recent.push_back(qstring(nodeName));
+    qstring name;
+    for (nodeidx_t idx = 0; index.supstr(&name, idx) > 0; idx++)
+    {
+        if (name != recent[0])
+            recent.push_back(name);
+    }
+    for (size_t i = 0; i < recent.size(); i++)
+    {
+        if (i < g_historyNodeLimit)
+        {
+            index.supset((nodeidx_t)i, recent[i].c_str());
+            continue;
+        }
+        index.supdel((nodeidx_t)i);
+        netnode old(recent[i].c_str(), 0, false);
+        if (old != BADNODE)
+            old.kill();
+    }
+
+    netnode node(nodeName, 0, true);
+    std::vector<unsigned char> blob;
+    MapFile::serializeAppliedSymbols(applied, blob);
+    node.delblob(0, g_historyTag);
+    return node.setblob(&blob[0], blob.size(), 0, g_historyTag) ? true : false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads journal of the last import from the database
+/// @param  journal Receives the journal
+/// @return True if a valid journal was found
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool loadImportJournal(MapFile::MAPJournal &journal)
+{
+    journal.clear();
+    netnode node(g_szJournalNodeName, 0, false);
+    if (node == BADNODE)
+        return false;
+    bytevec_t blob;
+    if ((node.getblob(&blob, 0, g_journalTag) <= 0) || blob.empty())
+        return false;
+    return journal.deserialize(&blob[0], blob.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Stores journal of the current import in the database
+/// It replaces the journal of previous import; only the last one is kept.
+/// @param  journal The journal, with entries ordered by finish()
+/// @return True if the journal was saved
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool saveImportJournal(const MapFile::MAPJournal &journal)
+{
+    netnode node(g_szJournalNodeName, 0, true);
+    std::vector<unsigned char> blob;
+    journal.serialize(blob);
+    node.delblob(0, g_journalTag);
+    return node.setblob(&blob[0], blob.size(), 0, g_journalTag) ? true : false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks whether name or comment at given address was set by previous import
+/// @param  la Address to check
+/// @param  bNameApply True to check the name, false to check the comment
+/// @param  prevApplied Record of previous import
+/// @param  prevFirst First record entry at the address
+/// @param  prevCount Amount of record entries at the address
+/// @return True if current value is one of the recorded ones
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool isPrevImportValue(ea_t la, bool bNameApply, const MapFile::MAPSymbolTable &prevApplied,
+    size_t prevFirst, size_t prevCount)
+{
+    if (prevCount == 0)
+        return false;
+    qstring curr;
+    if (bNameApply)
+        curr = get_name(la);
+    else if (get_cmt(&curr, la, false) < 0)
+        return false;
+    for (size_t k = prevFirst; k < prevFirst + prevCount; k++)
+    {
+        if ((curr.length() == prevApplied.nameLen(k)) &&
+            (memcmp(curr.c_str(), prevApplied.name(k), curr.length()) == 0))
+            return true;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Expands list of MAP files given by user into file names
+/// @param  spec The file name, or list of names separated by ';'; folders
+///         and names with wildcards are expanded into matching MAP files
+/// @param  isList True if spec may contain several names
+/// @param  fileNames Receives the file names, in order of the list
+/// @return void
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void expandMapFileList(const char *spec, bool isList, std::vector<std::string> &fileNames)
+{
+    fileNames.clear();
+    const char * pos = spec;
+    while (*pos != '\0')
+    {
+        const char * sep = isList ? strchr(pos, ';') : NULL;
+        const char * end = (sep != NULL) ? sep : (pos + strlen(pos));
+        const char * first = pos;
+        while ((first < end) && ((*first == ' ') || (*first == '\t')))
+            first++;
+        const char * last = end;
+        while ((last > first) && ((last[-1] == ' ') || (last[-1] == '\t')))
+            last--;
+        pos = (sep != NULL) ? (sep + 1) : end;
+        if (first == last)
+            continue;
+
+        std::string item(first, last - first);
+        char pattern[MAXPATH];
+        if (qisdir(item.c_str()))
+            qmakepath(pattern, sizeof(pattern), item.c_str(), "*.map", NULL);
+        else
+            qstrncpy(pattern, item.c_str(), sizeof(pattern));
+        if (strpbrk(pattern, "*?") == NULL)
+        {
+            fileNames.push_back(pattern);
+            continue;
+        }
+        // Matches of each pattern are sorted, so that order of merging
+        // does not depend on the file system
+        char dirName[MAXPATH];
+        if (!qdirname(dirName, sizeof(dirName), pattern))
+            dirName[0] = '\0';
+        size_t firstMatch = fileNames.size();
+        qffblk64_t fileBlk;
+        if (qfindfirst(pattern, &fileBlk, 0) != 0)
+            continue;
+        do
+        {
+            char path[MAXPATH];
+            if (dirName[0] != '\0')
+                qmakepath(path, sizeof(path), dirName, fileBlk.ff_name, NULL);
+            else
+                qstrncpy(path, fileBlk.ff_name, sizeof(path));
+            fileNames.push_back(path);
+        } while (qfindnext(&fileBlk) == 0);
+        qfindclose(&fileBlk);
+        std::sort(fileNames.begin() + firstMatch, fileNames.end());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Stores the reason why a MAP file could not be loaded
+/// @param  input The MAP file
+/// @param  format Message format string, followed by its arguments
+/// @return void
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void setInputProblem(MAP_INPUT &input, const char *format, ...)
+{
+    char text[MAXPATH + 160];
+    va_list va;
+    va_start(va, format);
+    qvsnprintf(text, sizeof(text), format, va);
+    va_end(va);
+    input.problem = text;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Opens a MAP file, and gets its symbols if they can be had at once
+/// @param  input The MAP file; if it stays mapped, it waits for parsing
+/// @param  segments The segments snapshot
+/// @param  parseOpts Options of parsing
+/// @return True if the file was opened, false if problem was stored
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool openMapInput(MAP_INPUT &input, const MapFile::MAPSegmentMap &segments,
+    const MapFile::MAPParseOptions &parseOpts)
+{
+    const char * fname = input.fileName.c_str();
+    MapFile::MAPResult eRet = MapFile::OS_ERROR;
+    unsigned long errCode = 0;
+    g_metrics.startPhase(MapFile::PHASE_OPEN);
+    if (!g_options.bStreamInput)
+    {
+        eRet = MapFile::openMAP(fname, input.pMapStart, input.mapSize);
+        errCode = MapFile::getLastErrorCode();
+    }
+    // Pipes and files which cannot be mapped are read in blocks instead
+    MapFile::MAPStreamReader mapStream;
+    bool streamed = false;
+    if (eRet == MapFile::OS_ERROR)
+    {
+        MapFile::MAPResult streamRet = mapStream.open(fname);
+        streamed = (streamRet == MapFile::OPEN_NO_ERROR);
+        if (streamed || g_options.bStreamInput)
+        {
+            eRet = streamRet;
+            errCode = mapStream.errorCode();
+        }
+    }
+    switch (eRet)
+    {
+        case MapFile::OS_ERROR:
+            setInputProblem(input, "Could not open file '%s'.\nSystem Error Code = 0x%08lX",
+                    fname, errCode);
+            return false;
+
+        case MapFile::FILE_EMPTY_ERROR:
+            setInputProblem(input, "File '%s' is empty, zero size", fname);
+            return false;
+
+        case MapFile::FILE_BINARY_ERROR:
+            setInputProblem(input, "File '%s' seem to be a binary or Unicode file", fname);
+            return false;
+
+        case MapFile::OPEN_NO_ERROR:
+        default:
+            break;
+    }
+    if (!streamed)
+        g_metrics.add(MapFile::METRIC_FILE_BYTES, input.mapSize);
+
+    // Reuse symbols parsed before, if the MAP file and segments did not change
+    g_metrics.startPhase(MapFile::PHASE_CACHE);
+    std::string cacheFileName(fname);
+    cacheFileName.append(MAP_CACHE_EXTENSION);
+    // Index cache keeps all symbols of the file, so filtered import does not use it
+    input.useCache = !streamed && g_options.bUseCache && (parseOpts.filter == NULL) &&
+        MapFile::makeCacheKey(fname, input.pMapStart, input.mapSize, segments, parseOpts, input.cacheKey);
+    MapFile::MAPCacheResult cacheRes = MapFile::CACHE_MISSING;
+    if (input.useCache)
+    {
+        cacheRes = MapFile::loadSymbolCache(cacheFileName.c_str(), input.cacheKey, segments,
+            input.parsed.symbols, input.parsed.stats);
+    }
+    if (cacheRes == MapFile::CACHE_HIT)
+    {
+        g_metrics.add(MapFile::METRIC_CACHE_HITS, 1);
+        MAPLOG(g_log, MapFile::LOGLVL_INFO, "LoadMap: Loaded %lu symbols from index cache '%s'.\n",
+            (unsigned long)input.parsed.symbols.size(), cacheFileName.c_str());
+        input.useCache = false;
+        MapFile::closeMAP(input.pMapStart, input.mapSize);
+        return true;
+    }
+    if (cacheRes != MapFile::CACHE_MISSING)
+    {
+        MAPLOG(g_log, MapFile::LOGLVL_INFO, "LoadMap: Index cache '%s' is %s, parsing the MAP file.\n",
+            cacheFileName.c_str(), MapFile::getCacheResultName(cacheRes));
+    }
+    if (!streamed)
+    {
+        // Mapped files are parsed together, when all are opened
+        input.mapped = true;
+        return true;
+    }
+    // Streamed file is parsed while next block is being read
+    g_metrics.startPhase(MapFile::PHASE_PARSE);
+    if (parseOpts.progress != NULL)
+        parseOpts.progress->startPhase("Reading Map file", 0, true);
+    if (!MapFile::parseMapStream(mapStream, parseOpts, input.parsed.symbols, input.parsed.stats,
+        input.parsed.log))
+    {
+        MAPLOG(g_log, MapFile::LOGLVL_INFO, "LoadMap: Reading '%s' failed with error code 0x%08lX,"
+            " only symbols read before the error are applied.\n", fname, mapStream.errorCode());
+    }
+    g_metrics.add(MapFile::METRIC_FILE_BYTES, input.parsed.stats.bytes);
+    g_metrics.addParseStats(input.parsed.stats);
+    if (!input.parsed.log.empty())
+        g_log.write(MapFile::LOGLVL_VERBOSE, input.parsed.log.data(), input.parsed.log.size());
+    input.parsed.log.clear();
+    mapStream.close();
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Finishes parsing of a mapped MAP file; writes the log and index cache
+/// @param  input The MAP file, with parse result already stored
+/// @return void
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void finishMapInput(MAP_INPUT &input)
+{
+    if (!input.parsed.log.empty())
+        g_log.write(MapFile::LOGLVL_VERBOSE, input.parsed.log.data(), input.parsed.log.size());
+    input.parsed.log.clear();
+    const MapFile::MAPParseStats &parseStats = input.parsed.stats;
+    if (input.useCache && !parseStats.binary && (parseStats.sectionsFound > 0))
+    {
+        g_metrics.startPhase(MapFile::PHASE_CACHE);
+        std::string cacheFileName(input.fileName);
+        cacheFileName.append(MAP_CACHE_EXTENSION);
+        if (!MapFile::saveSymbolCache(cacheFileName.c_str(), input.cacheKey, input.parsed.symbols, parseStats))
+        {
+            MAPLOG(g_log, MapFile::LOGLVL_INFO, "LoadMap: Could not write index cache '%s'.\n",
+                cacheFileName.c_str());
+        }
+    }
+    MapFile::closeMAP(input.pMapStart, input.mapSize);
+    input.mapped = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks if an address may be joined with a reanalysis range
+/// The address must follow the range closely, within the same segment.
+/// @param  range The range
+/// @param  ea Address of the next changed item
+/// @return True if the range may be extended to the item
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool canJoinReanalysis(const REANALYSIS_RANGE &range, ea_t ea)
+{
+    if (ea < range.start)
+        return false;
+    if ((ea > range.end) && (ea - range.end > g_reanalysisGap))
+        return false;
+    return (getseg(ea) == getseg(range.start));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Remembers an item changed while auto-analysis is suspended
+/// Items come mostly in order of addresses, so they are joined with the last
+/// range on the way; requeueReanalysis() joins the rest.
+/// @param  ranges Ranges collected so far
+/// @param  ea Address of the changed item
+/// @return void
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void addReanalysisItem(std::vector<REANALYSIS_RANGE> &ranges, ea_t ea)
+{
+    ea_t end = get_item_end(ea);
+    if (end <= ea)
+        end = ea + 1;
+    g_metrics.add(MapFile::METRIC_REANALYSIS_ITEMS, 1);
+    if (!ranges.empty() && canJoinReanalysis(ranges.back(), ea))
+    {
+        if (end > ranges.back().end)
+            ranges.back().end = end;
+        return;
+    }
+    REANALYSIS_RANGE range;
+    range.start = ea;
+    range.end = end;
+    ranges.push_back(range);
+}
+
+static bool reanalysisRangeBefore(const REANALYSIS_RANGE &a, const REANALYSIS_RANGE &b)
+{
+    return (a.start < b.start);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Queues the changed items for auto-analysis, as few ranges as possible
+/// @param  ranges Ranges collected by addReanalysisItem(); cleared on return
+/// @return void
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void requeueReanalysis(std::vector<REANALYSIS_RANGE> &ranges)
+{
+    std::sort(ranges.begin(), ranges.end(), reanalysisRangeBefore);
+    size_t numJoined = 0;
+    for (size_t i = 0; i < ranges.size(); i++)
+    {
+        if ((numJoined > 0) && canJoinReanalysis(ranges[numJoined - 1], ranges[i].start))
+        {
+            if (ranges[i].end > ranges[numJoined - 1].end)
+                ranges[numJoined - 1].end = ranges[i].end;
+            continue;
+        }
+        ranges[numJoined++] = ranges[i];
+    }
+    for (size_t i = 0; i < numJoined; i++)
+    {
+        plan_range(ranges[i].start, ranges[i].end);
+#ifdef __EA64__
+        MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%08llX-%08llX - Queued for reanalysis\n",
+            ranges[i].start, ranges[i].end);
+#else
+        MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%08lX-%08lX - Queued for reanalysis\n",
+            ranges[i].start, ranges[i].end);
+#endif
+    }
+    g_metrics.add(MapFile::METRIC_REANALYSIS_RANGES, numJoined);
+    ranges.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds source file to an address range, for applyLineNumbers().
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void addSourceRange(ea_t start, ea_t end, const MapFile::MAPSymbolTable &symbols, unsigned int fileId)
+{
+    if ((fileId == MapFile::STRING_NONE) || (start >= end))
+        return;
+    const char *fileName = symbols.strings().str(fileId);
+    bool didOk = add_sourcefile(start, end, fileName);
+    if (didOk)
+        g_metrics.add(MapFile::METRIC_SOURCE_RANGES, 1);
+#ifdef __EA64__
+    MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%08llX-%08llX - Set source file '%s' %s\n",
+        start, end, fileName, didOk ? "succeeded" : "failed");
+#else
+    MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%08lX-%08lX - Set source file '%s' %s\n",
+        start, end, fileName, didOk ? "succeeded" : "failed");
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets source line numbers and source files from the line table
+/// Entries are applied in order of addresses; at an address listed more than
+/// once, the first entry is used. Consecutive entries of one source file are
+/// joined into a single range, which ends where the next file starts.
+/// @param  symbols The symbol table, with sorted line table
+/// @param  progress Progress of the import, polled for cancel
+/// @return void
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void applyLineNumbers(const MapFile::MAPSymbolTable &symbols, MapFile::MAPProgress &progress)
+{
+    const MapFile::MAPLineTable &lines = symbols.lines();
+    progress.startPhase("Applying line numbers", lines.size(), false);
+    MapFile::MAPLineReader reader(lines);
+    MapFile::MAPLineEntry entry;
+    ea_t lastEa = BADADDR;
+    ea_t rangeStart = BADADDR;
+    unsigned int rangeFile = MapFile::STRING_NONE;
+    size_t entryNo = 0;
+    size_t polledEntries = 0;
+    for (; reader.next(entry); entryNo++)
+    {
+        ea_t la = (ea_t)entry.ea;
+        if (la == lastEa)
+            continue;
+        if (entryNo - polledEntries >= g_applyPollLines)
+        {
+            progress.add(entryNo - polledEntries);
+            polledEntries = entryNo;
+            if (!progress.poll())
+            {
+                MAPLOG(g_log, MapFile::LOGLVL_INFO, "LoadMap: Cancelled after applying %lu of %lu line numbers.\n",
+                    (unsigned long)entryNo, (unsigned long)lines.size());
+                break;
+            }
+        }
+        if ((rangeStart == BADADDR) || (entry.fileId != rangeFile))
+        {
+            if (rangeStart != BADADDR)
+                addSourceRange(rangeStart, la, symbols, rangeFile);
+            rangeStart = la;
+            rangeFile = entry.fileId;
+        }
+        set_source_linnum(la, (uval_t)entry.line);
+        g_metrics.add(MapFile::METRIC_LINE_NUMBERS, 1);
+        lastEa = la;
+    }
+    if (rangeStart != BADADDR)
+        addSourceRange(rangeStart, lastEa + 1, symbols, rangeFile);
+    progress.add(entryNo - polledEntries);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads name or comment at given address, as recorded in journal
+/// Dummy names like "sub_401000" are not recorded, they come back by themselves.
+/// @param  la Address of the item
+/// @param  target Name or comment to read
+/// @param  value Receives the value
+/// @param  flags Receives JOURNAL_* flags of the value
+/// @return True if there is a value, false if there is none
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool getItemValue(ea_t la, MapFile::MAPJournalTarget target, qstring &value, unsigned char &flags)
+{
+    flags = 0;
+    value.clear();
+    if (target != MapFile::JOURNAL_NAME)
+        return (get_cmt(&value, la, (target == MapFile::JOURNAL_RPT_COMMENT)) > 0);
+    flags_t f = get_full_flags(la);
+    if (!has_name(f) || has_dummy_name(f))
+        return false;
+    if (has_auto_name(f))
+        flags |= MapFile::JOURNAL_OLD_AUTO;
+    return (get_name(&value, la) > 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets name or comment at given address
+/// @param  la Address of the item
+/// @param  target Name or comment to set
+/// @param  value The new value; NULL removes the current one
+/// @param  nameFlags Flags for set_name(), if a name is set
+/// @return True if the value was set
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool setItemValue(ea_t la, MapFile::MAPJournalTarget target, const char *value, int nameFlags)
+{
+    if (target == MapFile::JOURNAL_NAME)
+        return set_name(la, (value != NULL) ? value : "", nameFlags);
+    return set_cmt(la, (value != NULL) ? value : "", (target == MapFile::JOURNAL_RPT_COMMENT));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets name or comment, recording the change in journal
+/// The previous value is only read before the first change of an item.
+/// @param  journal Journal of the current import
+/// @param  la Address of the item
+/// @param  target Name or comment to set
+/// @param  value The new value; NULL removes the current one
+/// @param  nameFlags Flags for set_name(), if a name is set
+/// @return True if the value was set
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool setJournaledValue(MapFile::MAPJournal &journal, ea_t la, MapFile::MAPJournalTarget target,
+    const char *value, int nameFlags)
+{
+    qstring oldValue;
+    unsigned char oldFlags = 0;
+    bool hadOld = false;
+    if (!journal.isLast(la, target))
+        hadOld = getItemValue(la, target, oldValue, oldFlags);
+    if (!setItemValue(la, target, value, nameFlags))
+        return false;
+    journal.add(la, target, oldFlags, hadOld ? oldValue.c_str() : NULL, value);
+    return true;
+}
+
+/// @brief Results of making changes from a journal
+typedef struct _tagJOURNAL_REPLAY_STATS {
+    unsigned long changed;  //< names and comments set
+    unsigned long modified; //< items left alone, as their value is not the expected one
+    unsigned long failed;   //< values which could not be set
+    size_t processed;       //< entries processed before cancel
+} JOURNAL_REPLAY_STATS;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Makes changes from a journal, in a single pass in order of addresses
+/// When reverting, items which still have the value set by the import get
+/// their previous value back. When replaying, items which have the previous
+/// value get the new one; with "Replace existing" option, all items do.
+/// @param  journal The journal to take changes from
+/// @param  revert True to revert the changes, false to make them again
+/// @param  undo Receives journal of changes made now, to revert them later
+/// @param  progress Progress, polled for cancel
+/// @param  stats Receives amounts of changes made and skipped
+/// @return void
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void replayJournal(const MapFile::MAPJournal &journal, bool revert, MapFile::MAPJournal &undo,
+    MapFile::MAPProgress &progress, JOURNAL_REPLAY_STATS &stats)
+{
+    static const char * const targetNames[MapFile::JOURNAL_TARGET_COUNT] = {
+        "name", "comment", "repeatable comment" };
+    memset(&stats, 0, sizeof(stats));
+    std::vector<REANALYSIS_RANGE> reanalysis;
+    bool autoWasEnabled = is_auto_enabled();
+    if (g_options.bDeferAnalysis)
+        enable_auto(false);
+    size_t polled = 0;
+    size_t entryNo;
+    for (entryNo = 0; entryNo < journal.size(); entryNo++)
+    {
+        if (entryNo - polled >= g_applyPollSymbols)
+        {
+            progress.add(entryNo - polled);
+            polled = entryNo;
+            if (!progress.poll())
+                break;
+        }
+        const MapFile::MAPJournalEntry &entry = journal.entry(entryNo);
+        MapFile::MAPJournalTarget target = (MapFile::MAPJournalTarget)entry.target;
+        ea_t la = (ea_t)entry.ea;
+        const char *expected = journal.value(revert ? entry.newId : entry.oldId);
+        const char *value = journal.value(revert ? entry.oldId : entry.newId);
+        qstring curr;
+        unsigned char currFlags;
+        bool hasCurr = (getseg(la) != NULL) && getItemValue(la, target, curr, currFlags);
+        bool isExpected = (expected == NULL) ? !hasCurr : (hasCurr && (strcmp(curr.c_str(), expected) == 0));
+        if ((getseg(la) == NULL) || (!isExpected && (revert || !g_options.bReplace)))
+        {
+            stats.modified++;
+#ifdef __EA64__
+            MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%08llX - Skip %s '%s', current value differs\n",
+                la, targetNames[target], (value != NULL) ? value : "");
+#else
+            MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%08lX - Skip %s '%s', current value differs\n",
+                la, targetNames[target], (value != NULL) ? value : "");
+#endif
+            continue;
+        }
+        int nameFlags = SN_NOWARN;
+        if (value != NULL)
+            nameFlags |= SN_NOCHECK;
+        if (revert && ((entry.flags & MapFile::JOURNAL_OLD_AUTO) != 0))
+            nameFlags |= SN_AUTO;
+        bool didOk = setJournaledValue(undo, la, target, value, nameFlags);
+        if (didOk)
+            stats.changed++;
+        else
+            stats.failed++;
+        if (didOk && (target == MapFile::JOURNAL_NAME) && g_options.bDeferAnalysis)
+            addReanalysisItem(reanalysis, la);
+#ifdef __EA64__
+        MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%08llX - Change %s to '%s' %s\n",
+            la, targetNames[target], (value != NULL) ? value : "", didOk ? "succeeded" : "failed");
+#else
+        MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%08lX - Change %s to '%s' %s\n",
+            la, targetNames[target], (value != NULL) ? value : "", didOk ? "succeeded" : "failed");
+#endif
+    }
+    stats.processed = entryNo;
+    if (g_options.bDeferAnalysis)
+    {
+        requeueReanalysis(reanalysis);
+        enable_auto(autoWasEnabled);
+    }
+    undo.finish();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reverts the last import, or replays a journal file into this database
+/// Journal of the changes made replaces the stored one, so reverting again
+/// brings the changes back. Reverting also drops the record of applied
+/// symbols, so that the next import of the same files applies all symbols.
+/// @param  action ACTION_REVERT or ACTION_REPLAY_JOURNAL
+/// @return True if the changes were made
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool runJournalAction(PLUGIN_ACTION action)
+{
+    g_log.setSink(outputWindowSink);
+    g_log.setLevel(g_options.bVerbose ? MapFile::LOGLVL_VERBOSE : MapFile::LOGLVL_INFO);
+    MapFile::MAPJournal journal;
+    bool revert = (action == ACTION_REVERT);
+    if (revert || (action == ACTION_EXPORT_JOURNAL))
+    {
+        if (!loadImportJournal(journal))
+        {
+            warning("There is no journal of Map import in this database");
+            return false;
+        }
+    }
+    else
+    {
+        char *fname = ask_file(0, "*.lmjournal", "Open journal of Map import");
+        if (NULL == fname)
+        {
+            msg("LoadMap: User cancel\n");
+            return false;
+        }
+        if (!journal.loadFile(fname))
+        {
+            warning("File '%s' is not a valid journal of Map import", fname);
+            return false;
+        }
+    }
+    if (action == ACTION_EXPORT_JOURNAL)
+    {
+        char *fname = ask_file(1, "*.lmjournal", "Save journal of Map import");
+        if (NULL == fname)
+        {
+            msg("LoadMap: User cancel\n");
+            return false;
+        }
+        if (!journal.saveFile(fname))
+        {
+            warning("Could not write journal of Map import to '%s'", fname);
+            return false;
+        }
+        msg("LoadMap: Journal of %lu changes written to '%s'.\n", (unsigned long)journal.size(), fname);
+        return true;
+    }
+
+    show_wait_box(revert ? "Reverting last import of Map files" : "Replaying import of Map files");
+    MapFile::MAPProgress progress(idaShowProgress);
+    progress.startPhase(revert ? "Reverting names and comments" : "Replaying names and comments",
+        journal.size(), false);
+    MapFile::MAPJournal undo;
+    JOURNAL_REPLAY_STATS stats;
+    replayJournal(journal, revert, undo, progress, stats);
+    hide_wait_box();
+
+    if (revert && !journal.importKey().empty())
+    {
+        netnode node(journal.importKey().c_str(), 0, false);
+        if (node != BADNODE)
+            node.delblob(0, g_historyTag);
+    }
+    if (!saveImportJournal(undo))
+        MAPLOG(g_log, MapFile::LOGLVL_INFO, "LoadMap: Could not store journal of the changes.\n");
+    if (stats.processed < journal.size())
+    {
+        g_log.print(MapFile::LOGLVL_INFO, "LoadMap: Cancelled after %lu of %lu changes.\n",
+            (unsigned long)stats.processed, (unsigned long)journal.size());
+    }
+    g_log.print(MapFile::LOGLVL_INFO, "Result of %s Map import\n"
+        "   Names and comments changed: %lu\n"
+        "   Left alone, as they were changed meanwhile: %lu\n"
+        "   Could not be changed: %lu\n\n",
+        revert ? "reverting" : "replaying", stats.changed, stats.modified, stats.failed);
+    g_log.flush();
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes names of the database to a MAP file, in MSVC or GCC format
+/// Names list of IDA is ordered by addresses, so names of each segment are
+/// found by one lookup and then read in sequence; lines are formatted into
+/// a large buffer, which is written to the file in blocks.
+/// @return True if the file was written
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool runExportAction(void)
+{
+    g_log.setSink(outputWindowSink);
+    g_log.setLevel(g_options.bVerbose ? MapFile::LOGLVL_VERBOSE : MapFile::LOGLVL_INFO);
+    unsigned long numOfSegs = get_segm_qty();
+    if (0 == numOfSegs)
+    {
+        warning("Not found any segments");
+        return false;
+    }
+    int button = ask_buttons("~M~SVC", "~G~CC", "Cancel", ASKBTN_YES, "Format of the exported Map file");
+    if (ASKBTN_CANCEL == button)
+    {
+        msg("LoadMap: User cancel\n");
+        return false;
+    }
+    MapFile::MAPWriteFormat format = (ASKBTN_YES == button) ? MapFile::WRITE_MSVC : MapFile::WRITE_GCC;
+    char *fname = ask_file(1, "*.map", "Export names to Map file");
+    if (NULL == fname)
+    {
+        msg("LoadMap: User cancel\n");
+        return false;
+    }
+    FILE *fp = qfopen(fname, "wb");
+    if (NULL == fp)
+    {
+        warning("Could not create Map file '%s': %s", fname, qerrstr());
+        return false;
+    }
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    char moduleName[MAXPATH] = { 0 };
+    get_root_filename(moduleName, sizeof(moduleName));
+    MapFile::MAPWriter writer(format, fp);
+    writer.writeHeader(moduleName, (MapFile::MAPAddress)get_imagebase());
+    qstring segName;
+    for (unsigned long seg = 0; seg < numOfSegs; seg++)
+    {
+        segment_t * sseg = getnseg((int) seg);
+        if (NULL == sseg)
+            continue;
+        get_segm_name(&segName, sseg);
+        writer.writeSegment(seg, sseg->start_ea, sseg->size(), segName.c_str(), (SEG_CODE == sseg->type));
+    }
+    writer.beginSymbols();
+
+    show_wait_box("Exporting names to Map file");
+    size_t numNames = get_nlist_size();
+    MapFile::MAPProgress progress(idaShowProgress);
+    progress.startPhase("Exporting names", numNames, false);
+    size_t numVisited = 0;
+    size_t polledNames = 0;
+    bool cancelled = false;
+    for (unsigned long seg = 0; (seg < numOfSegs) && !cancelled; seg++)
+    {
+        segment_t * sseg = getnseg((int) seg);
+        if (NULL == sseg)
+            continue;
+        get_segm_name(&segName, sseg);
+        writer.beginSegment(seg, sseg->start_ea, sseg->size(), segName.c_str());
+        for (size_t idx = get_nlist_idx(sseg->start_ea); idx < numNames; idx++)
+        {
+            ea_t la = get_nlist_ea(idx);
+            if (la >= sseg->end_ea)
+                break;
+            if (la < sseg->start_ea)
+                continue;
+            const char *name = get_nlist_name(idx);
+            writer.writeSymbol(seg, (MapFile::MAPAddress)(la - sseg->start_ea), (MapFile::MAPAddress)la, name,
+                strlen(name), is_func(get_flags(la)));
+            if (++numVisited - polledNames >= g_exportPollNames)
+            {
+                progress.add(numVisited - polledNames);
+                polledNames = numVisited;
+                if (!progress.poll())
+                {
+                    cancelled = true;
+                    break;
+                }
+            }
+        }
+    }
+    bool written = writer.finish();
+    hide_wait_box();
+    qfclose(fp);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    if (!written)
+    {
+        warning("Could not write Map file '%s': %s", fname, strerror(writer.error()));
+        return false;
+    }
+    // Incomplete file would look like a valid Map file, so it is removed
+    if (cancelled)
+    {
+        qunlink(fname);
+        g_log.print(MapFile::LOGLVL_INFO, "LoadMap: Cancelled after exporting %lu of %lu names; Map file '%s' removed.\n",
+            (unsigned long)numVisited, (unsigned long)numNames, fname);
+        g_log.flush();
+        return false;
+    }
+    g_log.print(MapFile::LOGLVL_INFO, "LoadMap: Exported %llu names from %lu segments to %s Map file '%s' in %.2f s.\n",
+        writer.symbolCount(), numOfSegs, MapFile::writeFormatName(format), fname, seconds);
+    g_log.flush();
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Show options dialog for getting user desired options
+/// @param  action Action selected by plugin argument
+/// @return Action selected in the dialog
+/// @author TQN
+/// @date 2004.09.11
+////////////////////////////////////////////////////////////////////////////////
+static PLUGIN_ACTION showOptionsDlg(PLUGIN_ACTION action)
+{
+    // Build the format string constant used to create the dialog
+    const char format[] =
+        "STARTITEM 0\n"                             // TabStop
+        "LoadMap Options\n"                         // Title
+        "<Apply Map Symbols for Name:R>\n"          // Radio Button 0
+        "<Apply Map Symbols for Comment:R>>\n"    // Radio Button 1
+        "<Replace Existing Names/Comments:C>>\n"  // Checkbox Button
+        "<Show verbose messages:C>>\n"             // Checkbox Button
+        "<Copy messages to log file:C>>\n"         // Checkbox Button
+        "<Keep parsed symbols in index file:C>>\n"  // Checkbox Button
+        "<Only apply changes since previous import:C>>\n" // Checkbox Button
+        "<Read MAP file in blocks instead of mapping:C>>\n" // Checkbox Button
+        "<Ask for a list of MAP files:C>>\n"     // Checkbox Button
+        "<Append import metrics to JSON file:C>>\n" // Checkbox Button
+        "<Import source line numbers:C>>\n"       // Checkbox Button
+        "<Suspend auto-analysis while applying:C>>\n" // Checkbox Button
+        "<Import only symbols selected by a filter:C>>\n" // Checkbox Button
+        "<On address conflict keep symbols of first file:R>\n" // Radio Button 0
+        "<On address conflict keep symbols of last file:R>\n"  // Radio Button 1
+        "<On address conflict keep symbols of all files:R>>\n" // Radio Button 2
+        "<Do not demangle names:R>\n"                     // Radio Button 0
+        "<Put demangled names in comments:R>\n"           // Radio Button 1
+        "<Put demangled names in repeatable comments:R>>\n" // Radio Button 2
+        "<Import symbols from Map files:R>\n"              // Radio Button 0
+        "<Revert last import:R>\n"                         // Radio Button 1
+        "<Export journal of last import to a file:R>\n"    // Radio Button 2
+        "<Replay import from a journal file:R>\n"          // Radio Button 3
+        "<Export names to a Map file:R>>\n\n";             // Radio Button 4
+
+    // Create the option dialog.
+    short name = (g_options.bNameApply ? 0 : 1);
+    short replace = (g_options.bReplace ? 1 : 0);
+    short verbose = (g_options.bVerbose ? 1 : 0);
+    short logToFile = (g_options.bLogToFile ? 1 : 0);
+    short useCache = (g_options.bUseCache ? 1 : 0);
+    short incremental = (g_options.bIncremental ? 1 : 0);
+    short streamInput = (g_options.bStreamInput ? 1 : 0);
+    short multiFile = (g_options.bMultiFile ? 1 : 0);
+    short writeMetrics = (g_options.bWriteMetrics ? 1 : 0);
+    short lineNumbers = (g_options.bLineNumbers ? 1 : 0);
+    short deferAnalysis = (g_options.bDeferAnalysis ? 1 : 0);
+    short filterSymbols = (g_options.bFilterSymbols ? 1 : 0);
+    short mergePolicy = (short)g_options.mergePolicy;
+    short demangleNames = (short)g_options.demangleNames;
+    short selAction = (short)action;
+    if (ask_form(format, &name, &replace, &verbose, &logToFile, &useCache, &incremental, &streamInput,
+        &multiFile, &writeMetrics, &lineNumbers, &deferAnalysis, &filterSymbols, &mergePolicy, &demangleNames,
+        &selAction))
+    {
+        g_options.bNameApply = (0 == name);
+        g_options.bReplace = (1 == replace);
+        g_options.bVerbose = (1 == verbose);
+        g_options.bLogToFile = (1 == logToFile);
+        g_options.bUseCache = (1 == useCache);
+        g_options.bIncremental = (1 == incremental);
+        g_options.bStreamInput = (1 == streamInput);
+        g_options.bMultiFile = (1 == multiFile);
+        g_options.bWriteMetrics = (1 == writeMetrics);
+        g_options.bLineNumbers = (1 == lineNumbers);
+        g_options.bDeferAnalysis = (1 == deferAnalysis);
+        g_options.bFilterSymbols = (1 == filterSymbols);
+        g_options.mergePolicy = mergePolicy;
+        g_options.demangleNames = demangleNames;
+        action = (PLUGIN_ACTION)selAction;
+    }
+    return action;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Write-side equivalent of read_config_file() from IDA API
+/// @return True if saved
+/// @author TL
+/// @date 2023.11.22
+ ////////////////////////////////////////////////////////////////////////////////
+bool write_config_file(
+        const char *filename,
+        const cfgopt_t opts[],
+        size_t nopts)
+{
+    char szLine[120];
+    char szIniPath[MAXPATH] = { 0 };
+    int fh, i;
+
+    // Get the full path to user config dir
+    qstrncpy(szIniPath, get_user_idadir(), sizeof(szIniPath));
+    qstrncat(szIniPath, "/", sizeof(szIniPath));
+    qstrncat(szIniPath, filename, sizeof(szIniPath));
+    qstrncat(szIniPath, ".cfg", sizeof(szIniPath));
+    szIniPath[sizeof(szIniPath) - 1] = '\0';
+
+    fh = qcreate(szIniPath, 0644);
+    if (fh == -1)
+        return false;
+
+    qsnprintf(szLine, sizeof(szLine), "//\n// LoadMap Plugin auto-saved configuration file\n//\n");
+    qwrite(fh, szLine, qstrlen(szLine));
+
+    // Write config in normal IDA format (like the files in IDA/cfg folder).
+    // IDA Pro does not provide an API for that - only for reading.
+
+    for (i = 0; i < nopts; i++)
+    {
+        const cfgopt_t *opt = &opts[i];
+
+        qsnprintf(szLine, sizeof(szLine), "%s = %d\n", opt->name, *(int *)(opt->ptr));
+        qwrite(fh, szLine, qstrlen(szLine));
+    }
+    qclose(fh);
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Plugin initialize function
+/// @return PLUGIN_KEEP always
+/// @author TQN
+/// @date 2004.09.11
+ ////////////////////////////////////////////////////////////////////////////////
+static plugmod_t *idaapi init()
+{
+    msg("\nLoadMap: Plugin v%s init.\n\n", PLUG_VERSION);
+
+    // Get options saved in cfg file; IDA Pro will find the file, it does
+    // not need the full path nor extension, only base name.
+    if (!read_config_file("loadmap", g_optsinfo, qnumber(g_optsinfo), NULL))
+    {
+        msg("LoadMap: Plugin config file '%s.cfg' read failed: %s.\n", "loadmap", qerrstr());
+    }
+
+#if IDA_SDK_VERSION >= 800
+    switch (inf_get_filetype())
+#else
+    switch (inf.filetype)
+#endif
+    {
+    case f_ZIP:
+        return PLUGIN_SKIP;
+    }
+    return PLUGIN_KEEP;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Plugin run function, which does the actual job
+/// @param   arg    Action to do, PLUGIN_ACTION; 0 imports a MAP file
+/// @return void
+/// @author TQN
+/// @date 2004.09.11
+////////////////////////////////////////////////////////////////////////////////
+bool idaapi run(size_t arg)
+{
+    static char mapFileName[MAXPATH] = { 0 };
+    static qstring filterSpec;
+    PLUGIN_ACTION action = (arg < ACTION_COUNT) ? (PLUGIN_ACTION)arg : ACTION_IMPORT;
+
+    { // If user press shift key, show options dialog
+#if IDA_SDK_VERSION >= 800
+        input_event_t input_event;
+        if (get_user_input_event(&input_event) && (input_event.modifiers & VES_SHIFT))
+#elif defined(_WIN32)
+        // Windows-only method
+        if (GetAsyncKeyState(VK_SHIFT) & 0x8000)
+#else
+        if (false)
+#endif
+        {
+            action = showOptionsDlg(action);
+        }
+    }
+    if (action == ACTION_EXPORT_MAP)
+        return runExportAction();
+    if (action != ACTION_IMPORT)
+        return runJournalAction(action);
+
+    unsigned long numOfSegs = get_segm_qty();
+    if (0 == numOfSegs)
+    {
+        warning("Not found any segments");
+        return false;
+    }
+
+    if ('\0' == mapFileName[0])
+    {
+        // First run (after all, mapFileName is static)
+        get_input_file_path(mapFileName, sizeof(mapFileName));
+        pathExtensionSwitch(mapFileName, ".map", sizeof(mapFileName));
+    }
+
+    // Show open map file dialog; a list of files can be entered instead
+    qstring fileSpec;
+    if (g_options.bMultiFile)
+    {
+        fileSpec = mapFileName;
+        if (!ask_str(&fileSpec, HIST_FILE, "Enter MAP files separated by ';' (wildcards and folders are accepted)"))
+        {
+            msg("LoadMap: User cancel\n");
+            return false;
+        }
+    }
+    else
+    {
+        char *fname = ask_file(0, mapFileName, "Open MAP file");
+        if (NULL == fname)
+        {
+            msg("LoadMap: User cancel\n");
+            return false;
+        }
+        fileSpec = fname;
+    }
+    std::vector<std::string> fileNames;
+    expandMapFileList(fileSpec.c_str(), (g_options.bMultiFile != 0), fileNames);
+    if (fileNames.empty())
+    {
+        warning("No MAP files match '%s'", fileSpec.c_str());
+        return false;
+    }
+    // Symbols outside of the filter are rejected while parsing, mostly before their names are read
+    MapFile::MAPFilter filter;
+    if (g_options.bFilterSymbols)
+    {
+        if (!ask_str(&filterSpec, HIST_SRCH, "Enter symbols to import, as seg=1,2 addr=401000-402000 obj=*.obj name=?Draw*"))
+        {
+            msg("LoadMap: User cancel\n");
+            return false;
+        }
+        std::string filterError;
+        if (!filter.parse(filterSpec.c_str(), filterError))
+        {
+            warning("Invalid symbol filter: %s", filterError.c_str());
+            return false;
+        }
+    }
+    // Problems with a single file are shown in message boxes, like always;
+    // with more files, they are only logged, so that other files are loaded
+    bool singleFile = (fileNames.size() == 1);
+    const char * fname = fileNames[0].c_str();
+
+    unsigned long validSyms = 0;
+    unsigned long invalidSyms = 0;
+    unsigned long skippedSyms = 0;
+    unsigned long filteredSyms = 0;
+    unsigned long conflictSyms = 0;
+    unsigned long demangledSyms = 0;
+    unsigned long numLoaded = 0;
+    bool hasHistory = false;
+    bool parseCancelled = false;
+    unsigned long long parsedBytes = 0;
+    unsigned long long parseTotal = 0;
+    size_t appliedRefs = 0;
+    size_t totalRefs = 0;
+    MapFile::MAPProgress progress(idaShowProgress);
+    MapFile::MAPDeltaStats deltaStats;
+    memset(&deltaStats, 0, sizeof(deltaStats));
+
+    std::vector<MAP_INPUT> inputs(fileNames.size());
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        inputs[i].fileName = fileNames[i];
+        inputs[i].pMapStart = NULL;
+        inputs[i].mapSize = INVALID_MAPFILE_SIZE;
+        inputs[i].mapped = false;
+        inputs[i].loaded = false;
+        inputs[i].useCache = false;
+        inputs[i].numSymbols = 0;
+    }
+
+    // Messages are collected and shown in blocks; verbose ones only when enabled
+    g_log.setSink(outputWindowSink);
+    g_log.setLevel(g_options.bVerbose ? MapFile::LOGLVL_VERBOSE : MapFile::LOGLVL_INFO);
+    if (g_options.bLogToFile)
+    {
+        char logFileName[MAXPATH];
+        qstrncpy(logFileName, fname, sizeof(logFileName));
+        pathExtensionSwitch(logFileName, ".log", sizeof(logFileName));
+        if (!g_log.openMirror(logFileName))
+            msg("LoadMap: Could not create log file '%s'.\n", logFileName);
+    }
+
+    if (singleFile)
+        show_wait_box("Parsing and applying symbols from the Map file '%s'", fname);
+    else
+        show_wait_box("Parsing and applying symbols from %lu Map files", (unsigned long)inputs.size());
+
+    g_metrics.clear();
+    g_metrics.setThreads((unsigned int)g_options.parseThreads);
+    g_metrics.add(MapFile::METRIC_FILES, inputs.size());
+    std::vector<REANALYSIS_RANGE> reanalysis;
+    bool deferAnalysis = false;
+    bool autoWasEnabled = is_auto_enabled();
+    // Analysis is only waited for if nothing was queued before, so that its time is the one of our changes
+    bool analysisIdle = autoWasEnabled && auto_is_ok();
+    MapFile::MAPJournal journal;
+    try
+    {
+        // Take the segments list once, so that parsing needs no IDA API calls
+        MapFile::MAPSegmentMap segments;
+        for (unsigned long seg = 0; seg < numOfSegs; seg++)
+        {
+            segment_t * sseg = getnseg((int) seg);
+            segments.append(sseg->start_ea, sseg->end_ea);
+        }
+
+        MapFile::MAPParseOptions parseOpts;
+        parseOpts.minLineLen = g_minLineLen;
+        parseOpts.verbose = (g_options.bVerbose != 0);
+        parseOpts.numThreads = (unsigned int)g_options.parseThreads;
+        parseOpts.segments = &segments;
+        parseOpts.mapBase = NULL;
+        parseOpts.progress = &progress;
+        parseOpts.filter = filter.empty() ? NULL : &filter;
+        parseOpts.lineNumbers = (g_options.bLineNumbers != 0);
+
+        // Open all files first; symbol lines are independent, so chunks of all
+        // the mapped files are parsed in parallel, by one pool of threads
+        std::vector<MapFile::MAPBuffer> buffers;
+        std::vector<size_t> bufferInputs;
+        unsigned long long mappedBytes = 0;
+        for (size_t i = 0; (i < inputs.size()) && !progress.cancelled(); i++)
+        {
+            MAP_INPUT &input = inputs[i];
+            if (!openMapInput(input, segments, parseOpts) || !input.mapped)
+                continue;
+            MapFile::MAPBuffer buffer;
+            buffer.start = input.pMapStart;
+            buffer.end = input.pMapStart + input.mapSize;
+            buffer.mapBase = input.pMapStart;
+            buffers.push_back(buffer);
+            bufferInputs.push_back(i);
+            mappedBytes += input.mapSize;
+        }
+        std::vector<MapFile::MAPParseResult> results;
+        if (!progress.cancelled())
+        {
+            progress.startPhase("Parsing Map files", mappedBytes, true);
+            g_metrics.startPhase(MapFile::PHASE_PARSE);
+            MapFile::parseMapBuffers(buffers, parseOpts, results);
+        }
+        // Cancelled parsing leaves symbols of some chunks only, so nothing is applied
+        parseCancelled = progress.cancelled();
+        if (parseCancelled)
+        {
+            parsedBytes = progress.done();
+            parseTotal = progress.total();
+        }
+        for (size_t k = 0; (k < bufferInputs.size()) && !parseCancelled; k++)
+        {
+            MAP_INPUT &input = inputs[bufferInputs[k]];
+            input.parsed.symbols.swap(results[k].symbols);
+            input.parsed.stats = results[k].stats;
+            input.parsed.log.swap(results[k].log);
+            g_metrics.addParseStats(input.parsed.stats);
+            finishMapInput(input);
+        }
+
+        // Join symbols of the valid files, in order of the list
+        g_metrics.startPhase(MapFile::PHASE_PREPARE);
+        MapFile::MAPSymbolTable symbols;
+        std::vector<size_t> fileStarts;
+        for (size_t i = 0; (i < inputs.size()) && !parseCancelled; i++)
+        {
+            MAP_INPUT &input = inputs[i];
+            if (!input.problem.empty())
+                continue;
+            if (input.parsed.stats.binary)
+            {
+                setInputProblem(input, "File '%s' seem to be a binary or Unicode file", input.fileName.c_str());
+                continue;
+            }
+            if (input.parsed.stats.sectionsFound == 0)
+            {
+                setInputProblem(input, "File '%s' is not a valid Map file; publics section header wasn't found",
+                    input.fileName.c_str());
+                continue;
+            }
+            input.loaded = true;
+            input.numSymbols = (unsigned long)input.parsed.symbols.size();
+            invalidSyms += input.parsed.stats.invalidLines;
+            filteredSyms += input.parsed.stats.lineResults[MapFile::FILTERED_LINE];
+            fileStarts.push_back(symbols.size());
+            if (numLoaded == 0)
+                symbols.swap(input.parsed.symbols);
+            else
+                symbols.appendTable(input.parsed.symbols);
+            input.parsed.symbols.clear();
+            numLoaded++;
+        }
+
+        // Apply the symbols in order of addresses, so that the database
+        // is walked in a single pass
+        g_metrics.add(MapFile::METRIC_SYMBOLS, symbols.size());
+        progress.startPhase("Preparing symbols", 0, false);
+        std::vector<MapFile::MAPSymbolRef> sorted;
+        skippedSyms += MapFile::sortSymbolsByAddress(symbols, sorted);
+        if (numLoaded > 1)
+        {
+            conflictSyms = MapFile::resolveAddressConflicts(fileStarts,
+                (MapFile::MAPMergePolicy)g_options.mergePolicy, sorted);
+        }
+        // Line numbers of each file are sorted; joined files need a merge
+        if (g_options.bLineNumbers)
+            symbols.lines().sort();
+
+        // Demangled names go to comments; IDA demangler may only be called
+        // from the main thread, but each distinct name is demangled once
+        std::vector<unsigned int> demangledIds;
+        if (g_options.demangleNames != DEMANGLE_OFF)
+        {
+            g_metrics.startPhase(MapFile::PHASE_DEMANGLE);
+            MapFile::MAPDemangleStats demangleStats;
+            g_demangleCache.demangleSymbols(symbols, idaDemangle, 1, demangledIds, demangleStats);
+            MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "LoadMap: %lu mangled names; %lu demangled, %lu found in cache,"
+                " %lu could not be demangled.\n", demangleStats.mangled, demangleStats.demangled,
+                demangleStats.cached, demangleStats.failed);
+        }
+
+        // Compare with symbols applied by previous import of the same files,
+        // so that only changes are applied; full import starts a new record
+        g_metrics.startPhase(MapFile::PHASE_DELTA);
+        bool validMap = (numLoaded > 0);
+        // Filtered import would remove symbols outside of the filter, so it is always full
+        bool incremental = validMap && (g_options.bIncremental != 0) && (parseOpts.filter == NULL);
+        qstring historyNode;
+        historyNodeName(inputs, historyNode);
+        journal.setImportKey(historyNode.c_str());
+        MapFile::MAPSymbolTable prevApplied;
+        if (incremental)
+            hasHistory = loadImportHistory(historyNode.c_str(), prevApplied);
+        std::vector<MapFile::MAPDeltaEntry> delta;
+        std::vector<size_t> removedSyms;
+        MapFile::computeImportDelta(symbols, sorted, (g_options.bNameApply != 0), prevApplied,
+            delta, removedSyms, deltaStats);
+        std::vector<unsigned char> applyOk(sorted.size(), 0);
+
+        // Each new name may queue analysis, which IDA would interleave with the import;
+        // instead, changed items are analysed once, after all symbols are applied
+        if (validMap && g_options.bDeferAnalysis)
+        {
+            enable_auto(false);
+            deferAnalysis = true;
+        }
+
+        // Remove symbols which are gone from the MAP file, unless they were changed in the database
+        for (size_t k = 0; k < removedSyms.size(); k++)
+        {
+            size_t prevNo = removedSyms[k];
+            ea_t la = (ea_t)prevApplied.ea(prevNo);
+            bool bNameApply = (prevApplied.kind(prevNo) == MapFile::SYMKIND_NAME);
+            if (!isPrevImportValue(la, bNameApply, prevApplied, prevNo, 1))
+                continue;
+            bool didOk = setJournaledValue(journal, la,
+                bNameApply ? MapFile::JOURNAL_NAME : MapFile::JOURNAL_COMMENT, NULL, SN_NOWARN);
+            if (didOk)
+                g_metrics.add(MapFile::METRIC_REMOVED, 1);
+            if (didOk && bNameApply && deferAnalysis)
+                addReanalysisItem(reanalysis, la);
+#ifdef __EA64__
+            MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%08llX - Remove %s '%s' %s\n", la,
+                bNameApply ? "name" : "comment", prevApplied.name(prevNo), didOk ? "succeeded" : "failed");
+#else
+            MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%08lX - Remove %s '%s' %s\n", la,
+                bNameApply ? "name" : "comment", prevApplied.name(prevNo), didOk ? "succeeded" : "failed");
+#endif
+        }
+
+        ea_t la = BADADDR;
+        bool hasMeaningfulName = false;
+        bool hasCmt = false;
+        bool hasRptCmt = false;
+        size_t polledRefs = 0;
+        totalRefs = sorted.size();
+        appliedRefs = totalRefs;
+        progress.startPhase("Applying symbols", totalRefs, false);
+        g_metrics.startPhase(MapFile::PHASE_APPLY);
+        for (size_t refNo = 0; refNo < sorted.size(); refNo++)
+        {
+            // Cancel is only checked between addresses, so all symbols of an address are applied together
+            if ((refNo - polledRefs >= g_applyPollSymbols) && (sorted[refNo].ea != sorted[refNo - 1].ea))
+            {
+                progress.add(refNo - polledRefs);
+                polledRefs = refNo;
+                if (!progress.poll())
+                {
+                    appliedRefs = refNo;
+                    break;
+                }
+            }
+            size_t symNo = sorted[refNo].symNo;
+            unsigned long seg = symbols.seg(symNo);
+            const char *pname = symbols.name(symNo);
+            // Symbols already applied by previous import are left as they are
+            if (delta[refNo].kind == MapFile::DELTA_UNCHANGED)
+                continue;
+            // If shouldn't apply names
+            bool bNameApply = MapFile::isAppliedAsName(symbols.kind(symNo), (g_options.bNameApply != 0));
+
+            // Flags are read once per address, then updated with our own changes
+            if ((refNo == 0) || (la != (ea_t)sorted[refNo].ea))
+            {
+                la = (ea_t)sorted[refNo].ea;
+                flags_t f = get_full_flags(la);
+                hasMeaningfulName = has_name(f) && !has_dummy_name(f) && !has_auto_name(f);
+                hasCmt = has_cmt(f);
+                if (!demangledIds.empty())
+                {
+                    qstring rptCmt;
+                    hasRptCmt = (get_cmt(&rptCmt, la, true) > 0);
+                }
+            }
+
+            bool didOk;
+            if (bNameApply) // Apply symbols for name
+            {
+                //  Add name if there's no meaningful name assigned, or it came from previous import.
+                if (!g_options.bReplace && hasMeaningfulName &&
+                    !isPrevImportValue(la, true, prevApplied, delta[refNo].prevFirst, delta[refNo].prevCount))
+                {
+                    skippedSyms++;
+                    continue;
+                }
+                didOk = setJournaledValue(journal, la, MapFile::JOURNAL_NAME, pname, SN_NOCHECK | SN_NOWARN);
+                g_metrics.add(didOk ? MapFile::METRIC_NAMES_SET : MapFile::METRIC_NAMES_FAILED, 1);
+                if (didOk)
+                    hasMeaningfulName = true;
+                if (didOk && deferAnalysis)
+                    addReanalysisItem(reanalysis, la);
+#ifdef __EA64__
+                MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%04lX:%08llX - Change name to '%s' %s\n",
+                    seg, la, pname, didOk ? "succeeded" : "failed");
+#else
+                MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%04lX:%08lX - Change name to '%s' %s\n",
+                    seg, la, pname, didOk ? "succeeded" : "failed");
+#endif
+            }
+            else
+            {
+                if (!g_options.bReplace && hasCmt &&
+                    !isPrevImportValue(la, false, prevApplied, delta[refNo].prevFirst, delta[refNo].prevCount))
+                {
+                    skippedSyms++;
+                    continue;
+                }
+                // Apply symbols for comment
+                didOk = setJournaledValue(journal, la, MapFile::JOURNAL_COMMENT, pname, 0);
+                g_metrics.add(didOk ? MapFile::METRIC_COMMENTS_SET : MapFile::METRIC_COMMENTS_FAILED, 1);
+                if (didOk)
+                    hasCmt = true;
+#ifdef __EA64__
+                MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%04lX:%08llX - Change comment to '%s' %s\n",
+                    seg, la, pname, didOk ? "succeeded" : "failed");
+#else
+                MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%04lX:%08lX - Change comment to '%s' %s\n",
+                    seg, la, pname, didOk ? "succeeded" : "failed");
+#endif
+            }
+            applyOk[refNo] = didOk ? 1 : 0;
+            if (didOk)
+                validSyms++;
+            else
+                invalidSyms++;
+
+            // Demangled name is put next to the symbol; if the symbol is a comment,
+            // it takes the regular comment, so the repeatable one is used
+            if (!didOk || demangledIds.empty() || (demangledIds[symNo] == MapFile::DEMANGLE_NONE))
+                continue;
+            bool bRptCmt = (g_options.demangleNames == DEMANGLE_TO_REPEATABLE) || !bNameApply;
+            if (!g_options.bReplace && (bRptCmt ? hasRptCmt : hasCmt))
+                continue;
+            const char *pdemangled = g_demangleCache.text(demangledIds[symNo]);
+            didOk = setJournaledValue(journal, la,
+                bRptCmt ? MapFile::JOURNAL_RPT_COMMENT : MapFile::JOURNAL_COMMENT, pdemangled, 0);
+            g_metrics.add(didOk ? MapFile::METRIC_COMMENTS_SET : MapFile::METRIC_COMMENTS_FAILED, 1);
+            if (didOk)
+            {
+                demangledSyms++;
+                if (bRptCmt)
+                    hasRptCmt = true;
+                else
+                    hasCmt = true;
+            }
+#ifdef __EA64__
+            MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%04lX:%08llX - Change %scomment to '%s' %s\n",
+                seg, la, bRptCmt ? "repeatable " : "", pdemangled, didOk ? "succeeded" : "failed");
+#else
+            MAPLOG(g_log, MapFile::LOGLVL_VERBOSE, "%04lX:%08lX - Change %scomment to '%s' %s\n",
+                seg, la, bRptCmt ? "repeatable " : "", pdemangled, didOk ? "succeeded" : "failed");
+#endif
+        }
+
+        if ((appliedRefs == totalRefs) && !symbols.lines().empty())
+        {
+            g_metrics.startPhase(MapFile::PHASE_LINES);
+            applyLineNumbers(symbols, progress);
+        }
+
+        // Symbols which were not reached keep their record of previous import,
+        // as they are still in the database
+        for (size_t refNo = appliedRefs; refNo < sorted.size(); refNo++)
+        {
+            if (delta[refNo].prevCount > 0)
+                delta[refNo].kind = MapFile::DELTA_UNCHANGED;
+        }
+
+        // Record is only kept for incremental imports, as nothing else reads it
+        if (validMap && (g_options.bIncremental != 0))
+        {
+            g_metrics.startPhase(MapFile::PHASE_HISTORY);
+            MapFile::MAPSymbolTable applied;
+            MapFile::collectAppliedSymbols(symbols, sorted, (g_options.bNameApply != 0), prevApplied,
+                delta, applyOk, applied);
+            if (!saveImportHistory(historyNode.c_str(), applied))
+                MAPLOG(g_log, MapFile::LOGLVL_INFO, "LoadMap: Could not store record of applied symbols.\n");
+        }
+    }
+    catch (...)
+    {
+        warning("Exception while parsing MAP file '%s'", fileSpec.c_str());
+        invalidSyms++;
+    }
+    if (deferAnalysis)
+    {
+        g_metrics.startPhase(MapFile::PHASE_APPLY);
+        requeueReanalysis(reanalysis);
+        enable_auto(autoWasEnabled);
+    }
+    // Journal of the changes replaces the one of previous import only if something changed,
+    // so that the previous import can still be reverted
+    if ((numLoaded > 0) && !journal.empty())
+    {
+        g_metrics.startPhase(MapFile::PHASE_HISTORY);
+        journal.finish();
+        if (!saveImportJournal(journal))
+            MAPLOG(g_log, MapFile::LOGLVL_INFO, "LoadMap: Could not store journal of the changes.\n");
+    }
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        if (inputs[i].mapped)
+            MapFile::closeMAP(inputs[i].pMapStart, inputs[i].mapSize);
+    }
+    unsigned long long appliedItems = appliedItemCount();
+    if (analysisIdle && (appliedItems > 0))
+    {
+        g_metrics.startPhase(MapFile::PHASE_ANALYSIS);
+        replace_wait_box("Waiting for auto-analysis of the changes");
+        auto_wait();
+    }
+    g_metrics.stopPhase();
+
+    // Applying and analysis of the changes are measured together, and compared
+    // with the last import with analysis running, to show what suspending it saves
+    if (analysisIdle && (appliedItems > 0))
+    {
+        double applyCost = (g_metrics.phaseSeconds(MapFile::PHASE_APPLY) +
+            g_metrics.phaseSeconds(MapFile::PHASE_ANALYSIS)) / appliedItems;
+        if (!deferAnalysis)
+            g_analysisApplyCost = applyCost;
+        else if (g_analysisApplyCost >= 0.0)
+            g_metrics.setAnalysisSaving((g_analysisApplyCost - applyCost) * appliedItems);
+    }
+    hide_wait_box();
+
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        if (inputs[i].problem.empty())
+            continue;
+        if (singleFile)
+            warning("%s", inputs[i].problem.c_str());
+        else
+            g_log.print(MapFile::LOGLVL_INFO, "LoadMap: %s\n", inputs[i].problem.c_str());
+    }
+    if (parseCancelled)
+    {
+        if (parseTotal > 0)
+        {
+            g_log.print(MapFile::LOGLVL_INFO, "LoadMap: Cancelled after parsing %.1f of %.1f MB, no symbols were applied.\n",
+                parsedBytes / (1024.0 * 1024.0), parseTotal / (1024.0 * 1024.0));
+        }
+        else
+        {
+            g_log.print(MapFile::LOGLVL_INFO, "LoadMap: Cancelled after reading %.1f MB, no symbols were applied.\n",
+                parsedBytes / (1024.0 * 1024.0));
+        }
+    }
+    else if (appliedRefs < totalRefs)
+    {
+        g_log.print(MapFile::LOGLVL_INFO, "LoadMap: Cancelled after applying %lu of %lu symbols,"
+            " remaining ones were not touched.\n", (unsigned long)appliedRefs, (unsigned long)totalRefs);
+    }
+    if (numLoaded > 0)
+    {
+        // Save file name for next askfile_c dialog
+        qstrncpy(mapFileName, fileSpec.c_str(), sizeof(mapFileName));
+
+        // Show the result
+        if (singleFile)
+        {
+            g_log.print(MapFile::LOGLVL_INFO, "Result of loading and parsing the Map file '%s'\n", fname);
+        }
+        else
+        {
+            g_log.print(MapFile::LOGLVL_INFO, "Result of loading and parsing %lu Map files\n",
+                (unsigned long)inputs.size());
+            for (size_t i = 0; i < inputs.size(); i++)
+            {
+                if (inputs[i].loaded)
+                {
+                    g_log.print(MapFile::LOGLVL_INFO, "   %s: %lu symbols, %lu invalid lines\n",
+                        inputs[i].fileName.c_str(), inputs[i].numSymbols, inputs[i].parsed.stats.invalidLines);
+                }
+                else
+                {
+                    g_log.print(MapFile::LOGLVL_INFO, "   %s: not loaded\n", inputs[i].fileName.c_str());
+                }
+            }
+            g_log.print(MapFile::LOGLVL_INFO, "   Number of Symbols dropped on address conflicts: %lu\n",
+                conflictSyms);
+        }
+        g_log.print(MapFile::LOGLVL_INFO,
+            "   Number of Symbols applied: %lu\n"
+            "   Number of Symbols skipped: %lu\n"
+            "   Number of Invalid Symbols: %lu\n",
+            validSyms, skippedSyms, invalidSyms);
+        if (!filter.empty())
+            g_log.print(MapFile::LOGLVL_INFO, "   Number of Symbols outside of filter: %lu\n", filteredSyms);
+        if (g_options.demangleNames != DEMANGLE_OFF)
+            g_log.print(MapFile::LOGLVL_INFO, "   Number of Names demangled: %lu\n", demangledSyms);
+        g_log.print(MapFile::LOGLVL_INFO, "\n");
+        if (hasHistory)
+        {
+            g_log.print(MapFile::LOGLVL_INFO, "Changes since previous import of a Map file\n"
+                "   Symbols added: %lu, removed: %lu, renamed: %lu, moved: %lu, unchanged: %lu\n\n",
+                deltaStats.added, deltaStats.removed, deltaStats.renamed, deltaStats.moved,
+                deltaStats.unchanged);
+        }
+        g_metrics.print(g_log);
+        g_log.print(MapFile::LOGLVL_INFO, "\n");
+        if (g_options.bWriteMetrics)
+        {
+            char metricsPath[MAXPATH];
+            qstrncpy(metricsPath, get_user_idadir(), sizeof(metricsPath));
+            qstrncat(metricsPath, "/", sizeof(metricsPath));
+            qstrncat(metricsPath, g_szMetricsFileName, sizeof(metricsPath));
+            if (!g_metrics.appendJson(metricsPath, PLUG_VERSION))
+                MAPLOG(g_log, MapFile::LOGLVL_INFO, "LoadMap: Could not write metrics to '%s'.\n", metricsPath);
+        }
+    }
+    g_log.closeMirror();
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Plugin terminate callback function
+/// @return void
+/// @author TQN
+/// @date 2004.09.11
+////////////////////////////////////////////////////////////////////////////////
+void idaapi term(void)
+{
+    msg("LoadMap: Plugin v%s terminate.\n", PLUG_VERSION);
+    g_demangleCache.clear();
+
+    // Write the plugin's options to cfg file
+    if (!write_config_file("loadmap", g_optsinfo, qnumber(g_optsinfo)))
+    {
+        msg("LoadMap: Plugin config file '%s.cfg' save failed: %s.\n", "loadmap", qerrstr());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Plugin information
+/// @{
+char wanted_name[]   = "Load Symbols From MAP File";
+char wanted_hotkey[] = "Ctrl-M";
+char comment[]       = "LoadMap loads symbols from a VC/BC/Watcom/Dede map file.";
+char help[]          = "LoadMap " PLUG_VERSION ", Visual C/Borland C/Watcom C/Dede map file import plugin."
+                              "This module reads selected map file, and loads symbols\n"
+                              "into IDA database. Click it while holding Shift to see options.";
+/// @}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Plugin description block
+extern "C" {
+plugin_t PLUGIN =
+{
+    IDP_INTERFACE_VERSION,
+    0,                    // Plugin flags
+    init,                 // Initialize
+    term,                 // Terminate
+    run,                  // Main function
+    comment,              // Comment about the plugin
+    help,
+    wanted_name,          // preferred short name of the plugin
+    wanted_hotkey         // preferred hotkey to run the plugin
+};
+};
+////////////////////////////////////////////////////////////////////////////////
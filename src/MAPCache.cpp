@@ -0,0 +1,440 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPCache.cpp
+///     Binary index cache of parsed MAP files.
+/// @par Purpose:
+///     Stores parsed symbols next to the MAP file, so that loading the same
+///     file again does not require parsing the text. The cache file layout
+///     allows using it directly from memory mapping.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPCache.h"
+#include  "MAPHash.h"
+
+#include  <cstring>
+#include  <cstddef>
+#include  <string>
+#include  <vector>
+#include  <sys/types.h>
+#include  <sys/stat.h>
+
+#include "stdafx.h"
+
+using namespace std;
+
+namespace MapFile {
+
+/// Version of the cache file layout; increase on any change of the layout or parser output
+const unsigned int CACHE_VERSION = 4;
+/// Value which allows to detect cache written on machine of different byte order
+const unsigned int CACHE_BYTE_ORDER = 0x01020304;
+/// Alignment of each array within the cache file
+const size_t CACHE_ALIGN = 8;
+/// Size of the pieces in which the cache data is hashed
+const size_t CACHE_HASH_BLOCK = 64 * 1024;
+/// Amount of MAP file content hashed at its start and at its end, to identify the file
+const size_t CACHE_KEY_SAMPLE = 64 * 1024;
+
+const char CACHE_MAGIC[8] = { 'L', 'M', 'I', 'D', 'X', '\r', '\n', '\x1a' };
+
+/// Header at start of the cache file; arrays of symbol fields and encoded source lines follow.
+typedef struct {
+    char magic[8];
+    unsigned int version;
+    unsigned int byteOrder;
+    MAPCacheKey key;
+    unsigned long long numSymbols;
+    unsigned long long numStrings;
+    unsigned long long stringsSize;
+    unsigned long long sectionsFound;
+    unsigned long long invalidLines;
+    unsigned long long numLineEntries;
+    unsigned long long lineDataSize;
+    unsigned long long offSegs;         ///< unsigned int per symbol
+    unsigned long long offAddrs;        ///< unsigned long long per symbol
+    unsigned long long offEas;          ///< unsigned long long per symbol
+    unsigned long long offKinds;        ///< unsigned char per symbol
+    unsigned long long offNameIds;      ///< unsigned int per symbol
+    unsigned long long offObjIds;       ///< unsigned int per symbol
+    unsigned long long offStrOffs;      ///< unsigned long long per string
+    unsigned long long offStrLens;      ///< unsigned int per string
+    unsigned long long offStrings;      ///< distinct strings, NUL-terminated
+    unsigned long long offLineData;     ///< source lines, as encoded by MAPLineTable
+    unsigned long long fileLen;
+    unsigned long long dataHash;        ///< Hash of everything after the header
+    unsigned long long headerHash;      ///< Hash of the header before this field
+} MAPCacheHeader;
+
+static_assert(sizeof(unsigned long long) == 8, "Cache layout requires 64-bit long long");
+static_assert(sizeof(unsigned int) == 4, "Cache layout requires 32-bit int");
+static_assert((sizeof(MAPCacheHeader) % CACHE_ALIGN) == 0, "Cache header must keep arrays aligned");
+
+};
+
+/// Reads size and modification time of a file.
+static bool getFileStamp(const char * fileName, unsigned long long &fileSize, long long &fileTime)
+{
+#if defined(_WIN32)
+    struct _stat64 st;
+    if (_stat64(fileName, &st) != 0)
+        return false;
+#else
+    struct stat st;
+    if (stat(fileName, &st) != 0)
+        return false;
+#endif
+    fileSize = (unsigned long long)st.st_size;
+    fileTime = (long long)st.st_mtime;
+    return true;
+}
+
+static size_t alignCacheOffset(size_t offs)
+{
+    return (offs + MapFile::CACHE_ALIGN - 1) & ~(MapFile::CACHE_ALIGN - 1);
+}
+
+/// Checks if an array of given size fits within the cache file at aligned offset.
+static bool isCacheArrayValid(const MapFile::MAPCacheHeader &hdr, unsigned long long offs, unsigned long long numElems,
+    unsigned long long elemSize)
+{
+    if ((offs % MapFile::CACHE_ALIGN) != 0 || (offs < sizeof(MapFile::MAPCacheHeader)) || (offs > hdr.fileLen))
+        return false;
+    return (numElems <= (hdr.fileLen - offs) / elemSize);
+}
+
+/// Chains hash of a buffer, in the fixed-size pieces used by the cache writer.
+static unsigned long long hashCacheData(const char * data, size_t len)
+{
+    unsigned long long h = 0;
+    for (size_t offs = 0; offs < len; offs += MapFile::CACHE_HASH_BLOCK)
+    {
+        size_t n = (len - offs < MapFile::CACHE_HASH_BLOCK) ? (len - offs) : MapFile::CACHE_HASH_BLOCK;
+        h = MapFile::hashBuffer(data + offs, n, h);
+    }
+    return h;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Prepares key identifying MAP file and conditions of parsing it.
+/// The file is identified by its size, modification time, and hash of its
+/// start and end; hashing the whole file would read every page of it once
+/// more before the parse.
+/// @param mapFileName Name of the MAP file
+/// @param mapData Content of the MAP file
+/// @param mapSize Size of the MAP file content
+/// @param segments Segments of the target executable
+/// @param opts Parsing options
+/// @param key Target cache key
+/// @return True if the key was created
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::makeCacheKey(const char * mapFileName, const char * mapData, size_t mapSize,
+    const MapFile::MAPSegmentMap &segments, const MapFile::MAPParseOptions &opts, MapFile::MAPCacheKey &key)
+{
+    memset(&key, 0, sizeof(key));
+    if (!getFileStamp(mapFileName, key.fileSize, key.fileTime))
+        return false;
+    if (key.fileSize != (unsigned long long)mapSize)
+        return false;
+    if (mapSize <= 2 * MapFile::CACHE_KEY_SAMPLE)
+    {
+        key.contentHash = hashBuffer(mapData, mapSize, 0);
+    }
+    else
+    {
+        key.contentHash = hashBuffer(mapData, MapFile::CACHE_KEY_SAMPLE, 0);
+        key.contentHash = hashBuffer(mapData + mapSize - MapFile::CACHE_KEY_SAMPLE, MapFile::CACHE_KEY_SAMPLE,
+            key.contentHash);
+    }
+    unsigned long long h = hashBuffer(NULL, 0, segments.size());
+    for (unsigned long seg = 0; seg < segments.size(); seg++)
+    {
+        unsigned long long range[2] = { segments.segStart(seg), segments.segEnd(seg) };
+        h = hashBuffer(range, sizeof(range), h);
+    }
+    key.segmentsHash = h;
+    unsigned long long options[3] = { opts.minLineLen, sizeof(MapFile::MAPAddress), opts.lineNumbers ? 1ULL : 0ULL };
+    key.optionsHash = hashBuffer(options, sizeof(options), CACHE_VERSION);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Loads symbols from cache file, if it matches given key.
+/// @param cacheFileName Name of the cache file
+/// @param key Key of the MAP file and parsing conditions
+/// @param segments Segments of the target executable, to verify the symbols
+/// @param symbols Target symbol table; cleared if the cache cannot be used
+/// @param stats Target parsing summary
+/// @return CACHE_HIT if symbols were loaded, or reason of failure
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+MapFile::MAPCacheResult MapFile::loadSymbolCache(const char * cacheFileName, const MapFile::MAPCacheKey &key,
+    const MapFile::MAPSegmentMap &segments, MapFile::MAPSymbolTable &symbols, MapFile::MAPParseStats &stats)
+{
+    symbols.clear();
+    char * pCache = NULL;
+    size_t cacheSize = INVALID_MAPFILE_SIZE;
+    MapFile::MAPResult eRet = MapFile::openMAP(cacheFileName, pCache, cacheSize);
+    if (eRet == MapFile::OS_ERROR)
+        return MapFile::CACHE_MISSING;
+    if (eRet != MapFile::OPEN_NO_ERROR)
+        return MapFile::CACHE_CORRUPT;
+
+    MapFile::MAPCacheResult result = MapFile::CACHE_CORRUPT;
+    do {
+        if (cacheSize < sizeof(MapFile::MAPCacheHeader))
+            break;
+        const MapFile::MAPCacheHeader &hdr = *(const MapFile::MAPCacheHeader *)pCache;
+        if (memcmp(hdr.magic, CACHE_MAGIC, sizeof(hdr.magic)) != 0)
+            break;
+        if ((hdr.version != CACHE_VERSION) || (hdr.byteOrder != CACHE_BYTE_ORDER))
+        {
+            result = MapFile::CACHE_STALE;
+            break;
+        }
+        if (hdr.headerHash != hashBuffer(&hdr, offsetof(MapFile::MAPCacheHeader, headerHash), 0))
+            break;
+        if (memcmp(&hdr.key, &key, sizeof(key)) != 0)
+        {
+            result = MapFile::CACHE_STALE;
+            break;
+        }
+        if ((hdr.fileLen != cacheSize) || (hdr.numStrings >= MapFile::STRING_NONE) ||
+            !isCacheArrayValid(hdr, hdr.offSegs, hdr.numSymbols, sizeof(unsigned int)) ||
+            !isCacheArrayValid(hdr, hdr.offAddrs, hdr.numSymbols, sizeof(unsigned long long)) ||
+            !isCacheArrayValid(hdr, hdr.offEas, hdr.numSymbols, sizeof(unsigned long long)) ||
+            !isCacheArrayValid(hdr, hdr.offKinds, hdr.numSymbols, sizeof(unsigned char)) ||
+            !isCacheArrayValid(hdr, hdr.offNameIds, hdr.numSymbols, sizeof(unsigned int)) ||
+            !isCacheArrayValid(hdr, hdr.offObjIds, hdr.numSymbols, sizeof(unsigned int)) ||
+            !isCacheArrayValid(hdr, hdr.offStrOffs, hdr.numStrings, sizeof(unsigned long long)) ||
+            !isCacheArrayValid(hdr, hdr.offStrLens, hdr.numStrings, sizeof(unsigned int)) ||
+            (hdr.offStrings > hdr.fileLen) || (hdr.stringsSize > hdr.fileLen - hdr.offStrings) ||
+            !isCacheArrayValid(hdr, hdr.offLineData, hdr.lineDataSize, sizeof(unsigned char)) ||
+            (hdr.numLineEntries > hdr.lineDataSize))
+            break;
+        if (hdr.dataHash != hashCacheData(pCache + sizeof(hdr), cacheSize - sizeof(hdr)))
+            break;
+
+        // Verify every symbol and string, so that the table is safe to use
+        size_t numSymbols = (size_t)hdr.numSymbols;
+        size_t numStrings = (size_t)hdr.numStrings;
+        const unsigned int * segData = (const unsigned int *)(pCache + hdr.offSegs);
+        const unsigned long long * addrData = (const unsigned long long *)(pCache + hdr.offAddrs);
+        const unsigned long long * eaData = (const unsigned long long *)(pCache + hdr.offEas);
+        const unsigned char * kindData = (const unsigned char *)(pCache + hdr.offKinds);
+        const unsigned int * nameIdData = (const unsigned int *)(pCache + hdr.offNameIds);
+        const unsigned int * objIdData = (const unsigned int *)(pCache + hdr.offObjIds);
+        const unsigned long long * strOffData = (const unsigned long long *)(pCache + hdr.offStrOffs);
+        const unsigned int * strLenData = (const unsigned int *)(pCache + hdr.offStrLens);
+        const char * strData = pCache + hdr.offStrings;
+        bool valid = true;
+        for (size_t i = 0; (i < numStrings) && valid; i++)
+        {
+            valid = (strOffData[i] < hdr.stringsSize) && (strLenData[i] < hdr.stringsSize - strOffData[i]) &&
+                (strData[strOffData[i] + strLenData[i]] == '\0');
+        }
+        for (size_t i = 0; (i < numSymbols) && valid; i++)
+        {
+            valid = (segData[i] < segments.size()) && (kindData[i] <= MapFile::SYMKIND_COMMENT) &&
+                (nameIdData[i] < numStrings) && ((objIdData[i] < numStrings) || (objIdData[i] == MapFile::STRING_NONE));
+        }
+        if (!valid)
+            break;
+
+        MapFile::MAPStringPool pool;
+        pool.assign(numStrings, strOffData, strLenData, strData, (size_t)hdr.stringsSize);
+        symbols.assign(numSymbols, segData, addrData, eaData, kindData, nameIdData, objIdData, pool);
+        if (!symbols.lines().assign((size_t)hdr.numLineEntries, (const unsigned char *)(pCache + hdr.offLineData),
+            (size_t)hdr.lineDataSize, numStrings))
+        {
+            symbols.clear();
+            break;
+        }
+        MapFile::clearParseStats(stats);
+        stats.sectionsFound = (unsigned long)hdr.sectionsFound;
+        stats.invalidLines = (unsigned long)hdr.invalidLines;
+        result = MapFile::CACHE_HIT;
+    } while (0);
+
+    MapFile::closeMAP(pCache, cacheSize);
+    return result;
+}
+
+/// Buffered writer of cache file data; hashes the data as hashCacheData() does.
+typedef struct {
+    FILE * fp;
+    std::vector<char> buf;
+    size_t offs;        ///< Offset within the file of the first byte in buffer
+    unsigned long long hash;
+    bool ok;
+} MAPCacheWriter;
+
+static void flushCacheWriter(MAPCacheWriter &wr)
+{
+    if (wr.buf.empty())
+        return;
+    wr.ok = wr.ok && (fwrite(&wr.buf[0], 1, wr.buf.size(), wr.fp) == wr.buf.size());
+    wr.hash = MapFile::hashBuffer(&wr.buf[0], wr.buf.size(), wr.hash);
+    wr.offs += wr.buf.size();
+    wr.buf.clear();
+}
+
+static void putCacheData(MAPCacheWriter &wr, const void * data, size_t len)
+{
+    const char * p = (const char *)data;
+    while (len > 0)
+    {
+        size_t n = MapFile::CACHE_HASH_BLOCK - wr.buf.size();
+        if (n > len)
+            n = len;
+        wr.buf.insert(wr.buf.end(), p, p + n);
+        p += n;
+        len -= n;
+        if (wr.buf.size() == MapFile::CACHE_HASH_BLOCK)
+            flushCacheWriter(wr);
+    }
+}
+
+/// Pads the cache data to keep next array aligned.
+static void padCacheData(MAPCacheWriter &wr)
+{
+    static const char padding[MapFile::CACHE_ALIGN] = { 0 };
+    size_t endOffs = wr.offs + wr.buf.size();
+    putCacheData(wr, padding, alignCacheOffset(endOffs) - endOffs);
+}
+
+/// Writes one array of the cache file, converting elements to the stored type.
+template <typename StoredType, typename Getter>
+static unsigned long long writeCacheArray(MAPCacheWriter &wr, size_t numElems, Getter get)
+{
+    unsigned long long arrayOffs = wr.offs + wr.buf.size();
+    for (size_t i = 0; i < numElems; i++)
+    {
+        StoredType val = (StoredType)get(i);
+        putCacheData(wr, &val, sizeof(val));
+    }
+    padCacheData(wr);
+    return arrayOffs;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Stores symbols into cache file.
+/// The file is written under temporary name and renamed when complete,
+/// so that an interrupted write does not leave a damaged cache.
+/// @param cacheFileName Name of the cache file
+/// @param key Key of the MAP file and parsing conditions
+/// @param symbols The symbol table to store
+/// @param stats Parsing summary to store
+/// @return True if the cache was written
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::saveSymbolCache(const char * cacheFileName, const MapFile::MAPCacheKey &key,
+    const MapFile::MAPSymbolTable &symbols, const MapFile::MAPParseStats &stats)
+{
+    // Only merged source lines can be stored; parser always leaves them so
+    if (!symbols.lines().isSorted())
+        return false;
+    std::string tempFileName(cacheFileName);
+    tempFileName.append(".tmp");
+    FILE * fp = fopen(tempFileName.c_str(), "wb");
+    if (fp == NULL)
+        return false;
+
+    MapFile::MAPCacheHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    size_t numSymbols = symbols.size();
+    bool ok = (fwrite(&hdr, sizeof(hdr), 1, fp) == 1);
+    MAPCacheWriter wr;
+    wr.fp = fp;
+    wr.buf.reserve(CACHE_HASH_BLOCK);
+    wr.offs = sizeof(hdr);
+    wr.hash = 0;
+    wr.ok = ok;
+    hdr.offSegs = writeCacheArray<unsigned int>(wr, numSymbols,
+        [&](size_t i) { return symbols.seg(i); });
+    hdr.offAddrs = writeCacheArray<unsigned long long>(wr, numSymbols,
+        [&](size_t i) { return symbols.addr(i); });
+    hdr.offEas = writeCacheArray<unsigned long long>(wr, numSymbols,
+        [&](size_t i) { return symbols.ea(i); });
+    hdr.offKinds = writeCacheArray<unsigned char>(wr, numSymbols,
+        [&](size_t i) { return symbols.kind(i); });
+    hdr.offNameIds = writeCacheArray<unsigned int>(wr, numSymbols,
+        [&](size_t i) { return symbols.nameId(i); });
+    hdr.offObjIds = writeCacheArray<unsigned int>(wr, numSymbols,
+        [&](size_t i) { return symbols.objectId(i); });
+    const MapFile::MAPStringPool &strings = symbols.strings();
+    hdr.offStrOffs = writeCacheArray<unsigned long long>(wr, strings.size(),
+        [&](size_t i) { return strings.offset((unsigned int)i); });
+    hdr.offStrLens = writeCacheArray<unsigned int>(wr, strings.size(),
+        [&](size_t i) { return strings.len((unsigned int)i); });
+    hdr.offStrings = wr.offs + wr.buf.size();
+    if (strings.dataSize() > 0)
+        putCacheData(wr, strings.data(), strings.dataSize());
+    const MapFile::MAPLineTable &lines = symbols.lines();
+    padCacheData(wr);
+    hdr.offLineData = wr.offs + wr.buf.size();
+    if (lines.dataSize() > 0)
+        putCacheData(wr, lines.encoded(), lines.dataSize());
+    flushCacheWriter(wr);
+    ok = wr.ok;
+
+    memcpy(hdr.magic, CACHE_MAGIC, sizeof(hdr.magic));
+    hdr.version = CACHE_VERSION;
+    hdr.byteOrder = CACHE_BYTE_ORDER;
+    hdr.key = key;
+    hdr.numSymbols = numSymbols;
+    hdr.numStrings = strings.size();
+    hdr.stringsSize = strings.dataSize();
+    hdr.sectionsFound = stats.sectionsFound;
+    hdr.invalidLines = stats.invalidLines;
+    hdr.numLineEntries = lines.size();
+    hdr.lineDataSize = lines.dataSize();
+    hdr.fileLen = wr.offs;
+    hdr.dataHash = wr.hash;
+    hdr.headerHash = hashBuffer(&hdr, offsetof(MapFile::MAPCacheHeader, headerHash), 0);
+    ok = ok && (fseek(fp, 0, SEEK_SET) == 0) && (fwrite(&hdr, sizeof(hdr), 1, fp) == 1);
+    ok = (fclose(fp) == 0) && ok;
+    if (ok)
+    {
+#if defined(_WIN32)
+        // Windows rename() does not replace existing files
+        remove(cacheFileName);
+#endif
+        ok = (rename(tempFileName.c_str(), cacheFileName) == 0);
+    }
+    if (!ok)
+        remove(tempFileName.c_str());
+    return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives text describing cache load result.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+const char * MapFile::getCacheResultName(MapFile::MAPCacheResult result)
+{
+    switch (result)
+    {
+    case MapFile::CACHE_HIT:
+        return "valid";
+    case MapFile::CACHE_MISSING:
+        return "missing";
+    case MapFile::CACHE_STALE:
+        return "outdated";
+    case MapFile::CACHE_CORRUPT:
+    default:
+        return "damaged";
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPCache.h
+///     Binary index cache of parsed MAP files header.
+/// @par Purpose:
+///     Stores parsed symbols next to the MAP file, so that loading the same
+///     file again does not require parsing the text.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPCACHE_H_
+#define MAPCACHE_H_
+
+#include  <cstdio>
+
+#include  "MAPReader.h"
+#include  "MAPSymbols.h"
+#include  "MAPSegments.h"
+#include  "MAPParser.h"
+
+namespace MapFile {
+
+/// Extension added to MAP file name to get the cache file name.
+#define MAP_CACHE_EXTENSION ".lmidx"
+
+typedef enum {
+    CACHE_HIT = 0,
+    CACHE_MISSING,      ///< No cache file
+    CACHE_STALE,        ///< Cache of different MAP file, segments or options
+    CACHE_CORRUPT,      ///< Cache file damaged
+} MAPCacheResult;
+
+/// Identifies MAP file content and everything else which affects parsing.
+typedef struct {
+    unsigned long long fileSize;
+    long long fileTime;             ///< Modification time
+    unsigned long long contentHash; ///< Hash of start and end of the content
+    unsigned long long segmentsHash;
+    unsigned long long optionsHash;
+} MAPCacheKey;
+
+bool makeCacheKey(const char * mapFileName, const char * mapData, size_t mapSize,
+    const MAPSegmentMap &segments, const MAPParseOptions &opts, MAPCacheKey &key);
+MAPCacheResult loadSymbolCache(const char * cacheFileName, const MAPCacheKey &key,
+    const MAPSegmentMap &segments, MAPSymbolTable &symbols, MAPParseStats &stats);
+bool saveSymbolCache(const char * cacheFileName, const MAPCacheKey &key,
+    const MAPSymbolTable &symbols, const MAPParseStats &stats);
+const char * getCacheResultName(MAPCacheResult result);
+
+};
+
+#endif
@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPDemangle.cpp
+///     Demangling of symbol names.
+/// @par Purpose:
+///     Demangles names of parsed symbols with a pluggable demangler, keeping
+///     results in a cache, as templated names repeat heavily across objects.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPDemangle.h"
+#include  "MAPParser.h"
+#include  "MAPHash.h"
+
+#include  <cstring>
+#include  <thread>
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks whether the name looks like mangled by a known compiler.
+/// Recognizes MSVC (?name@@...), Itanium ABI used by GCC and Clang (_Z...),
+/// Watcom (W?name$...) and Borland (@Class@name$q...) schemes.
+/// @param name The symbol name
+/// @param len Length of the name
+/// @return True if the name should be given to the demangler
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::isMangledName(const char * name, size_t len)
+{
+    if (len < 3)
+        return false;
+    if (name[0] == '?')
+        return true;
+    if ((name[0] == '_') && (name[1] == 'Z'))
+        return true;
+    if ((name[0] == '_') && (name[1] == '_') && (name[2] == 'Z'))
+        return true;
+    if ((name[0] == 'W') && (name[1] == '?'))
+        return true;
+    if ((name[0] == '@') && (memchr(name, '$', len) != NULL))
+        return true;
+    return false;
+}
+
+void MapFile::MAPDemangleCache::clear(void)
+{
+    std::vector<Entry>().swap(entries);
+    std::unordered_map<unsigned long long, unsigned int>().swap(index);
+}
+
+unsigned int MapFile::MAPDemangleCache::find(unsigned long long hash, const char * name, size_t len) const
+{
+    std::unordered_map<unsigned long long, unsigned int>::const_iterator it = index.find(hash);
+    if (it == index.end())
+        return DEMANGLE_NONE;
+    for (unsigned int entryNo = it->second; entryNo != DEMANGLE_NONE; entryNo = entries[entryNo].next)
+    {
+        const Entry &entry = entries[entryNo];
+        if ((entry.mangled.size() == len) && (memcmp(entry.mangled.data(), name, len) == 0))
+            return entryNo;
+    }
+    return DEMANGLE_NONE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives demangled forms of symbol names.
+/// Names missing in the cache are collected first, then each distinct name
+/// is demangled once, by a pool of threads.
+/// @param symbols The symbols
+/// @param demangler Function which demangles a single name
+/// @param numThreads Amount of worker threads, 0 for auto; 1 calls the
+///     demangler only from the calling thread
+/// @param textIds Receives, for each symbol, identifier of its demangled
+///     text for text(), or DEMANGLE_NONE
+/// @param stats Receives summary of the demangling
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPDemangleCache::demangleSymbols(const MapFile::MAPSymbolTable &symbols,
+    MapFile::MAPDemangleFunc demangler, unsigned int numThreads, std::vector<unsigned int> &textIds,
+    MapFile::MAPDemangleStats &stats)
+{
+    memset(&stats, 0, sizeof(stats));
+    textIds.assign(symbols.size(), DEMANGLE_NONE);
+    if (entries.size() > DEMANGLE_CACHE_LIMIT)
+        clear();
+
+    // Look up every distinct name once; the missing ones get entries to be filled
+    const unsigned int NAME_UNSEEN = DEMANGLE_NONE - 1;
+    std::vector<unsigned int> nameEntries(symbols.strings().size(), NAME_UNSEEN);
+    size_t firstNew = entries.size();
+    for (size_t symNo = 0; symNo < symbols.size(); symNo++)
+    {
+        unsigned int &nameEntry = nameEntries[symbols.nameId(symNo)];
+        if (nameEntry != NAME_UNSEEN)
+        {
+            if (nameEntry != DEMANGLE_NONE)
+            {
+                stats.mangled++;
+                stats.cached++;
+                textIds[symNo] = nameEntry;
+            }
+            continue;
+        }
+        nameEntry = DEMANGLE_NONE;
+        const char * name = symbols.name(symNo);
+        size_t len = symbols.nameLen(symNo);
+        if (!isMangledName(name, len))
+            continue;
+        stats.mangled++;
+        unsigned long long hash = MapFile::hashBuffer(name, len, 0);
+        unsigned int entryNo = find(hash, name, len);
+        if (entryNo == DEMANGLE_NONE)
+        {
+            entryNo = (unsigned int)entries.size();
+            Entry entry;
+            entry.mangled.assign(name, len);
+            entry.ok = false;
+            std::unordered_map<unsigned long long, unsigned int>::iterator it = index.find(hash);
+            if (it != index.end())
+            {
+                entry.next = it->second;
+                it->second = entryNo;
+            }
+            else
+            {
+                entry.next = DEMANGLE_NONE;
+                index[hash] = entryNo;
+            }
+            entries.push_back(entry);
+        }
+        else
+        {
+            stats.cached++;
+        }
+        nameEntry = entryNo;
+        textIds[symNo] = entryNo;
+    }
+
+    // Demangle the new names; entries are not moved while workers run
+    if (numThreads == 0)
+        numThreads = std::thread::hardware_concurrency();
+    if (numThreads == 0)
+        numThreads = 1;
+    MapFile::runInParallel(numThreads, entries.size() - firstNew, [&](size_t jobNo)
+    {
+        Entry &entry = entries[firstNew + jobNo];
+        entry.ok = demangler(entry.mangled.c_str(), entry.text) && !entry.text.empty() &&
+            (entry.text != entry.mangled);
+        if (!entry.ok)
+            std::string().swap(entry.text);
+    });
+    for (size_t entryNo = firstNew; entryNo < entries.size(); entryNo++)
+    {
+        if (entries[entryNo].ok)
+            stats.demangled++;
+    }
+
+    for (size_t symNo = 0; symNo < textIds.size(); symNo++)
+    {
+        unsigned int entryNo = textIds[symNo];
+        if (entryNo == DEMANGLE_NONE)
+            continue;
+        if (!entries[entryNo].ok)
+        {
+            textIds[symNo] = DEMANGLE_NONE;
+            stats.failed++;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPDemangle.h
+///     Demangling of symbol names header.
+/// @par Purpose:
+///     Demangles names of parsed symbols with a pluggable demangler, keeping
+///     results in a cache, as templated names repeat heavily across objects.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPDEMANGLE_H_
+#define MAPDEMANGLE_H_
+
+#include  <cstdio>
+#include  <vector>
+#include  <string>
+#include  <unordered_map>
+
+#include  "MAPReader.h"
+#include  "MAPSymbols.h"
+
+namespace MapFile {
+
+/// Demangler function; returns false if the name cannot be demangled.
+/// Called from worker threads, unless the demangle is done in one thread.
+typedef bool (*MAPDemangleFunc)(const char * name, std::string &demangled);
+
+/// Text identifier of symbols which have no demangled form.
+const unsigned int DEMANGLE_NONE = 0xFFFFFFFF;
+/// Amount of names kept in cache; it is emptied when that is exceeded.
+const size_t DEMANGLE_CACHE_LIMIT = 4 * 1024 * 1024;
+
+/// Summary of the demangling.
+typedef struct {
+    unsigned long mangled;      ///< Symbols with mangled names
+    unsigned long demangled;    ///< Distinct names demangled by the demangler
+    unsigned long cached;       ///< Symbols which names were found in cache
+    unsigned long failed;       ///< Symbols which names could not be demangled
+} MAPDemangleStats;
+
+bool isMangledName(const char * name, size_t len);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Cache of demangled names, indexed by hash of the mangled name.
+/// Failures are cached as well, so that every name is demangled once.
+////////////////////////////////////////////////////////////////////////////////
+class MAPDemangleCache {
+public:
+    void clear(void);
+    size_t size(void) const { return entries.size(); }
+    void demangleSymbols(const MAPSymbolTable &symbols, MAPDemangleFunc demangler, unsigned int numThreads,
+        std::vector<unsigned int> &textIds, MAPDemangleStats &stats);
+    const char * text(unsigned int textId) const { return entries[textId].text.c_str(); }
+
+private:
+    typedef struct {
+        std::string mangled;
+        std::string text;
+        bool ok;
+        unsigned int next;      ///< Next entry with the same hash
+    } Entry;
+
+    unsigned int find(unsigned long long hash, const char * name, size_t len) const;
+
+    std::vector<Entry> entries;
+    std::unordered_map<unsigned long long, unsigned int> index;
+};
+
+};
+
+#endif
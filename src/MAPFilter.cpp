@@ -0,0 +1,351 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPFilter.cpp
+///     Selective import filter.
+/// @par Purpose:
+///     Selects symbols to import by segment, address range, object file or
+///     name pattern, so that the rest is rejected while parsing.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPFilter.h"
+
+#include  <cstdlib>
+#include  <cstring>
+#include  <cctype>
+#include  <cerrno>
+#include  <algorithm>
+
+#include "stdafx.h"
+
+using namespace std;
+
+namespace MapFile {
+
+/// Largest segment number accepted in the filter.
+const unsigned long FILTER_MAX_SEGMENT = 0xFFFF;
+
+};
+
+static inline bool isFilterSpace(char c)
+{
+    return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n');
+}
+
+static inline bool sameChr(char a, char b, bool ignoreCase)
+{
+    return (a == b) || (ignoreCase && (tolower((unsigned char)a) == tolower((unsigned char)b)));
+}
+
+static bool rangeStartsBefore(const MapFile::MAPFilterRange &a, const MapFile::MAPFilterRange &b)
+{
+    return (a.start < b.start);
+}
+
+/// Reads unsigned number, which ends at '-' or '+' separator of a range, or at end of the value.
+static bool parseFilterNumber(const char * &p, const char * pEnd, int base, unsigned long long &val)
+{
+    char buf[32];
+    size_t len = 0;
+    while ((p + len < pEnd) && (p[len] != '-') && (p[len] != '+') && (len + 1 < sizeof(buf)))
+    {
+        buf[len] = p[len];
+        len++;
+    }
+    buf[len] = '\0';
+    char * pNumEnd;
+    errno = 0;
+    val = strtoull(buf, &pNumEnd, base);
+    if ((pNumEnd == buf) || (*pNumEnd != '\0') || (errno != 0))
+        return false;
+    p += len;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Matches a string with glob pattern.
+/// '*' matches any sequence of characters, '?' matches any one character.
+/// @param pattern The pattern; not terminated
+/// @param patternLen Length of the pattern
+/// @param str The string; not terminated
+/// @param strLen Length of the string
+/// @param ignoreCase Compare letters regardless of case
+/// @return True if the whole string matches
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::matchGlob(const char * pattern, size_t patternLen, const char * str, size_t strLen, bool ignoreCase)
+{
+    size_t p = 0;
+    size_t s = 0;
+    // Position after the last '*', and the string position it was tried at
+    size_t starP = (size_t)-1;
+    size_t starS = 0;
+    while (s < strLen)
+    {
+        if ((p < patternLen) && (pattern[p] == '*'))
+        {
+            starP = ++p;
+            starS = s;
+        }
+        else if ((p < patternLen) && ((pattern[p] == '?') || sameChr(pattern[p], str[s], ignoreCase)))
+        {
+            p++;
+            s++;
+        }
+        else if (starP != (size_t)-1)
+        {
+            // Let the last '*' take one more character
+            p = starP;
+            s = ++starS;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    while ((p < patternLen) && (pattern[p] == '*'))
+        p++;
+    return (p == patternLen);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes all conditions, so that the filter accepts all symbols.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPFilter::clear(void)
+{
+    segAccepted.clear();
+    ranges.clear();
+    objPatterns.clear();
+    namePatterns.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds segment to the accepted ones.
+/// @param seg Index of the segment, one less than its number within MAP file
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPFilter::addSegment(unsigned long seg)
+{
+    if (seg >= segAccepted.size())
+        segAccepted.resize(seg + 1, 0);
+    segAccepted[seg] = 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds range of accepted linear addresses.
+/// Ranges are kept sorted and joined, so that lookup is a binary search.
+/// @param start First address of the range
+/// @param end First address after the range
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPFilter::addRange(MapFile::MAPAddress start, MapFile::MAPAddress end)
+{
+    if (end <= start)
+        return;
+    MapFile::MAPFilterRange range;
+    range.start = start;
+    range.end = end;
+    ranges.push_back(range);
+    std::sort(ranges.begin(), ranges.end(), rangeStartsBefore);
+    size_t numJoined = 0;
+    for (size_t i = 0; i < ranges.size(); i++)
+    {
+        if ((numJoined > 0) && (ranges[i].start <= ranges[numJoined - 1].end))
+        {
+            if (ranges[i].end > ranges[numJoined - 1].end)
+                ranges[numJoined - 1].end = ranges[i].end;
+            continue;
+        }
+        ranges[numJoined++] = ranges[i];
+    }
+    ranges.resize(numJoined);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads conditions of the filter from text.
+/// Conditions are separated by spaces; each is a key, '=' and comma separated
+/// list of values:
+/// - "seg=1,3" - segment numbers as in MAP file, in hex,
+/// - "addr=0x401000-0x402000,0x500000+0x100" - linear address ranges, given by
+///   end or by size; a single address selects just that address,
+/// - "obj=*render*.obj,libcmt:*" - patterns of MSVC "Lib:Object" or Watcom
+///   module; matched with the whole string or with the object file name alone,
+///   regardless of case,
+/// - "name=?Draw*" - patterns of symbol names.
+/// The conditions are added to the ones the filter already has.
+/// @param spec Text with the conditions
+/// @param error Receives description of the first invalid condition
+/// @return False if the text is not valid
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPFilter::parse(const char * spec, std::string &error)
+{
+    const char * p = spec;
+    for (;;)
+    {
+        while (isFilterSpace(*p))
+            p++;
+        if (*p == '\0')
+            return true;
+        const char * pTerm = p;
+        while ((*p != '\0') && !isFilterSpace(*p))
+            p++;
+        const char * pTermEnd = p;
+        const char * pEq = (const char *)memchr(pTerm, '=', (size_t)(pTermEnd - pTerm));
+        if (pEq == NULL)
+        {
+            error = "missing '=' in '" + std::string(pTerm, pTermEnd) + "'";
+            return false;
+        }
+        std::string key(pTerm, pEq);
+        const char * pVal = pEq + 1;
+        while (pVal < pTermEnd)
+        {
+            const char * pValEnd = (const char *)memchr(pVal, ',', (size_t)(pTermEnd - pVal));
+            if (pValEnd == NULL)
+                pValEnd = pTermEnd;
+            const char * pNum = pVal;
+            unsigned long long start, val;
+            bool valid = true;
+            if (pValEnd == pVal)
+            {
+                error = "empty value of " + key;
+                return false;
+            }
+            if (strcasecmp(key.c_str(), "seg") == 0)
+            {
+                valid = parseFilterNumber(pNum, pValEnd, 16, val) && (pNum == pValEnd) &&
+                    (val > 0) && (val <= MapFile::FILTER_MAX_SEGMENT);
+                if (valid)
+                    addSegment((unsigned long)(val - 1));
+            }
+            else if (strcasecmp(key.c_str(), "addr") == 0)
+            {
+                valid = parseFilterNumber(pNum, pValEnd, 0, start);
+                val = start + 1;
+                if (valid && (pNum < pValEnd))
+                {
+                    char sep = *pNum++;
+                    valid = parseFilterNumber(pNum, pValEnd, 0, val) && (pNum == pValEnd);
+                    if (sep == '+')
+                        val += start;
+                }
+                valid = valid && (val > start) && ((MapFile::MAPAddress)start == start) &&
+                    ((MapFile::MAPAddress)(val - 1) == val - 1);
+                if (valid)
+                    addRange((MapFile::MAPAddress)start, (MapFile::MAPAddress)(val - 1) + 1);
+            }
+            else if (strcasecmp(key.c_str(), "obj") == 0)
+            {
+                addObjectPattern(pVal, (size_t)(pValEnd - pVal));
+            }
+            else if (strcasecmp(key.c_str(), "name") == 0)
+            {
+                addNamePattern(pVal, (size_t)(pValEnd - pVal));
+            }
+            else
+            {
+                error = "unknown condition '" + key + "', expected seg, addr, obj or name";
+                return false;
+            }
+            if (!valid)
+            {
+                error = "invalid value '" + std::string(pVal, pValEnd) + "' of " + key;
+                return false;
+            }
+            pVal = (pValEnd < pTermEnd) ? (pValEnd + 1) : pTermEnd;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks segment and address of a symbol; cheapest of the checks.
+/// @param seg Index of the segment
+/// @param ea Linear address
+/// @return True if the symbol is within accepted segments and ranges
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPFilter::acceptsAddress(unsigned long seg, MapFile::MAPAddress ea) const
+{
+    if (!segAccepted.empty() && ((seg >= segAccepted.size()) || (segAccepted[seg] == 0)))
+        return false;
+    if (ranges.empty())
+        return true;
+    // Find the last range which starts at or before the address
+    size_t lo = 0;
+    size_t hi = ranges.size();
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (ranges[mid].start <= ea)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return (lo > 0) && (ea < ranges[lo - 1].end);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks object file or module of a symbol.
+/// Symbols are usually grouped by object file, so the parser calls this once
+/// for each group rather than for each symbol.
+/// @param object MSVC "Lib:Object" field or Watcom module; not terminated
+/// @param objectLen Length of the object, 0 if it is not known
+/// @return True if any pattern matches, or there are no object patterns
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPFilter::acceptsObject(const char * object, size_t objectLen) const
+{
+    if (objPatterns.empty())
+        return true;
+    // Object file name alone, without library or path
+    size_t baseStart = objectLen;
+    while ((baseStart > 0) && (object[baseStart - 1] != ':') && (object[baseStart - 1] != '\\') &&
+        (object[baseStart - 1] != '/'))
+        baseStart--;
+    for (size_t i = 0; i < objPatterns.size(); i++)
+    {
+        const std::string &pattern = objPatterns[i];
+        if (MapFile::matchGlob(pattern.data(), pattern.size(), object, objectLen, true))
+            return true;
+        if ((baseStart > 0) && MapFile::matchGlob(pattern.data(), pattern.size(), object + baseStart,
+            objectLen - baseStart, true))
+            return true;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks name of a symbol; done last, as it is the most costly check.
+/// @param name The name; not terminated
+/// @param nameLen Length of the name
+/// @return True if any pattern matches, or there are no name patterns
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPFilter::acceptsName(const char * name, size_t nameLen) const
+{
+    if (namePatterns.empty())
+        return true;
+    for (size_t i = 0; i < namePatterns.size(); i++)
+    {
+        if (MapFile::matchGlob(namePatterns[i].data(), namePatterns[i].size(), name, nameLen, false))
+            return true;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
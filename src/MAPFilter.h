@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPFilter.h
+///     Selective import filter header.
+/// @par Purpose:
+///     Selects symbols to import by segment, address range, object file or
+///     name pattern, so that the rest is rejected while parsing.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPFILTER_H_
+#define MAPFILTER_H_
+
+#include  <cstdio>
+#include  <string>
+#include  <vector>
+
+#include  "MAPReader.h"
+
+namespace MapFile {
+
+/// Range of accepted linear addresses.
+typedef struct {
+    MAPAddress start;
+    MAPAddress end;         ///< First address after the range
+} MAPFilterRange;
+
+bool matchGlob(const char * pattern, size_t patternLen, const char * str, size_t strLen, bool ignoreCase);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Symbols selected for import.
+/// Kinds of conditions are all required; within one kind, any of the listed
+/// segments, ranges or patterns is enough. An empty filter accepts all.
+/// Checks are ordered by cost, so the parser can reject a line by address
+/// before it reads the name, and by object file once for each module.
+////////////////////////////////////////////////////////////////////////////////
+class MAPFilter {
+public:
+    void clear(void);
+    bool empty(void) const { return !hasAddresses() && !hasObjects() && !hasNames(); }
+    bool parse(const char * spec, std::string &error);
+    void addSegment(unsigned long seg);
+    void addRange(MAPAddress start, MAPAddress end);
+    void addObjectPattern(const char * pattern, size_t len) { objPatterns.push_back(std::string(pattern, len)); }
+    void addNamePattern(const char * pattern, size_t len) { namePatterns.push_back(std::string(pattern, len)); }
+    bool hasAddresses(void) const { return !segAccepted.empty() || !ranges.empty(); }
+    bool hasObjects(void) const { return !objPatterns.empty(); }
+    bool hasNames(void) const { return !namePatterns.empty(); }
+    bool acceptsAddress(unsigned long seg, MAPAddress ea) const;
+    bool acceptsObject(const char * object, size_t objectLen) const;
+    bool acceptsName(const char * name, size_t nameLen) const;
+
+private:
+    std::vector<unsigned char> segAccepted; ///< Indexed by segment, empty if any segment is accepted
+    std::vector<MAPFilterRange> ranges;     ///< Sorted by start address, not overlapping
+    std::vector<std::string> objPatterns;
+    std::vector<std::string> namePatterns;
+};
+
+};
+
+#endif
@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPHash.cpp
+///     Fast hashing of buffers.
+/// @par Purpose:
+///     Non-cryptographic hash used to identify cached data, to intern strings
+///     and to name records of imports.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPHash.h"
+
+#include  <cstring>
+
+static inline unsigned long long loadWord(const unsigned char * p)
+{
+    unsigned long long w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+static inline unsigned long long rotateLeft(unsigned long long x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline unsigned long long hashRound(unsigned long long acc, unsigned long long w)
+{
+    acc += w * 0xC2B2AE3D27D4EB4FULL;
+    acc = rotateLeft(acc, 31);
+    return acc * 0x9E3779B185EBCA87ULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Computes fast non-cryptographic hash of a buffer.
+/// Uses four independent lanes of 64-bit words, so it runs at memory speed.
+/// @param data The buffer
+/// @param len Length of the buffer
+/// @param seed Initial value; allows chaining hashes of several buffers
+/// @return The hash value
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+unsigned long long MapFile::hashBuffer(const void * data, size_t len, unsigned long long seed)
+{
+    const unsigned char * p = (const unsigned char *)data;
+    const unsigned char * pEnd = p + len;
+    unsigned long long acc0 = seed + 0x9E3779B185EBCA87ULL + 0xC2B2AE3D27D4EB4FULL;
+    unsigned long long acc1 = seed + 0xC2B2AE3D27D4EB4FULL;
+    unsigned long long acc2 = seed;
+    unsigned long long acc3 = seed - 0x9E3779B185EBCA87ULL;
+    while (pEnd - p >= 32)
+    {
+        acc0 = hashRound(acc0, loadWord(p));
+        acc1 = hashRound(acc1, loadWord(p + 8));
+        acc2 = hashRound(acc2, loadWord(p + 16));
+        acc3 = hashRound(acc3, loadWord(p + 24));
+        p += 32;
+    }
+    unsigned long long h = rotateLeft(acc0, 1) + rotateLeft(acc1, 7) + rotateLeft(acc2, 12) + rotateLeft(acc3, 18);
+    h += (unsigned long long)len;
+    while (pEnd - p >= 8)
+    {
+        h = hashRound(h, loadWord(p));
+        p += 8;
+    }
+    while (p < pEnd)
+    {
+        h = hashRound(h, *p);
+        p++;
+    }
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return h;
+}
+
+////////////////////////////////////////////////////////////////////////////////
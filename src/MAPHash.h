@@ -0,0 +1,27 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPHash.h
+///     Fast hashing of buffers header.
+/// @par Purpose:
+///     Non-cryptographic hash used to identify cached data, to intern strings
+///     and to name records of imports.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPHASH_H_
+#define MAPHASH_H_
+
+#include  <cstddef>
+
+namespace MapFile {
+
+unsigned long long hashBuffer(const void * data, size_t len, unsigned long long seed);
+
+};
+
+#endif
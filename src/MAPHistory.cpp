@@ -0,0 +1,351 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPHistory.cpp
+///     Record of applied symbols and delta between imports.
+/// @par Purpose:
+///     Remembers which symbols were applied by previous import of a MAP file,
+///     so that re-import of a rebuilt MAP file only touches changed addresses.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPHistory.h"
+#include  "MAPSerialize.h"
+
+#include  <cstring>
+#include  <algorithm>
+
+using namespace std;
+
+/// Identifier at start of the serialized record.
+static const unsigned char HISTORY_MAGIC[4] = { 'L', 'M', 'A', 'H' };
+/// Version of the serialized record; increase when the layout changes.
+const unsigned int HISTORY_VERSION = 1;
+/// Size of fixed part of serialized record entry: address, kind, name length.
+const size_t HISTORY_ENTRY_SIZE = 8 + 1 + 4;
+
+static bool sameName(const MapFile::MAPSymbolTable &tab1, size_t idx1, const MapFile::MAPSymbolTable &tab2, size_t idx2)
+{
+    return (tab1.nameLen(idx1) == tab2.nameLen(idx2)) &&
+        (memcmp(tab1.name(idx1), tab2.name(idx2), tab1.nameLen(idx1)) == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Decides whether a symbol is applied as name or as comment.
+/// @param kind Kind of the symbol given by the parser
+/// @param defaultAsName Plugin option for symbols of default kind
+/// @return True if the symbol is applied as name
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::isAppliedAsName(MapFile::SymbolKind kind, bool defaultAsName)
+{
+    if (kind == SYMKIND_NAME)
+        return true;
+    if (kind == SYMKIND_COMMENT)
+        return false;
+    return defaultAsName;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Stores the record of applied symbols into a byte buffer.
+/// The layout does not depend on host byte order nor address size.
+/// @param applied Applied symbols, ordered by address and type
+/// @param blob Receives the serialized record
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::serializeAppliedSymbols(const MapFile::MAPSymbolTable &applied, std::vector<unsigned char> &blob)
+{
+    blob.clear();
+    blob.reserve(sizeof(HISTORY_MAGIC) + 4 + 8 + applied.size() * HISTORY_ENTRY_SIZE + applied.strings().dataSize());
+    blob.insert(blob.end(), HISTORY_MAGIC, HISTORY_MAGIC + sizeof(HISTORY_MAGIC));
+    putLE(blob, HISTORY_VERSION, 4);
+    putLE(blob, applied.size(), 8);
+    for (size_t i = 0; i < applied.size(); i++)
+    {
+        putLE(blob, applied.ea(i), 8);
+        putLE(blob, (unsigned char)applied.kind(i), 1);
+        putLE(blob, applied.nameLen(i), 4);
+        const unsigned char * pname = (const unsigned char *)applied.name(i);
+        blob.insert(blob.end(), pname, pname + applied.nameLen(i));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Restores the record of applied symbols from a byte buffer.
+/// @param blob Serialized record
+/// @param blobLen Size of the serialized record
+/// @param applied Receives the applied symbols
+/// @return True if the record was valid; on failure, the table is empty
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::deserializeAppliedSymbols(const unsigned char * blob, size_t blobLen, MapFile::MAPSymbolTable &applied)
+{
+    applied.clear();
+    const size_t headerSize = sizeof(HISTORY_MAGIC) + 4 + 8;
+    if ((blob == NULL) || (blobLen < headerSize) ||
+        (memcmp(blob, HISTORY_MAGIC, sizeof(HISTORY_MAGIC)) != 0) ||
+        (getLE(blob + 4, 4) != HISTORY_VERSION))
+        return false;
+    unsigned long long numSymbols = getLE(blob + 8, 8);
+    if (numSymbols > (blobLen - headerSize) / HISTORY_ENTRY_SIZE)
+        return false;
+    applied.reserve((size_t)numSymbols, (size_t)numSymbols, blobLen - headerSize - (size_t)numSymbols * HISTORY_ENTRY_SIZE);
+    const unsigned char * p = blob + headerSize;
+    const unsigned char * pEnd = blob + blobLen;
+    for (unsigned long long i = 0; i < numSymbols; i++)
+    {
+        if ((size_t)(pEnd - p) < HISTORY_ENTRY_SIZE)
+            break;
+        unsigned long long ea = getLE(p, 8);
+        unsigned char kind = p[8];
+        size_t nameLen = (size_t)getLE(p + 9, 4);
+        p += HISTORY_ENTRY_SIZE;
+        if ((size_t)(pEnd - p) < nameLen)
+            break;
+        // Entries must be ordered by address, with names before comments
+        if ((kind != SYMKIND_NAME) && (kind != SYMKIND_COMMENT))
+            break;
+        if ((MAPAddress)ea != ea)
+            break;
+        if (!applied.empty() && ((applied.ea(applied.size() - 1) > ea) ||
+            ((applied.ea(applied.size() - 1) == ea) && (applied.kind(applied.size() - 1) > kind))))
+            break;
+        applied.append(0, (MAPAddress)ea, (MAPAddress)ea, (SymbolKind)kind, (const char *)p, nameLen);
+        p += nameLen;
+    }
+    if ((applied.size() != numSymbols) || (p != pEnd))
+    {
+        applied.clear();
+        return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Finds entries of previous record at given address and type.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void findPrevGroup(const MapFile::MAPSymbolTable &prevApplied, size_t prevStart, size_t prevEnd,
+    bool asName, size_t &prevFirst, size_t &prevCount)
+{
+    MapFile::SymbolKind kind = asName ? MapFile::SYMKIND_NAME : MapFile::SYMKIND_COMMENT;
+    prevFirst = prevStart;
+    while ((prevFirst < prevEnd) && (prevApplied.kind(prevFirst) != kind))
+        prevFirst++;
+    prevCount = 0;
+    while ((prevFirst + prevCount < prevEnd) && (prevApplied.kind(prevFirst + prevCount) == kind))
+        prevCount++;
+}
+
+/// Entry of previous record which is no longer in the MAP file, ordered by name.
+typedef struct {
+    const char * name;
+    size_t nameLen;
+    size_t prevNo;
+} RemovedName;
+
+static bool removedNameLess(const RemovedName &a, const RemovedName &b)
+{
+    int cmp = memcmp(a.name, b.name, min(a.nameLen, b.nameLen));
+    if (cmp != 0)
+        return (cmp < 0);
+    return (a.nameLen < b.nameLen);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Compares symbols of the MAP file with the record of previous import.
+/// Symbols are compared in groups sharing the same address and type; a group
+/// is unchanged if it has the same names in the same order as previously.
+/// Groups which exist only in previous record are removed; an added symbol
+/// whose name was removed from another address is reported as moved.
+/// @param symbols Symbols of the MAP file
+/// @param sorted References to the symbols, ordered by address
+/// @param defaultAsName Plugin option for symbols of default kind
+/// @param prevApplied Record of previous import, ordered by address and type
+/// @param delta Receives state of each entry of sorted
+/// @param removed Receives indices of previous record entries to be removed
+/// @param stats Receives summary of the differences
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::computeImportDelta(const MapFile::MAPSymbolTable &symbols, const std::vector<MapFile::MAPSymbolRef> &sorted,
+    bool defaultAsName, const MapFile::MAPSymbolTable &prevApplied, std::vector<MapFile::MAPDeltaEntry> &delta,
+    std::vector<size_t> &removed, MapFile::MAPDeltaStats &stats)
+{
+    memset(&stats, 0, sizeof(stats));
+    delta.resize(sorted.size());
+    removed.clear();
+    vector<size_t> group;
+    size_t refStart = 0;
+    size_t prevStart = 0;
+    while ((refStart < sorted.size()) || (prevStart < prevApplied.size()))
+    {
+        MAPAddress ea;
+        if (refStart >= sorted.size())
+            ea = prevApplied.ea(prevStart);
+        else if (prevStart >= prevApplied.size())
+            ea = sorted[refStart].ea;
+        else
+            ea = min(sorted[refStart].ea, prevApplied.ea(prevStart));
+        size_t refEnd = refStart;
+        while ((refEnd < sorted.size()) && (sorted[refEnd].ea == ea))
+            refEnd++;
+        size_t prevEnd = prevStart;
+        while ((prevEnd < prevApplied.size()) && (prevApplied.ea(prevEnd) == ea))
+            prevEnd++;
+
+        for (int typeNo = 0; typeNo < 2; typeNo++)
+        {
+            bool asName = (typeNo == 0);
+            group.clear();
+            for (size_t refNo = refStart; refNo < refEnd; refNo++)
+            {
+                if (isAppliedAsName(symbols.kind(sorted[refNo].symNo), defaultAsName) == asName)
+                    group.push_back(refNo);
+            }
+            size_t prevFirst, prevCount;
+            findPrevGroup(prevApplied, prevStart, prevEnd, asName, prevFirst, prevCount);
+            if (group.empty())
+            {
+                for (size_t k = 0; k < prevCount; k++)
+                    removed.push_back(prevFirst + k);
+                stats.removed += prevCount;
+                continue;
+            }
+            MAPDeltaKind kind;
+            if (prevCount == 0)
+            {
+                kind = DELTA_ADDED;
+                stats.added += group.size();
+            }
+            else
+            {
+                bool same = (group.size() == prevCount);
+                for (size_t k = 0; same && (k < prevCount); k++)
+                    same = sameName(symbols, sorted[group[k]].symNo, prevApplied, prevFirst + k);
+                kind = same ? DELTA_UNCHANGED : DELTA_RENAMED;
+                if (same)
+                    stats.unchanged += group.size();
+                else
+                    stats.renamed += group.size();
+            }
+            for (size_t k = 0; k < group.size(); k++)
+            {
+                delta[group[k]].kind = (unsigned char)kind;
+                delta[group[k]].prevFirst = prevFirst;
+                delta[group[k]].prevCount = prevCount;
+            }
+        }
+        refStart = refEnd;
+        prevStart = prevEnd;
+    }
+
+    if (removed.empty() || (stats.added == 0))
+        return;
+    // Added symbols which were removed from another address have moved
+    vector<RemovedName> removedNames(removed.size());
+    for (size_t k = 0; k < removed.size(); k++)
+    {
+        removedNames[k].name = prevApplied.name(removed[k]);
+        removedNames[k].nameLen = prevApplied.nameLen(removed[k]);
+        removedNames[k].prevNo = removed[k];
+    }
+    sort(removedNames.begin(), removedNames.end(), removedNameLess);
+    vector<unsigned char> matched(removedNames.size(), 0);
+    for (size_t refNo = 0; refNo < sorted.size(); refNo++)
+    {
+        if (delta[refNo].kind != DELTA_ADDED)
+            continue;
+        RemovedName key;
+        key.name = symbols.name(sorted[refNo].symNo);
+        key.nameLen = symbols.nameLen(sorted[refNo].symNo);
+        key.prevNo = 0;
+        vector<RemovedName>::iterator it = lower_bound(removedNames.begin(), removedNames.end(), key, removedNameLess);
+        for (; (it != removedNames.end()) && !removedNameLess(key, *it); ++it)
+        {
+            size_t k = it - removedNames.begin();
+            if (matched[k] || (isAppliedAsName(prevApplied.kind(it->prevNo), true) !=
+                isAppliedAsName(symbols.kind(sorted[refNo].symNo), defaultAsName)))
+                continue;
+            matched[k] = 1;
+            delta[refNo].kind = DELTA_MOVED;
+            stats.added--;
+            stats.removed--;
+            stats.moved++;
+            break;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Prepares the record of symbols applied by current import.
+/// Unchanged groups are kept as in previous record; other groups are recorded
+/// if at least one of their symbols was applied.
+/// @param symbols Symbols of the MAP file
+/// @param sorted References to the symbols, ordered by address
+/// @param defaultAsName Plugin option for symbols of default kind
+/// @param prevApplied Record of previous import
+/// @param delta State of each entry of sorted, from computeImportDelta()
+/// @param applyOk Non-zero for each entry of sorted which was applied
+/// @param applied Receives the new record, ordered by address and type
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::collectAppliedSymbols(const MapFile::MAPSymbolTable &symbols, const std::vector<MapFile::MAPSymbolRef> &sorted,
+    bool defaultAsName, const MapFile::MAPSymbolTable &prevApplied, const std::vector<MapFile::MAPDeltaEntry> &delta,
+    const std::vector<unsigned char> &applyOk, MapFile::MAPSymbolTable &applied)
+{
+    applied.clear();
+    size_t refStart = 0;
+    while (refStart < sorted.size())
+    {
+        size_t refEnd = refStart;
+        while ((refEnd < sorted.size()) && (sorted[refEnd].ea == sorted[refStart].ea))
+            refEnd++;
+        // Names go before comments, as expected by the record
+        for (int typeNo = 0; typeNo < 2; typeNo++)
+        {
+            bool asName = (typeNo == 0);
+            SymbolKind kind = asName ? SYMKIND_NAME : SYMKIND_COMMENT;
+            bool anyApplied = false;
+            bool unchanged = false;
+            size_t prevFirst = 0, prevCount = 0;
+            for (size_t refNo = refStart; refNo < refEnd; refNo++)
+            {
+                if (isAppliedAsName(symbols.kind(sorted[refNo].symNo), defaultAsName) != asName)
+                    continue;
+                unchanged = (delta[refNo].kind == DELTA_UNCHANGED);
+                prevFirst = delta[refNo].prevFirst;
+                prevCount = delta[refNo].prevCount;
+                if (applyOk[refNo])
+                    anyApplied = true;
+            }
+            if (unchanged)
+            {
+                for (size_t k = prevFirst; k < prevFirst + prevCount; k++)
+                    applied.append(0, prevApplied.ea(k), prevApplied.ea(k), kind, prevApplied.name(k), prevApplied.nameLen(k));
+                continue;
+            }
+            if (!anyApplied)
+                continue;
+            for (size_t refNo = refStart; refNo < refEnd; refNo++)
+            {
+                size_t symNo = sorted[refNo].symNo;
+                if (isAppliedAsName(symbols.kind(symNo), defaultAsName) != asName)
+                    continue;
+                applied.append(0, sorted[refNo].ea, sorted[refNo].ea, kind, symbols.name(symNo), symbols.nameLen(symNo));
+            }
+        }
+        refStart = refEnd;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPHistory.h
+///     Record of applied symbols and delta between imports header.
+/// @par Purpose:
+///     Remembers which symbols were applied by previous import of a MAP file,
+///     so that re-import of a rebuilt MAP file only touches changed addresses.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPHISTORY_H_
+#define MAPHISTORY_H_
+
+#include  <cstdio>
+#include  <vector>
+
+#include  "MAPReader.h"
+#include  "MAPSymbols.h"
+
+namespace MapFile {
+
+typedef enum {
+    DELTA_UNCHANGED = 0,    ///< Applied by previous import, no need to touch
+    DELTA_ADDED,            ///< New symbol
+    DELTA_RENAMED,          ///< Different name at address used by previous import
+    DELTA_MOVED,            ///< Name applied by previous import at different address
+} MAPDeltaKind;
+
+/// How a symbol differs from the previous import. Symbols are compared in groups
+/// which share address and type (name or comment).
+typedef struct {
+    unsigned char kind;     ///< MAPDeltaKind value
+    size_t prevFirst;       ///< First entry of previous import within the same group
+    size_t prevCount;       ///< Amount of entries of previous import within the same group
+} MAPDeltaEntry;
+
+/// Summary of differences against the previous import, in symbols.
+typedef struct {
+    unsigned long unchanged;
+    unsigned long added;
+    unsigned long removed;
+    unsigned long renamed;
+    unsigned long moved;
+} MAPDeltaStats;
+
+bool isAppliedAsName(SymbolKind kind, bool defaultAsName);
+void serializeAppliedSymbols(const MAPSymbolTable &applied, std::vector<unsigned char> &blob);
+bool deserializeAppliedSymbols(const unsigned char * blob, size_t blobLen, MAPSymbolTable &applied);
+void computeImportDelta(const MAPSymbolTable &symbols, const std::vector<MAPSymbolRef> &sorted,
+    bool defaultAsName, const MAPSymbolTable &prevApplied, std::vector<MAPDeltaEntry> &delta,
+    std::vector<size_t> &removed, MAPDeltaStats &stats);
+void collectAppliedSymbols(const MAPSymbolTable &symbols, const std::vector<MAPSymbolRef> &sorted,
+    bool defaultAsName, const MAPSymbolTable &prevApplied, const std::vector<MAPDeltaEntry> &delta,
+    const std::vector<unsigned char> &applyOk, MAPSymbolTable &applied);
+
+};
+
+#endif
@@ -0,0 +1,277 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPJournal.cpp
+///     Journal of changes made by an import.
+/// @par Purpose:
+///     Records names and comments changed by an import, with their previous
+///     values, so that the import can be reverted, or replayed elsewhere.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPJournal.h"
+#include  "MAPSerialize.h"
+
+#include  <cstring>
+#include  <algorithm>
+
+using namespace std;
+
+/// Identifier at start of the serialized journal.
+static const unsigned char JOURNAL_MAGIC[4] = { 'L', 'M', 'A', 'J' };
+/// Version of the serialized journal; increase when the layout changes.
+const unsigned int JOURNAL_VERSION = 1;
+/// Size of blocks in which journal files are read.
+const size_t JOURNAL_READ_BLOCK = 64 * 1024;
+
+/// Orders entries by address, then by target; entries of the same change keep their order.
+static bool journalEntryBefore(const MapFile::MAPJournalEntry &a, const MapFile::MAPJournalEntry &b)
+{
+    if (a.ea != b.ea)
+        return (a.ea < b.ea);
+    return (a.target < b.target);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes all entries from the journal.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPJournal::clear(void)
+{
+    entries.clear();
+    strings.clear();
+    key.clear();
+}
+
+unsigned int MapFile::MAPJournal::internValue(const char * value)
+{
+    if (value == NULL)
+        return STRING_NONE;
+    return strings.intern(value, strlen(value));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks if the last recorded change is of given name or comment.
+/// Only the value from before the first change is kept, so it does not have
+/// to be read again when the same item is changed once more.
+/// @param ea Address of the item
+/// @param target What is changed at the address
+/// @return True if the last entry is for the same item
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPJournal::isLast(MapFile::MAPAddress ea, MapFile::MAPJournalTarget target) const
+{
+    return !entries.empty() && (entries.back().ea == ea) && (entries.back().target == (unsigned char)target);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Records a change of name or comment.
+/// If the last entry is for the same item, only its new value is updated.
+/// @param ea Address of the item
+/// @param target What is changed at the address
+/// @param flags JOURNAL_* flags, describing the previous value
+/// @param oldValue Value before the change, NULL if there was none
+/// @param newValue Value after the change, NULL if it was removed
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPJournal::add(MapFile::MAPAddress ea, MapFile::MAPJournalTarget target, unsigned char flags,
+    const char * oldValue, const char * newValue)
+{
+    if (isLast(ea, target))
+    {
+        entries.back().newId = internValue(newValue);
+        return;
+    }
+    MapFile::MAPJournalEntry entry;
+    entry.ea = ea;
+    entry.target = (unsigned char)target;
+    entry.flags = flags;
+    entry.oldId = internValue(oldValue);
+    entry.newId = internValue(newValue);
+    entries.push_back(entry);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Orders the entries by address, joining changes of the same item.
+/// Joined entry has the value from before the first change and after the
+/// last one; items which got their previous value back are dropped.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPJournal::finish(void)
+{
+    std::stable_sort(entries.begin(), entries.end(), journalEntryBefore);
+    size_t numKept = 0;
+    for (size_t i = 0; i < entries.size(); )
+    {
+        MapFile::MAPJournalEntry joined = entries[i];
+        for (i++; (i < entries.size()) && !journalEntryBefore(joined, entries[i]); i++)
+            joined.newId = entries[i].newId;
+        if (joined.oldId != joined.newId)
+            entries[numKept++] = joined;
+    }
+    entries.resize(numKept);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Stores the journal into a byte buffer.
+/// The layout does not depend on host byte order nor address size; numbers
+/// are variable-length, and addresses are stored as differences.
+/// @param blob Receives the serialized journal
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPJournal::serialize(std::vector<unsigned char> &blob) const
+{
+    blob.clear();
+    blob.reserve(sizeof(JOURNAL_MAGIC) + 4 + key.size() + strings.dataSize() + strings.size() * 2 +
+        entries.size() * 6 + 32);
+    blob.insert(blob.end(), JOURNAL_MAGIC, JOURNAL_MAGIC + sizeof(JOURNAL_MAGIC));
+    putLE(blob, JOURNAL_VERSION, 4);
+    putVarint(blob, key.size());
+    blob.insert(blob.end(), key.begin(), key.end());
+    putVarint(blob, strings.size());
+    for (unsigned int id = 0; id < strings.size(); id++)
+    {
+        const unsigned char * pstr = (const unsigned char *)strings.str(id);
+        putVarint(blob, strings.len(id));
+        blob.insert(blob.end(), pstr, pstr + strings.len(id));
+    }
+    putVarint(blob, entries.size());
+    MapFile::MAPAddress prevEa = 0;
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        const MapFile::MAPJournalEntry &entry = entries[i];
+        putVarint(blob, entry.ea - prevEa);
+        blob.push_back((unsigned char)(entry.target | (entry.flags << 2)));
+        putVarint(blob, (unsigned int)(entry.oldId + 1));
+        putVarint(blob, (unsigned int)(entry.newId + 1));
+        prevEa = entry.ea;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Restores the journal from a byte buffer.
+/// @param blob Serialized journal
+/// @param blobLen Size of the serialized journal
+/// @return True if the journal was valid; on failure, the journal is empty
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPJournal::deserialize(const unsigned char * blob, size_t blobLen)
+{
+    clear();
+    const size_t headerSize = sizeof(JOURNAL_MAGIC) + 4;
+    if ((blob == NULL) || (blobLen < headerSize) ||
+        (memcmp(blob, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0) ||
+        (getLE(blob + 4, 4) != JOURNAL_VERSION))
+        return false;
+    const unsigned char * p = blob + headerSize;
+    const unsigned char * pEnd = blob + blobLen;
+    unsigned long long keyLen, numStrings, numEntries;
+    if (!getVarint(p, pEnd, keyLen) || (keyLen > (unsigned long long)(pEnd - p)))
+        return false;
+    key.assign((const char *)p, (size_t)keyLen);
+    p += keyLen;
+    // Every string takes at least one byte, and every entry at least four
+    bool valid = getVarint(p, pEnd, numStrings) && (numStrings <= (unsigned long long)(pEnd - p));
+    std::vector<unsigned int> ids;
+    for (unsigned long long i = 0; valid && (i < numStrings); i++)
+    {
+        unsigned long long len;
+        valid = getVarint(p, pEnd, len) && (len <= (unsigned long long)(pEnd - p));
+        if (!valid)
+            break;
+        ids.push_back(strings.intern((const char *)p, (size_t)len));
+        p += len;
+    }
+    valid = valid && getVarint(p, pEnd, numEntries) && (numEntries <= (unsigned long long)(pEnd - p) / 4);
+    if (valid)
+        entries.reserve((size_t)numEntries);
+    for (unsigned long long i = 0; valid && (i < numEntries); i++)
+    {
+        unsigned long long eaDelta, oldCode, newCode;
+        MapFile::MAPJournalEntry entry;
+        valid = getVarint(p, pEnd, eaDelta) && (p < pEnd);
+        if (!valid)
+            break;
+        entry.target = (unsigned char)(*p & 0x03);
+        entry.flags = (unsigned char)(*p >> 2);
+        p++;
+        valid = getVarint(p, pEnd, oldCode) && getVarint(p, pEnd, newCode) &&
+            (oldCode <= numStrings) && (newCode <= numStrings) && (entry.target < JOURNAL_TARGET_COUNT);
+        if (!valid)
+            break;
+        // Entries must be ordered by address and target, each item once
+        MapFile::MAPAddress prevEa = entries.empty() ? 0 : entries.back().ea;
+        entry.ea = prevEa + (MapFile::MAPAddress)eaDelta;
+        valid = (eaDelta <= (unsigned long long)((MapFile::MAPAddress)-1 - prevEa)) &&
+            (entries.empty() || journalEntryBefore(entries.back(), entry));
+        entry.oldId = (oldCode > 0) ? ids[(size_t)oldCode - 1] : STRING_NONE;
+        entry.newId = (newCode > 0) ? ids[(size_t)newCode - 1] : STRING_NONE;
+        if (valid)
+            entries.push_back(entry);
+    }
+    if (!valid || (p != pEnd))
+    {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes the journal into a file, so that it can be replayed elsewhere.
+/// @param fileName Name of the file
+/// @return True if the file was written
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPJournal::saveFile(const char * fileName) const
+{
+    std::vector<unsigned char> blob;
+    serialize(blob);
+    FILE * fp = fopen(fileName, "wb");
+    if (fp == NULL)
+        return false;
+    bool ok = (fwrite(&blob[0], 1, blob.size(), fp) == blob.size());
+    if (fclose(fp) != 0)
+        ok = false;
+    return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads the journal from a file written by saveFile().
+/// @param fileName Name of the file
+/// @return True if the file was read and is valid
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPJournal::loadFile(const char * fileName)
+{
+    clear();
+    FILE * fp = fopen(fileName, "rb");
+    if (fp == NULL)
+        return false;
+    std::vector<unsigned char> blob;
+    size_t numRead;
+    do
+    {
+        size_t oldSize = blob.size();
+        blob.resize(oldSize + JOURNAL_READ_BLOCK);
+        numRead = fread(&blob[oldSize], 1, JOURNAL_READ_BLOCK, fp);
+        blob.resize(oldSize + numRead);
+    } while (numRead == JOURNAL_READ_BLOCK);
+    bool ok = !ferror(fp);
+    fclose(fp);
+    return ok && !blob.empty() && deserialize(&blob[0], blob.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
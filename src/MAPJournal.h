@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPJournal.h
+///     Journal of changes made by an import header.
+/// @par Purpose:
+///     Records names and comments changed by an import, with their previous
+///     values, so that the import can be reverted, or replayed elsewhere.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPJOURNAL_H_
+#define MAPJOURNAL_H_
+
+#include  <cstdio>
+#include  <string>
+#include  <vector>
+
+#include  "MAPReader.h"
+#include  "MAPStrings.h"
+
+namespace MapFile {
+
+/// What was changed at an address.
+typedef enum {
+    JOURNAL_NAME = 0,
+    JOURNAL_COMMENT,
+    JOURNAL_RPT_COMMENT,
+    JOURNAL_TARGET_COUNT
+} MAPJournalTarget;
+
+/// Flags of a journal entry.
+enum {
+    JOURNAL_OLD_AUTO = 0x01,    ///< Previous name was generated by analysis, not given by user
+};
+
+/// One changed name or comment.
+typedef struct {
+    MAPAddress ea;
+    unsigned char target;   ///< MAPJournalTarget value
+    unsigned char flags;    ///< JOURNAL_* flags
+    unsigned int oldId;     ///< Previous value within strings of the journal, STRING_NONE if there was none
+    unsigned int newId;     ///< New value, STRING_NONE if it was removed
+} MAPJournalEntry;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Changes made by one import, ordered by address.
+/// Values are stored once each within a string pool, so a journal of an
+/// import is about as large as the names it changed.
+////////////////////////////////////////////////////////////////////////////////
+class MAPJournal {
+public:
+    size_t size(void) const { return entries.size(); }
+    bool empty(void) const { return entries.empty(); }
+    const MAPJournalEntry & entry(size_t idx) const { return entries[idx]; }
+    const char * value(unsigned int id) const { return (id == STRING_NONE) ? NULL : strings.str(id); }
+    const std::string & importKey(void) const { return key; }
+    void setImportKey(const std::string &newKey) { key = newKey; }
+    void clear(void);
+    bool isLast(MAPAddress ea, MAPJournalTarget target) const;
+    void add(MAPAddress ea, MAPJournalTarget target, unsigned char flags, const char * oldValue,
+        const char * newValue);
+    void finish(void);
+    void serialize(std::vector<unsigned char> &blob) const;
+    bool deserialize(const unsigned char * blob, size_t blobLen);
+    bool saveFile(const char * fileName) const;
+    bool loadFile(const char * fileName);
+
+private:
+    unsigned int internValue(const char * value);
+
+    std::vector<MAPJournalEntry> entries;
+    MAPStringPool strings;
+    std::string key;        ///< Identifies record of applied symbols which the import updated
+};
+
+};
+
+#endif
@@ -0,0 +1,295 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPLines.cpp
+///     Source line numbers table.
+/// @par Purpose:
+///     Compact storage of source line numbers of addresses, parsed from
+///     line number tables of MAP files.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPLines.h"
+#include  "MAPSerialize.h"
+
+#include  <algorithm>
+
+using namespace std;
+
+namespace MapFile {
+
+/// Entry waiting within the merge of runs.
+typedef struct {
+    MAPLineEntry entry;
+    size_t runNo;
+} MAPLineMergeItem;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Decodes one entry, as difference from the previous one.
+/// An entry is address difference, then line difference in zigzag form,
+/// shifted left with lowest bit set if the source file changes; the new
+/// file identifier plus one follows only then.
+/// @param p Position within encoded data; moved past the entry
+/// @param pEnd End of encoded data
+/// @param prev Previous entry; replaced by the decoded one
+/// @param fileCode Out variable receiving the file identifier plus one, or 0 if it did not change
+///     or the file is not known
+/// @return False if the data ends within the entry
+////////////////////////////////////////////////////////////////////////////////
+static inline bool decodeEntry(const unsigned char * &p, const unsigned char * pEnd, MapFile::MAPLineEntry &prev,
+    unsigned long long &eaDelta, unsigned long long &fileCode)
+{
+    unsigned long long lineCode;
+    if (!MapFile::getVarint(p, pEnd, eaDelta) || !MapFile::getVarint(p, pEnd, lineCode))
+        return false;
+    fileCode = 0;
+    if (((lineCode & 1) != 0) && !MapFile::getVarint(p, pEnd, fileCode))
+        return false;
+    if ((lineCode & 1) != 0)
+        prev.fileId = (unsigned int)(fileCode - 1);
+    unsigned long long zigzag = lineCode >> 1;
+    long long lineDelta = (long long)(zigzag >> 1) ^ -(long long)(zigzag & 1);
+    prev.ea += (MapFile::MAPAddress)eaDelta;
+    prev.line = (unsigned long)((long long)prev.line + lineDelta);
+    return true;
+}
+
+static inline void resetEntry(MapFile::MAPLineEntry &entry)
+{
+    entry.ea = 0;
+    entry.line = 0;
+    entry.fileId = MapFile::STRING_NONE;
+}
+
+/// Orders merged entries by address; equal addresses by run, so the merge is stable.
+static inline bool mergeItemAfter(const MapFile::MAPLineMergeItem &a, const MapFile::MAPLineMergeItem &b)
+{
+    if (a.entry.ea != b.entry.ea)
+        return (a.entry.ea > b.entry.ea);
+    return (a.runNo > b.runNo);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes all entries from the table.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPLineTable::clear(void)
+{
+    data.clear();
+    runs.clear();
+    numEntries = 0;
+    resetEntry(last);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Exchanges content of this table with another one, without copying.
+/// @param other The table to exchange content with
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPLineTable::swap(MapFile::MAPLineTable &other)
+{
+    data.swap(other.data);
+    runs.swap(other.runs);
+    std::swap(numEntries, other.numEntries);
+    std::swap(last, other.last);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds an entry at end of the table.
+/// @param entry The entry; address lower than of the previous entry starts new run
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPLineTable::append(const MapFile::MAPLineEntry &entry)
+{
+    if (runs.empty() || (entry.ea < last.ea))
+    {
+        MapFile::MAPLineRun newRun;
+        newRun.offset = data.size();
+        newRun.count = 0;
+        runs.push_back(newRun);
+        resetEntry(last);
+    }
+    bool newFile = (entry.fileId != last.fileId);
+    long long lineDelta = (long long)entry.line - (long long)last.line;
+    unsigned long long zigzag = ((unsigned long long)lineDelta << 1) ^ (unsigned long long)(lineDelta >> 63);
+    putVarint(data, (unsigned long long)(entry.ea - last.ea));
+    putVarint(data, (zigzag << 1) | (newFile ? 1 : 0));
+    if (newFile)
+        putVarint(data, (unsigned int)(entry.fileId + 1));
+    runs.back().count++;
+    numEntries++;
+    last = entry;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds all entries from another table at end of this table.
+/// @param other The source table
+/// @param fileIdMap Identifiers of source files within this table, indexed by
+///     identifiers within the other table; NULL if they are the same
+/// @param noFileId Source file given to entries which have none
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPLineTable::appendTable(const MapFile::MAPLineTable &other, const unsigned int * fileIdMap,
+    unsigned int noFileId)
+{
+    MapFile::MAPLineReader reader(other);
+    MapFile::MAPLineEntry entry;
+    while (reader.next(entry))
+    {
+        if (entry.fileId == MapFile::STRING_NONE)
+            entry.fileId = noFileId;
+        else if (fileIdMap != NULL)
+            entry.fileId = fileIdMap[entry.fileId];
+        append(entry);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Merges the runs, so that all entries are in order of addresses.
+/// Entries at the same address stay in order in which they were added.
+/// Takes linear time if there is one run only; tables parsed from MAP files
+/// usually have a few runs, as line tables are listed in order of linking.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPLineTable::sort(void)
+{
+    if (isSorted())
+        return;
+    std::vector<MapFile::MAPLineReader> readers;
+    std::vector<MapFile::MAPLineMergeItem> heap;
+    readers.reserve(runs.size());
+    heap.reserve(runs.size());
+    for (size_t runNo = 0; runNo < runs.size(); runNo++)
+    {
+        readers.push_back(MapFile::MAPLineReader(*this, runNo));
+        MapFile::MAPLineMergeItem item;
+        item.runNo = runNo;
+        if (readers[runNo].next(item.entry))
+            heap.push_back(item);
+    }
+    std::make_heap(heap.begin(), heap.end(), mergeItemAfter);
+    MapFile::MAPLineTable merged;
+    merged.data.reserve(data.size());
+    while (!heap.empty())
+    {
+        std::pop_heap(heap.begin(), heap.end(), mergeItemAfter);
+        MapFile::MAPLineMergeItem &item = heap.back();
+        merged.append(item.entry);
+        if (readers[item.runNo].next(item.entry))
+            std::push_heap(heap.begin(), heap.end(), mergeItemAfter);
+        else
+            heap.pop_back();
+    }
+    swap(merged);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Replaces content of the table with previously stored encoded entries.
+/// The data is verified, so that the table is safe to use.
+/// @param count Amount of entries, which must form one run
+/// @param encData The encoded entries
+/// @param encSize Size of the encoded entries
+/// @param numFiles Amount of strings in the owning table; source files must be within
+/// @return True if the data is valid; if not, the table is left empty
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPLineTable::assign(size_t count, const unsigned char * encData, size_t encSize, size_t numFiles)
+{
+    clear();
+    const unsigned char * p = encData;
+    const unsigned char * pEnd = encData + encSize;
+    MapFile::MAPLineEntry entry;
+    resetEntry(entry);
+    for (size_t i = 0; i < count; i++)
+    {
+        MapFile::MAPAddress prevEa = entry.ea;
+        unsigned long long eaDelta, fileCode;
+        if (!decodeEntry(p, pEnd, entry, eaDelta, fileCode))
+            return false;
+        if ((eaDelta > (unsigned long long)((MapFile::MAPAddress)-1 - prevEa)) || (fileCode > numFiles))
+            return false;
+    }
+    if (p != pEnd)
+        return false;
+    data.assign(encData, pEnd);
+    if (count > 0)
+    {
+        MapFile::MAPLineRun newRun;
+        newRun.offset = 0;
+        newRun.count = count;
+        runs.push_back(newRun);
+    }
+    numEntries = count;
+    last = entry;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Creates reader of all entries of the table, in order of storage.
+/// @param lineTable The table to read; must not be changed while reading
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+MapFile::MAPLineReader::MAPLineReader(const MapFile::MAPLineTable &lineTable)
+    : table(lineTable), endRun(lineTable.runCount())
+{
+    startRun(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Creates reader of entries of one run of the table.
+/// @param lineTable The table to read; must not be changed while reading
+/// @param runNo Index of the run
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+MapFile::MAPLineReader::MAPLineReader(const MapFile::MAPLineTable &lineTable, size_t runNo)
+    : table(lineTable), endRun(runNo + 1)
+{
+    startRun(runNo);
+}
+
+void MapFile::MAPLineReader::startRun(size_t runNo)
+{
+    curRun = runNo;
+    left = (curRun < endRun) ? table.run(curRun).count : 0;
+    pData = (curRun < endRun) ? (table.encoded() + table.run(curRun).offset) : NULL;
+    resetEntry(prev);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads next entry.
+/// @param entry Out variable to receive the entry
+/// @return False if there are no more entries
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPLineReader::next(MapFile::MAPLineEntry &entry)
+{
+    while (left == 0)
+    {
+        if (curRun + 1 >= endRun)
+            return false;
+        startRun(curRun + 1);
+    }
+    unsigned long long eaDelta, fileCode;
+    if (!decodeEntry(pData, table.encoded() + table.dataSize(), prev, eaDelta, fileCode))
+        return false;
+    left--;
+    entry = prev;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
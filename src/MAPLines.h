@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPLines.h
+///     Source line numbers table header.
+/// @par Purpose:
+///     Compact storage of source line numbers of addresses, parsed from
+///     line number tables of MAP files.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPLINES_H_
+#define MAPLINES_H_
+
+#include  <cstdio>
+#include  <vector>
+
+#include  "MAPReader.h"
+#include  "MAPStrings.h"
+
+namespace MapFile {
+
+/// Source line of one address.
+typedef struct {
+    MAPAddress ea;
+    unsigned long line;
+    unsigned int fileId;    ///< Source file within strings of the owning symbol table, STRING_NONE if not known
+} MAPLineEntry;
+
+/// Part of the encoded entries which is in order of addresses.
+typedef struct {
+    size_t offset;          ///< Start of the run within encoded data
+    size_t count;           ///< Amount of entries in the run
+} MAPLineRun;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Table of source line numbers, delta-encoded.
+/// Each entry is stored as variable-length differences from the previous
+/// one, so an entry usually takes 2-3 bytes. Entries are kept in runs of
+/// growing addresses; appending an address lower than the previous one
+/// starts a new run, and sort() merges the runs into one.
+////////////////////////////////////////////////////////////////////////////////
+class MAPLineTable {
+public:
+    MAPLineTable(void) { clear(); }
+    size_t size(void) const { return numEntries; }
+    bool empty(void) const { return (numEntries == 0); }
+    bool isSorted(void) const { return (runs.size() <= 1); }
+    size_t runCount(void) const { return runs.size(); }
+    const MAPLineRun & run(size_t runNo) const { return runs[runNo]; }
+    size_t dataSize(void) const { return data.size(); }
+    const unsigned char * encoded(void) const { return data.empty() ? NULL : &data[0]; }
+    void clear(void);
+    void swap(MAPLineTable &other);
+    void append(const MAPLineEntry &entry);
+    void appendTable(const MAPLineTable &other, const unsigned int * fileIdMap, unsigned int noFileId);
+    void sort(void);
+    bool assign(size_t count, const unsigned char * encData, size_t encSize, size_t numFiles);
+
+private:
+    std::vector<unsigned char> data;
+    std::vector<MAPLineRun> runs;
+    size_t numEntries;
+    MAPLineEntry last;      ///< Last appended entry, which the next one is encoded against
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Sequential reader of line table entries.
+/// Reads all entries in order of storage, or the entries of one run.
+////////////////////////////////////////////////////////////////////////////////
+class MAPLineReader {
+public:
+    explicit MAPLineReader(const MAPLineTable &lineTable);
+    MAPLineReader(const MAPLineTable &lineTable, size_t runNo);
+    bool next(MAPLineEntry &entry);
+
+private:
+    void startRun(size_t runNo);
+
+    const MAPLineTable &table;
+    size_t curRun;
+    size_t endRun;
+    size_t left;            ///< Entries left within the current run
+    const unsigned char * pData;
+    MAPLineEntry prev;
+};
+
+size_t parseLineNumbers(const char *pLine, size_t lineLen, MAPSegmentCursor &segs, unsigned int fileId,
+    MAPLineTable &lines);
+
+};
+
+#endif
@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPLogger.cpp
+///     Buffered diagnostic messages.
+/// @par Purpose:
+///     Leveled logging, formatted into a memory buffer and flushed to the
+///     output in large blocks, with optional copy into a log file.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPLogger.h"
+
+#include  <cstring>
+#include  <cstdarg>
+#include  <vector>
+
+using namespace std;
+
+/// Default output, used when no sink was set.
+static void stdoutLogSink(const char * text)
+{
+    fputs(text, stdout);
+}
+
+MapFile::MAPLogger::MAPLogger(void)
+    : used(0), maxLevel(MapFile::LOGLVL_INFO), outSink(stdoutLogSink), mirror(NULL)
+{
+    buf[0] = '\0';
+}
+
+MapFile::MAPLogger::~MAPLogger(void)
+{
+    closeMirror();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Starts copying all messages to a file.
+/// @param fileName Name of the log file; it is overwritten
+/// @return True if the file was created
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPLogger::openMirror(const char * fileName)
+{
+    closeMirror();
+    mirror = fopen(fileName, "w");
+    return (mirror != NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Flushes the messages and stops copying them to a file.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPLogger::closeMirror(void)
+{
+    flush();
+    if (mirror != NULL)
+        fclose(mirror);
+    mirror = NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Passes all collected messages to the output.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPLogger::flush(void)
+{
+    if (used == 0)
+        return;
+    buf[used] = '\0';
+    if (outSink != NULL)
+        outSink(buf);
+    if (mirror != NULL)
+        fwrite(buf, 1, used, mirror);
+    used = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds text to the messages, if given level is enabled.
+/// @param level Level of the message
+/// @param text The text; does not have to be NUL-terminated
+/// @param len Length of the text
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPLogger::write(MapFile::LogLevel level, const char * text, size_t len)
+{
+    if (!enabled(level))
+        return;
+    while (len > 0)
+    {
+        if (used == LOG_BUFFER_SIZE)
+            flush();
+        size_t part = LOG_BUFFER_SIZE - used;
+        if (part > len)
+            part = len;
+        memcpy(buf + used, text, part);
+        used += part;
+        text += part;
+        len -= part;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds formatted message, if given level is enabled.
+/// The message is formatted directly into the buffer.
+/// @param level Level of the message
+/// @param format printf() style message string
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPLogger::print(MapFile::LogLevel level, const char * format, ...)
+{
+    if (!enabled(level))
+        return;
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        va_list va;
+        va_start(va, format);
+        int len = vsnprintf(buf + used, LOG_BUFFER_SIZE + 1 - used, format, va);
+        va_end(va);
+        if (len < 0)
+            return;
+        if ((size_t)len <= LOG_BUFFER_SIZE - used)
+        {
+            used += (size_t)len;
+            return;
+        }
+        // Did not fit; drop the partial message and retry with empty buffer
+        buf[used] = '\0';
+        if (used == 0)
+            break;
+        flush();
+    }
+    // Message larger than the whole buffer
+    va_list va;
+    va_start(va, format);
+    int len = vsnprintf(NULL, 0, format, va);
+    va_end(va);
+    if (len <= 0)
+        return;
+    std::vector<char> longMsg((size_t)len + 1);
+    va_start(va, format);
+    vsnprintf(&longMsg[0], longMsg.size(), format, va);
+    va_end(va);
+    write(level, &longMsg[0], (size_t)len);
+}
+
+////////////////////////////////////////////////////////////////////////////////
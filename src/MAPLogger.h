@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPLogger.h
+///     Buffered diagnostic messages header.
+/// @par Purpose:
+///     Leveled logging, formatted into a memory buffer and flushed to the
+///     output in large blocks, with optional copy into a log file.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPLOGGER_H_
+#define MAPLOGGER_H_
+
+#include  <cstdio>
+
+namespace MapFile {
+
+typedef enum {
+    LOGLVL_ERROR = 0,
+    LOGLVL_INFO,
+    LOGLVL_VERBOSE,
+} LogLevel;
+
+/// Size of the buffer which collects messages before they are flushed.
+const size_t LOG_BUFFER_SIZE = 64 * 1024;
+
+/// Receives a block of messages; the text is NUL-terminated.
+typedef void (*MAPLogSink)(const char * text);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Collects messages and passes them to the output in large blocks.
+/// Not thread safe; parsing threads collect their messages separately.
+////////////////////////////////////////////////////////////////////////////////
+class MAPLogger {
+public:
+    MAPLogger(void);
+    ~MAPLogger(void);
+    void setLevel(LogLevel level) { maxLevel = level; }
+    bool enabled(LogLevel level) const { return (level <= maxLevel); }
+    void setSink(MAPLogSink sink) { outSink = sink; }
+    bool openMirror(const char * fileName);
+    void closeMirror(void);
+    void print(LogLevel level, const char * format, ...);
+    void write(LogLevel level, const char * text, size_t len);
+    void flush(void);
+
+private:
+    MAPLogger(const MAPLogger &);
+    MAPLogger & operator=(const MAPLogger &);
+
+    char buf[LOG_BUFFER_SIZE + 1];
+    size_t used;
+    LogLevel maxLevel;
+    MAPLogSink outSink;
+    FILE * mirror;
+};
+
+};
+
+/// Most detailed level which is compiled in; messages above it cost nothing.
+#ifndef MAPLOG_MAX_LEVEL
+#define MAPLOG_MAX_LEVEL MapFile::LOGLVL_VERBOSE
+#endif
+
+#if defined(__GNUC__)
+#define MAPLOG_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define MAPLOG_UNLIKELY(x) (x)
+#endif
+
+/// Logs a message; arguments are not evaluated if the level is disabled.
+#define MAPLOG(logger, level, ...) \
+    do { \
+        if (((level) <= MAPLOG_MAX_LEVEL) && MAPLOG_UNLIKELY((logger).enabled(level))) \
+            (logger).print((level), __VA_ARGS__); \
+    } while (0)
+
+#endif
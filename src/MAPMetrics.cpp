@@ -0,0 +1,320 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPMetrics.cpp
+///     Import timing and counters.
+/// @par Purpose:
+///     Measures time of each phase of the import, and counts the work done,
+///     so that performance of imports can be compared between versions.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPMetrics.h"
+
+#include  <cmath>
+#include  <cstring>
+#include  <ctime>
+#include  <string>
+#include  <thread>
+
+#include "stdafx.h"
+
+#if defined(_WIN32)
+#include  <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include  <sys/resource.h>
+#endif
+
+using namespace std;
+
+namespace MapFile {
+
+/// Names of the phases, as shown and as keys in JSON.
+static const char * const PHASE_NAMES[PHASE_COUNT] = {
+    "open", "cache", "parse", "prepare", "demangle", "delta", "apply", "lines", "history",
+    "analysis",
+};
+
+/// Names of the counters, as keys in JSON.
+static const char * const METRIC_NAMES[METRIC_COUNT] = {
+    "files", "fileBytes", "cacheHits", "symbols", "namesSet", "namesFailed",
+    "commentsSet", "commentsFailed", "removed", "lineNumbers", "sourceRanges",
+    "reanalysisItems", "reanalysisRanges",
+};
+
+/// Names of parsing results of lines, as keys in JSON.
+static const char * const PARSE_RESULT_NAMES[PARSE_RESULT_COUNT] = {
+    "skip", "invalid", "finishing", "comment", "symbol", "module", "source", "lineNumbers", "filtered",
+};
+
+const double BYTES_PER_MB = 1024.0 * 1024.0;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Creates metrics with all values zeroed.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+MapFile::MAPMetrics::MAPMetrics()
+{
+    clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Zeroes all values, to start measuring next import.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPMetrics::clear(void)
+{
+    running = false;
+    curPhase = PHASE_OPEN;
+    for (unsigned int i = 0; i < PHASE_COUNT; i++)
+        seconds[i] = 0.0;
+    for (unsigned int i = 0; i < METRIC_COUNT; i++)
+        counters[i] = 0;
+    MapFile::clearParseStats(parsed);
+    threads = 0;
+    peakMem = 0;
+    savingKnown = false;
+    savedSecs = 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Ends the current phase, if any, and starts measuring time of next one.
+/// A phase may be started many times; its time is summed.
+/// @param phase The phase to start
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPMetrics::startPhase(MapFile::MAPPhase phase)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (running)
+        seconds[curPhase] += std::chrono::duration<double>(now - phaseStart).count();
+    running = true;
+    curPhase = phase;
+    phaseStart = now;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Ends the current phase, and takes peak memory usage of the process.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPMetrics::stopPhase(void)
+{
+    if (running)
+        seconds[curPhase] += std::chrono::duration<double>(std::chrono::steady_clock::now() - phaseStart).count();
+    running = false;
+    peakMem = MapFile::getPeakMemoryUsage();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets amount of parsing threads, to be reported with the metrics.
+/// @param numThreads Amount of threads, 0 for one per CPU core
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPMetrics::setThreads(unsigned int numThreads)
+{
+    if (numThreads == 0)
+        numThreads = std::thread::hardware_concurrency();
+    threads = (numThreads > 0) ? numThreads : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets time saved by applying with auto-analysis suspended.
+/// The time is estimated from applying and waiting for the analysis to finish,
+/// compared with an earlier import with analysis running.
+/// @param savedSeconds The saved time; negative if applying took longer
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPMetrics::setAnalysisSaving(double savedSeconds)
+{
+    savingKnown = true;
+    savedSecs = savedSeconds;
+}
+
+double MapFile::MAPMetrics::totalSeconds(void) const
+{
+    double total = 0.0;
+    for (unsigned int i = 0; i < PHASE_COUNT; i++)
+        total += seconds[i];
+    return total;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes a summary of the metrics into the log.
+/// @param log Target log
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPMetrics::print(MapFile::MAPLogger &log) const
+{
+    log.print(LOGLVL_INFO, "Import took %.3f s, peak memory %.1f MB, %u parsing threads\n",
+        totalSeconds(), peakMem / BYTES_PER_MB, threads);
+    std::string text("   Phases:");
+    char item[64];
+    for (unsigned int i = 0; i < PHASE_COUNT; i++)
+    {
+        snprintf(item, sizeof(item), "%s %s %.3f s", (i > 0) ? "," : "", PHASE_NAMES[i], seconds[i]);
+        text.append(item);
+    }
+    log.print(LOGLVL_INFO, "%s\n", text.c_str());
+    if (parsed.lines > 0)
+    {
+        double parseTime = seconds[PHASE_PARSE];
+        log.print(LOGLVL_INFO, "   Parsed %.1f MB in %llu lines, %.1f MB/s; splitting lines %.3f s,"
+            " parsing lines %.3f s, summed over threads\n", parsed.bytes / BYTES_PER_MB, parsed.lines,
+            (parseTime > 0.0) ? (parsed.bytes / BYTES_PER_MB / parseTime) : 0.0,
+            parsed.scanSeconds, parsed.parseSeconds);
+        text.assign("   Lines by result:");
+        for (unsigned int i = 0; i < PARSE_RESULT_COUNT; i++)
+        {
+            snprintf(item, sizeof(item), "%s %s %lu", (i > 0) ? "," : "", PARSE_RESULT_NAMES[i], parsed.lineResults[i]);
+            text.append(item);
+        }
+        log.print(LOGLVL_INFO, "%s\n", text.c_str());
+        text.assign("   Lines by section:");
+        for (unsigned int i = 0; i < SECTION_TYPE_COUNT; i++)
+        {
+            snprintf(item, sizeof(item), "%s %s %lu", (i > 0) ? "," : "",
+                getSectionFormat((SectionType)i)->name, parsed.sectionLines[i]);
+            text.append(item);
+        }
+        log.print(LOGLVL_INFO, "%s\n", text.c_str());
+    }
+    log.print(LOGLVL_INFO, "   Names set %llu, failed %llu; comments set %llu, failed %llu; removed %llu\n",
+        counters[METRIC_NAMES_SET], counters[METRIC_NAMES_FAILED], counters[METRIC_COMMENTS_SET],
+        counters[METRIC_COMMENTS_FAILED], counters[METRIC_REMOVED]);
+    if (counters[METRIC_LINE_NUMBERS] > 0)
+    {
+        log.print(LOGLVL_INFO, "   Line numbers set %llu, within %llu source file ranges\n",
+            counters[METRIC_LINE_NUMBERS], counters[METRIC_SOURCE_RANGES]);
+    }
+    if (counters[METRIC_REANALYSIS_ITEMS] > 0)
+    {
+        log.print(LOGLVL_INFO, "   Auto-analysis suspended; %llu changed items queued for reanalysis as %llu ranges\n",
+            counters[METRIC_REANALYSIS_ITEMS], counters[METRIC_REANALYSIS_RANGES]);
+    }
+    if (savingKnown)
+    {
+        log.print(LOGLVL_INFO, "   Applying and analysis took about %.3f s %s than with auto-analysis running,"
+            " estimated from previous import\n", fabs(savedSecs), (savedSecs >= 0.0) ? "less" : "more");
+    }
+    else if (counters[METRIC_REANALYSIS_ITEMS] > 0)
+    {
+        log.print(LOGLVL_INFO, "   Time saved by suspending auto-analysis is unknown\n");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Appends the metrics to a JSON Lines file, as one object in one line.
+/// Records of many imports are kept in the file, to compare them.
+/// @param fileName Name of the file
+/// @param version Version of the plugin
+/// @return True if the record was written
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPMetrics::appendJson(const char * fileName, const char * version) const
+{
+    FILE * fp = fopen(fileName, "a");
+    if (fp == NULL)
+        return false;
+    char date[32] = "";
+    time_t now = time(NULL);
+    const struct tm * utc = gmtime(&now);
+    if (utc != NULL)
+        strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", utc);
+    fprintf(fp, "{\"version\":\"%s\",\"date\":\"%s\",\"addressBits\":%u,\"threads\":%u,"
+        "\"seconds\":%.6f,\"peakMemory\":%llu", version, date, (unsigned int)(sizeof(MAPAddress) * 8),
+        threads, totalSeconds(), peakMem);
+    fprintf(fp, ",\"phases\":{");
+    for (unsigned int i = 0; i < PHASE_COUNT; i++)
+        fprintf(fp, "%s\"%s\":%.6f", (i > 0) ? "," : "", PHASE_NAMES[i], seconds[i]);
+    fprintf(fp, "},\"counters\":{");
+    for (unsigned int i = 0; i < METRIC_COUNT; i++)
+        fprintf(fp, "%s\"%s\":%llu", (i > 0) ? "," : "", METRIC_NAMES[i], counters[i]);
+    fprintf(fp, "}");
+    if (savingKnown)
+        fprintf(fp, ",\"analysisSavedSeconds\":%.6f", savedSecs);
+    else if (counters[METRIC_REANALYSIS_ITEMS] > 0)
+        fprintf(fp, ",\"analysisSavedSeconds\":null");
+    fprintf(fp, ",\"parse\":{\"bytes\":%llu,\"lines\":%llu,\"sectionsFound\":%lu,\"invalidLines\":%lu,"
+        "\"scanSeconds\":%.6f,\"parseSeconds\":%.6f,\"lineResults\":{", parsed.bytes, parsed.lines,
+        parsed.sectionsFound, parsed.invalidLines, parsed.scanSeconds, parsed.parseSeconds);
+    for (unsigned int i = 0; i < PARSE_RESULT_COUNT; i++)
+        fprintf(fp, "%s\"%s\":%lu", (i > 0) ? "," : "", PARSE_RESULT_NAMES[i], parsed.lineResults[i]);
+    fprintf(fp, "},\"sectionLines\":{");
+    for (unsigned int i = 0; i < SECTION_TYPE_COUNT; i++)
+        fprintf(fp, "%s\"%s\":%lu", (i > 0) ? "," : "", getSectionFormat((SectionType)i)->name, parsed.sectionLines[i]);
+    fprintf(fp, "}}}\n");
+    bool ok = !ferror(fp);
+    if (fclose(fp) != 0)
+        ok = false;
+    return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives name of an import phase.
+/// @param phase The phase
+/// @return Short name of the phase
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+const char * MapFile::getPhaseName(MapFile::MAPPhase phase)
+{
+    if ((unsigned int)phase >= PHASE_COUNT)
+        return "unknown";
+    return PHASE_NAMES[phase];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives name of an import counter.
+/// @param metric The counter
+/// @return Short name of the counter
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+const char * MapFile::getMetricName(MapFile::MAPMetric metric)
+{
+    if ((unsigned int)metric >= METRIC_COUNT)
+        return "unknown";
+    return METRIC_NAMES[metric];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives peak resident memory of the process, since it was started.
+/// @return Amount of bytes, or 0 if it cannot be checked
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+unsigned long long MapFile::getPeakMemoryUsage(void)
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return (unsigned long long)counters.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(__APPLE__)
+    return (unsigned long long)usage.ru_maxrss;
+#else
+    return (unsigned long long)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPMetrics.h
+///     Import timing and counters header.
+/// @par Purpose:
+///     Measures time of each phase of the import, and counts the work done,
+///     so that performance of imports can be compared between versions.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPMETRICS_H_
+#define MAPMETRICS_H_
+
+#include  <cstdio>
+#include  <chrono>
+
+#include  "MAPParser.h"
+#include  "MAPLogger.h"
+
+namespace MapFile {
+
+/// Phases of the import; all time of the import is counted in one of them.
+typedef enum {
+    PHASE_OPEN = 0,     ///< Opening and mapping of the files
+    PHASE_CACHE,        ///< Loading and saving index cache
+    PHASE_PARSE,        ///< Parsing, and reading of the streamed files
+    PHASE_PREPARE,      ///< Joining the files, sorting symbols and resolving address conflicts
+    PHASE_DEMANGLE,     ///< Demangling names
+    PHASE_DELTA,        ///< Comparing with previous import, removing symbols which are gone
+    PHASE_APPLY,        ///< Setting names and comments in the database
+    PHASE_LINES,        ///< Setting source line numbers in the database
+    PHASE_HISTORY,      ///< Storing record of applied symbols
+    PHASE_ANALYSIS,     ///< Waiting for auto-analysis of the changes
+    PHASE_COUNT
+} MAPPhase;
+
+/// Counters of the work done during import.
+typedef enum {
+    METRIC_FILES = 0,       ///< MAP files given for import
+    METRIC_FILE_BYTES,      ///< Size of the opened MAP files
+    METRIC_CACHE_HITS,      ///< Files loaded from index cache instead of parsing
+    METRIC_SYMBOLS,         ///< Symbols taken from all the files
+    METRIC_NAMES_SET,       ///< Names set successfully
+    METRIC_NAMES_FAILED,    ///< Names which could not be set
+    METRIC_COMMENTS_SET,    ///< Comments set successfully, including demangled names
+    METRIC_COMMENTS_FAILED, ///< Comments which could not be set
+    METRIC_REMOVED,         ///< Names and comments of previous import removed
+    METRIC_LINE_NUMBERS,    ///< Addresses which got source line number
+    METRIC_SOURCE_RANGES,   ///< Address ranges which got source file
+    METRIC_REANALYSIS_ITEMS,    ///< Changed items left for auto-analysis until the symbols are applied
+    METRIC_REANALYSIS_RANGES,   ///< Address ranges the changed items were queued for reanalysis in
+    METRIC_COUNT
+} MAPMetric;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Timing and counters of one import.
+/// Phases do not nest; starting a phase ends the previous one, so the time
+/// of all phases adds up to the time of the import.
+////////////////////////////////////////////////////////////////////////////////
+class MAPMetrics {
+public:
+    MAPMetrics();
+    void clear(void);
+    void startPhase(MAPPhase phase);
+    void stopPhase(void);
+    void add(MAPMetric metric, unsigned long long amount) { counters[metric] += amount; }
+    void addParseStats(const MAPParseStats &stats) { MapFile::addParseStats(parsed, stats); }
+    void setThreads(unsigned int numThreads);
+    void setAnalysisSaving(double savedSeconds);
+
+    double phaseSeconds(MAPPhase phase) const { return seconds[phase]; }
+    double totalSeconds(void) const;
+    unsigned long long counter(MAPMetric metric) const { return counters[metric]; }
+    const MAPParseStats & parseStats(void) const { return parsed; }
+    unsigned long long peakMemory(void) const { return peakMem; }
+    bool hasAnalysisSaving(void) const { return savingKnown; }
+    double analysisSaving(void) const { return savedSecs; }
+
+    void print(MAPLogger &log) const;
+    bool appendJson(const char * fileName, const char * version) const;
+
+private:
+    MAPMetrics(const MAPMetrics &);
+    MAPMetrics & operator=(const MAPMetrics &);
+
+    bool running;
+    MAPPhase curPhase;
+    std::chrono::steady_clock::time_point phaseStart;
+    double seconds[PHASE_COUNT];
+    unsigned long long counters[METRIC_COUNT];
+    MAPParseStats parsed;
+    unsigned int threads;
+    unsigned long long peakMem;     ///< Peak resident memory of the process, 0 if not known
+    bool savingKnown;
+    double savedSecs;               ///< Apply time saved by suspending auto-analysis, estimated
+};
+
+const char * getPhaseName(MAPPhase phase);
+const char * getMetricName(MAPMetric metric);
+unsigned long long getPeakMemoryUsage(void);
+
+};
+
+#endif
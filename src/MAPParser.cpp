@@ -0,0 +1,890 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPParser.cpp
+///     MAP file parsing state machine.
+/// @par Purpose:
+///     Parses MAP file buffer into list of symbols. The buffer is split into
+///     chunks at line boundaries, and the chunks are parsed in parallel.
+///     Section state at start of each chunk is guessed by a quick pre-scan
+///     for section markers; if the guess turns out wrong, the chunk is
+///     parsed again, so the result is always the same as sequential parse.
+///     Chunks of several MAP files can share one pool of threads.
+///     Streamed input is parsed sequentially, block by block.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPParser.h"
+#include  "MAPScanner.h"
+#include  "MAPLogger.h"
+
+#include  <cstring>
+#include  <cstdarg>
+#include  <cassert>
+#include  <thread>
+#include  <chrono>
+#include  <atomic>
+#include  <exception>
+#include  <functional>
+
+#include "stdafx.h"
+
+using namespace std;
+
+namespace MapFile {
+
+/// Amount of lines split from the MAP file at once
+const size_t LINE_INDEX_BLOCK = 4096;
+/// Smallest part of the file worth giving to separate thread
+const size_t MIN_CHUNK_SIZE = 4 * 1024 * 1024;
+/// Amount of chunks per thread; more chunks balance the load better
+const size_t CHUNKS_PER_THREAD = 4;
+/// Amount of parsed MAP file data after which its pages are released
+const size_t MAP_RELEASE_GRANULARITY = 16 * 1024 * 1024;
+/// Amount of MAP file data which is expected to contain at least one distinct
+/// string; used to size the string index of a chunk before it is parsed
+const size_t CHUNK_BYTES_PER_STRING = 256;
+
+/// Part of MAP file which is parsed as a unit, possibly in parallel to other parts.
+typedef struct {
+    const char * start;
+    const char * end;
+    const char * mapBase;       ///< Start of the file mapping, to release parsed pages; NULL to keep them
+    size_t fileNo;              ///< Index of the MAP file which the chunk is part of
+    SectionType startSection;   ///< Section state at start of the chunk
+    SectionType endSection;     ///< Section state after the chunk was parsed
+    MAPParseStats stats;
+    MAPSymbolTable symbols;
+    size_t leadingSymbols;      ///< Symbols before the first module line, which belong to module of previous chunk
+    unsigned int lastModule;    ///< Module of the last module line within symbols strings, STRING_NONE if none
+    unsigned int lastSource;    ///< Source file of the last line numbers header within symbols strings, STRING_NONE if none
+    std::string log;            ///< Verbose messages about the parsed lines
+} MAPChunk;
+
+/// Parsed symbols waiting for their names and object files to be interned together.
+typedef struct {
+    size_t count;
+    unsigned long segs[STRING_BATCH_SIZE];
+    MAPAddress addrs[STRING_BATCH_SIZE];
+    MAPAddress eas[STRING_BATCH_SIZE];
+    SymbolKind kinds[STRING_BATCH_SIZE];
+    const char * names[STRING_BATCH_SIZE];
+    size_t nameLens[STRING_BATCH_SIZE];
+    const char * objects[STRING_BATCH_SIZE];
+    size_t objectLens[STRING_BATCH_SIZE];   ///< Length of object file, 0 if objIds is already known
+    unsigned int objIds[STRING_BATCH_SIZE];
+} MAPPendingSymbols;
+
+/// Decisions of the import filter kept while parsing a chunk, so that a run
+/// of symbols from one object file is checked once.
+typedef struct {
+    const MAPFilter * filter;
+    bool moduleAccepted;        ///< Decision for the last module line
+    std::string lastObject;
+    bool lastObjectAccepted;    ///< Decision for lastObject
+} MAPFilterState;
+
+};
+
+/// Appends printf-like formatted message to the log buffer.
+static void appendLog(std::string &log, const char *format, ...)
+{
+    char buf[MAXNAMELEN + 80];
+    va_list va;
+    va_start(va, format);
+    int len = vsnprintf(buf, sizeof(buf), format, va);
+    va_end(va);
+    if (len < 0)
+        return;
+    log.append(buf, ((size_t)len < sizeof(buf)) ? (size_t)len : (sizeof(buf) - 1));
+}
+
+/// Adds verbose message to the chunk log; removed at compile time if
+/// MAPLOG_MAX_LEVEL excludes verbose messages.
+#define CHUNK_LOG_VERBOSE(chunk, opts, ...) \
+    do { \
+        if ((MapFile::LOGLVL_VERBOSE <= MAPLOG_MAX_LEVEL) && MAPLOG_UNLIKELY((opts).verbose)) \
+            appendLog((chunk).log, __VA_ARGS__); \
+    } while (0)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Runs given job on all items, using a pool of threads.
+/// Exception thrown within a job is passed to the caller.
+/// @param numThreads Amount of threads to use, including the calling one
+/// @param numJobs Amount of jobs to execute
+/// @param job Function which executes a job of given index
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::runInParallel(unsigned int numThreads, size_t numJobs, const std::function<void(size_t)> &job)
+{
+    std::atomic<size_t> nextJob(0);
+    std::vector<std::exception_ptr> errors(numThreads);
+    auto worker = [&](unsigned int workerNo)
+    {
+        try
+        {
+            for (size_t jobNo = nextJob++; jobNo < numJobs; jobNo = nextJob++)
+                job(jobNo);
+        }
+        catch (...)
+        {
+            errors[workerNo] = std::current_exception();
+            // Make other workers finish early
+            nextJob = numJobs;
+        }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < numThreads; i++)
+        threads.push_back(std::thread(worker, i));
+    worker(0);
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+    for (size_t i = 0; i < errors.size(); i++)
+    {
+        if (errors[i])
+            std::rethrow_exception(errors[i]);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds pending symbols to the table, interning their strings in batches.
+/// Strings point into the MAP file, so this must be done before its pages are released.
+/// @param symbols Target symbol table
+/// @param pending The pending symbols; emptied
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void flushPendingSymbols(MapFile::MAPSymbolTable &symbols, MapFile::MAPPendingSymbols &pending)
+{
+    unsigned int nameIds[MapFile::STRING_BATCH_SIZE];
+    symbols.internMany(pending.count, pending.names, pending.nameLens, nameIds);
+
+    // Symbols of one object file are usually listed one after another,
+    // so each run of lines with the same object file is looked up once
+    const char * runObjects[MapFile::STRING_BATCH_SIZE];
+    size_t runLens[MapFile::STRING_BATCH_SIZE];
+    unsigned int runIds[MapFile::STRING_BATCH_SIZE];
+    size_t symbolRuns[MapFile::STRING_BATCH_SIZE];
+    size_t numRuns = 0;
+    for (size_t i = 0; i < pending.count; i++)
+    {
+        size_t len = pending.objectLens[i];
+        if (len == 0)
+            continue;
+        if ((numRuns == 0) || (runLens[numRuns - 1] != len) ||
+            (memcmp(runObjects[numRuns - 1], pending.objects[i], len) != 0))
+        {
+            runObjects[numRuns] = pending.objects[i];
+            runLens[numRuns] = len;
+            numRuns++;
+        }
+        symbolRuns[i] = numRuns - 1;
+    }
+    symbols.internMany(numRuns, runObjects, runLens, runIds);
+    for (size_t i = 0; i < pending.count; i++)
+    {
+        if (pending.objectLens[i] > 0)
+            pending.objIds[i] = runIds[symbolRuns[i]];
+    }
+
+    for (size_t i = 0; i < pending.count; i++)
+    {
+        symbols.appendInterned(pending.segs[i], pending.addrs[i], pending.eas[i], pending.kinds[i],
+            nameIds[i], pending.objIds[i]);
+    }
+    pending.count = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes DeDe symbol marker from start of a name.
+/// @param pname The name; moved past the marker
+/// @param nameLen Length of the name; reduced by length of the marker
+/// @return How the symbol should be applied, as given by the marker
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static MapFile::SymbolKind splitDeDeMarker(const char * &pname, size_t &nameLen)
+{
+    // Determine the DeDe map file
+    if ((nameLen >= 2) && ('<' == pname[0]) && ('-' == pname[1]))
+    {
+        // Functions indicator symbol of DeDe map
+        pname += 2;
+        nameLen -= 2;
+        return MapFile::SYMKIND_NAME;
+    }
+    else if ((nameLen >= 1) && ('*' == pname[0]))
+    {
+        // VCL controls indicator symbol of DeDe map
+        pname++;
+        nameLen--;
+        return MapFile::SYMKIND_COMMENT;
+    }
+    else if ((nameLen >= 2) && ('-' == pname[0]) && ('>' == pname[1]))
+    {
+        // VCL methods indicator symbol of DeDe map
+        pname += 2;
+        nameLen -= 2;
+        return MapFile::SYMKIND_COMMENT;
+    }
+    return MapFile::SYMKIND_DEFAULT;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds parsed symbol to the table, recognizing DeDe symbol markers.
+/// The symbol is queued, and added with next flushPendingSymbols().
+/// @param symbols Target symbol table
+/// @param pending Symbols waiting for their strings to be interned
+/// @param sym The symbol to add
+/// @param moduleId Current module within symbols strings, used if the line has no object file
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void addParsedSymbol(MapFile::MAPSymbolTable &symbols, MapFile::MAPPendingSymbols &pending,
+    const MapFile::MAPSymbolView &sym, unsigned int moduleId)
+{
+    const char * pname = sym.name;
+    size_t nameLen = sym.nameLen;
+    MapFile::SymbolKind kind = splitDeDeMarker(pname, nameLen);
+    size_t i = pending.count++;
+    pending.segs[i] = sym.seg;
+    pending.addrs[i] = sym.addr;
+    pending.eas[i] = sym.ea;
+    pending.kinds[i] = kind;
+    pending.names[i] = pname;
+    pending.nameLens[i] = nameLen;
+    pending.objects[i] = sym.object;
+    pending.objectLens[i] = sym.objectLen;
+    pending.objIds[i] = moduleId;
+    if (pending.count == MapFile::STRING_BATCH_SIZE)
+        flushPendingSymbols(symbols, pending);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks parsed symbol against the import filter.
+/// Address was already checked while the line was parsed. Symbols before
+/// the first module line of a chunk, which have no object file, are kept;
+/// they are checked by filterLeadingSymbols() when their module is known.
+/// @param state Filter and its decisions for current module and object file
+/// @param sym The parsed symbol
+/// @param lastModule Current module, STRING_NONE if not known yet
+/// @return True if the symbol is rejected
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool isSymbolFiltered(MapFile::MAPFilterState &state, const MapFile::MAPSymbolView &sym, unsigned int lastModule)
+{
+    const MapFile::MAPFilter * filter = state.filter;
+    if (filter->hasObjects())
+    {
+        if (sym.objectLen > 0)
+        {
+            if ((sym.objectLen != state.lastObject.size()) ||
+                (memcmp(sym.object, state.lastObject.data(), sym.objectLen) != 0))
+            {
+                state.lastObject.assign(sym.object, sym.objectLen);
+                state.lastObjectAccepted = filter->acceptsObject(sym.object, sym.objectLen);
+            }
+            if (!state.lastObjectAccepted)
+                return true;
+        }
+        else if ((lastModule != MapFile::STRING_NONE) && !state.moduleAccepted)
+        {
+            return true;
+        }
+    }
+    if (filter->hasNames())
+    {
+        const char * pname = sym.name;
+        size_t nameLen = sym.nameLen;
+        splitDeDeMarker(pname, nameLen);
+        if (!filter->acceptsName(pname, nameLen))
+            return true;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes symbols at start of a chunk which belong to rejected module.
+/// Only symbols without object file are removed; others were checked
+/// while parsing.
+/// @param symbols Target symbol table, with the chunk already added
+/// @param baseIdx Index of the first symbol of the chunk
+/// @param numLeading Amount of symbols before the first module line of the chunk
+/// @param moduleId Module current at end of the previous chunk, within target table strings
+/// @param filter The import filter, NULL if there is none
+/// @param stats Parsing summary, updated with the removed symbols
+/// @return Amount of removed symbols
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static size_t filterLeadingSymbols(MapFile::MAPSymbolTable &symbols, size_t baseIdx, size_t numLeading,
+    unsigned int moduleId, const MapFile::MAPFilter * filter, MapFile::MAPParseStats &stats)
+{
+    if ((filter == NULL) || !filter->hasObjects() || (numLeading == 0))
+        return 0;
+    // Symbols before the first module line of a file are checked as having empty object
+    const char * module = (moduleId != MapFile::STRING_NONE) ? symbols.strings().str(moduleId) : "";
+    size_t moduleLen = (moduleId != MapFile::STRING_NONE) ? symbols.strings().len(moduleId) : 0;
+    if (filter->acceptsObject(module, moduleLen))
+        return 0;
+    size_t numRemoved = symbols.removeWithoutObject(baseIdx, numLeading);
+    stats.lineResults[MapFile::SYMBOL_LINE] -= (unsigned long)numRemoved;
+    stats.lineResults[MapFile::FILTERED_LINE] += (unsigned long)numRemoved;
+    return numRemoved;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds symbols of parsed chunk at end of the table.
+/// Symbols at start of the chunk get the module which was current at end
+/// of the previous chunk, as module lines are not repeated in each chunk;
+/// the same goes for source file of line numbers.
+/// @param symbols Target symbol table
+/// @param chunk The parsed chunk
+/// @param moduleId Current module within target table strings; updated
+/// @param sourceId Current source file within target table strings; updated
+/// @param filter The import filter, NULL if there is none
+/// @param stats Parsing summary, updated with symbols rejected by module
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void appendChunkSymbols(MapFile::MAPSymbolTable &symbols, const MapFile::MAPChunk &chunk, unsigned int &moduleId,
+    unsigned int &sourceId, const MapFile::MAPFilter * filter, MapFile::MAPParseStats &stats)
+{
+    size_t baseIdx = symbols.size();
+    symbols.appendTable(chunk.symbols, sourceId);
+    size_t numLeading = chunk.leadingSymbols -
+        filterLeadingSymbols(symbols, baseIdx, chunk.leadingSymbols, moduleId, filter, stats);
+    if (moduleId != MapFile::STRING_NONE)
+    {
+        for (size_t i = baseIdx; i < baseIdx + numLeading; i++)
+        {
+            if (symbols.objectId(i) == MapFile::STRING_NONE)
+                symbols.setObjectId(i, moduleId);
+        }
+    }
+    if (chunk.lastModule != MapFile::STRING_NONE)
+        moduleId = symbols.intern(chunk.symbols.strings().str(chunk.lastModule),
+            chunk.symbols.strings().len(chunk.lastModule));
+    if (chunk.lastSource != MapFile::STRING_NONE)
+        sourceId = symbols.intern(chunk.symbols.strings().str(chunk.lastSource),
+            chunk.symbols.strings().len(chunk.lastSource));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Parses a chunk of MAP file, starting at known section state.
+/// @param chunk The chunk to parse; its start, end and startSection must be set
+/// @param opts Parsing options
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void parseChunk(MapFile::MAPChunk &chunk, const MapFile::MAPParseOptions &opts)
+{
+    std::vector<MapFile::MAPLine> lineIndex(MapFile::LINE_INDEX_BLOCK);
+    // Address conditions are checked by the line parsers, before names are read
+    MapFile::MAPSegmentCursor segCursor(*opts.segments,
+        ((opts.filter != NULL) && opts.filter->hasAddresses()) ? opts.filter : NULL);
+    MapFile::MAPFilterState filterState;
+    filterState.filter = ((opts.filter != NULL) && !opts.filter->empty()) ? opts.filter : NULL;
+    filterState.moduleAccepted = true;
+    filterState.lastObjectAccepted = true;
+    MapFile::MAPPendingSymbols pending;
+    pending.count = 0;
+    MapFile::SectionType sectnHdr = chunk.startSection;
+    MapFile::clearParseStats(chunk.stats);
+    chunk.symbols.clear();
+    chunk.symbols.reserve(0, (size_t)(chunk.end - chunk.start) / MapFile::CHUNK_BYTES_PER_STRING, 0);
+    chunk.leadingSymbols = 0;
+    chunk.lastModule = MapFile::STRING_NONE;
+    chunk.lastSource = MapFile::STRING_NONE;
+    chunk.log.clear();
+
+    const char * pScan = chunk.start;
+    const char * pReleased = chunk.start;
+    const char * pCounted = chunk.start;
+    std::chrono::steady_clock::time_point blockStart = std::chrono::steady_clock::now();
+    while (pScan < chunk.end)
+    {
+        // Report parsed bytes once per block of lines, and stop if cancelled
+        if (opts.progress != NULL)
+        {
+            opts.progress->add((size_t)(pScan - pCounted));
+            pCounted = pScan;
+            if (!opts.progress->poll())
+                break;
+        }
+
+        // Keep resident memory bounded on huge files by dropping parsed pages;
+        // names are copied into the symbol table, so the pages are not needed
+        if ((chunk.mapBase != NULL) && ((size_t)(pScan - pReleased) >= MapFile::MAP_RELEASE_GRANULARITY))
+        {
+            pReleased = chunk.mapBase + MapFile::releaseMAP(chunk.mapBase,
+                (size_t)(pReleased - chunk.mapBase), (size_t)(pScan - chunk.mapBase));
+        }
+
+        // Split next part of the file into lines; blank lines, leading spaces
+        // and lines too short to contain a symbol are skipped by the scanner
+        size_t numLines = MapFile::scanLines(pScan, chunk.end, &lineIndex[0], lineIndex.size(),
+            opts.minLineLen, pScan, chunk.stats.binary);
+        std::chrono::steady_clock::time_point scanEnd = std::chrono::steady_clock::now();
+        chunk.stats.scanSeconds += std::chrono::duration<double>(scanEnd - blockStart).count();
+        chunk.stats.lines += numLines;
+        if (chunk.stats.binary)
+        {
+            // File is binary or Unicode file
+            break;
+        }
+
+        for (size_t lineNo = 0; lineNo < numLines; lineNo++)
+        {
+            const char * pLine = lineIndex[lineNo].start;
+            int lineLen = (int)lineIndex[lineNo].len;
+
+            // Check if we're on section header or section end
+            MapFile::SectionType prevSectn = sectnHdr;
+            if (sectnHdr == MapFile::NO_SECTION)
+            {
+                sectnHdr = MapFile::recognizeSectionStart(pLine, lineLen);
+            } else
+            {
+                sectnHdr = MapFile::recognizeSectionEnd(sectnHdr, pLine, lineLen);
+                if (sectnHdr != prevSectn)
+                    CHUNK_LOG_VERBOSE(chunk, opts, "Section end line: '%.*s'.\n", lineLen, pLine);
+            }
+            if (sectnHdr != prevSectn)
+            {
+                if (sectnHdr == MapFile::NO_SECTION)
+                    continue;
+                chunk.stats.sectionsFound++;
+                CHUNK_LOG_VERBOSE(chunk, opts, "Section start line: '%.*s'.\n", lineLen, pLine);
+                // Some sections start with a header of their first record
+                if (!MapFile::getSectionFormat(sectnHdr)->parseStartLine)
+                    continue;
+            }
+            MapFile::MAPSymbolView sym;
+            MapFile::ParseResult parsed = MapFile::SKIP_LINE;
+            MapFile::MAPLineParser parseLine = MapFile::getSectionFormat(sectnHdr)->parseLine;
+            // Line number tables may be larger than the symbols, so they are only parsed if wanted
+            if ((sectnHdr == MapFile::MSVC_LINES_MAP) && !opts.lineNumbers)
+                parseLine = NULL;
+            if (parseLine != NULL)
+                parsed = parseLine(sym, pLine, lineLen, segCursor);
+            if ((parsed == MapFile::SYMBOL_LINE) && (filterState.filter != NULL) &&
+                isSymbolFiltered(filterState, sym, chunk.lastModule))
+                parsed = MapFile::FILTERED_LINE;
+            chunk.stats.sectionLines[sectnHdr]++;
+            chunk.stats.lineResults[parsed]++;
+
+            switch (parsed)
+            {
+            case MapFile::SKIP_LINE:
+                CHUNK_LOG_VERBOSE(chunk, opts, "Skipping line: '%.*s'.\n", lineLen, pLine);
+                break;
+            case MapFile::FINISHING_LINE:
+                sectnHdr = MapFile::NO_SECTION;
+                // we have parsed to end of value/name symbols table or reached EOF
+                CHUNK_LOG_VERBOSE(chunk, opts, "Parsing finished at line: '%.*s'.\n", lineLen, pLine);
+                break;
+            case MapFile::INVALID_LINE:
+                chunk.stats.invalidLines++;
+                CHUNK_LOG_VERBOSE(chunk, opts, "Invalid map line: %.*s.\n", lineLen, pLine);
+                break;
+            case MapFile::COMMENT_LINE:
+                // Comments do not have an address, so are not applied
+                CHUNK_LOG_VERBOSE(chunk, opts, "Comment line: %.*s.\n", lineLen, pLine);
+                break;
+            case MapFile::MODULE_LINE:
+                chunk.lastModule = chunk.symbols.intern(sym.name, sym.nameLen);
+                if (filterState.filter != NULL)
+                    filterState.moduleAccepted = filterState.filter->acceptsObject(sym.name, sym.nameLen);
+                CHUNK_LOG_VERBOSE(chunk, opts, "Module line: %.*s.\n", lineLen, pLine);
+                break;
+            case MapFile::SYMBOL_LINE:
+                addParsedSymbol(chunk.symbols, pending, sym, chunk.lastModule);
+                if (chunk.lastModule == MapFile::STRING_NONE)
+                    chunk.leadingSymbols++;
+                break;
+            case MapFile::SOURCE_LINE:
+                chunk.lastSource = chunk.symbols.intern(sym.name, sym.nameLen);
+                CHUNK_LOG_VERBOSE(chunk, opts, "Line numbers for: %.*s.\n", (int)sym.nameLen, sym.name);
+                break;
+            case MapFile::FILTERED_LINE:
+                // Rejected by the import filter; usually most lines, so not logged
+                break;
+            case MapFile::LINE_NUMBERS_LINE:
+                if (MapFile::parseLineNumbers(pLine, lineLen, segCursor, chunk.lastSource, chunk.symbols.lines()) > 0)
+                {
+                    chunk.stats.invalidLines++;
+                    CHUNK_LOG_VERBOSE(chunk, opts, "Invalid line numbers: %.*s.\n", lineLen, pLine);
+                }
+                break;
+            }
+        }
+        flushPendingSymbols(chunk.symbols, pending);
+        blockStart = std::chrono::steady_clock::now();
+        chunk.stats.parseSeconds += std::chrono::duration<double>(blockStart - scanEnd).count();
+    }
+    if (opts.progress != NULL)
+        opts.progress->add((size_t)(pScan - pCounted));
+    chunk.stats.bytes = (unsigned long long)(pScan - chunk.start);
+    chunk.symbols.releaseIndex();
+    chunk.endSection = sectnHdr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Finds lines within a chunk which may change the section state.
+/// @param chunk The chunk to scan
+/// @param minLineLen Minimal accepted length of line
+/// @param markers Target list of the marker lines
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void prescanChunk(const MapFile::MAPChunk &chunk, size_t minLineLen, std::vector<MapFile::MAPLine> &markers)
+{
+    std::vector<MapFile::MAPLine> lineIndex(MapFile::LINE_INDEX_BLOCK);
+    const char * pScan = chunk.start;
+    bool binary = false;
+    markers.clear();
+    while ((pScan < chunk.end) && !binary)
+    {
+        size_t numLines = MapFile::scanLines(pScan, chunk.end, &lineIndex[0], lineIndex.size(),
+            minLineLen, pScan, binary);
+        for (size_t lineNo = 0; lineNo < numLines; lineNo++)
+        {
+            const MapFile::MAPLine &line = lineIndex[lineNo];
+            if (MapFile::isSectionMarker(line.start, line.len))
+                markers.push_back(line);
+        }
+    }
+}
+
+/// Finds start of the first line after given position.
+static const char * findNextLineStart(const char * p, const char * pEnd)
+{
+    while ((p < pEnd) && (*p != '\r') && (*p != '\n'))
+        p++;
+    return (p < pEnd) ? (p + 1) : pEnd;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Splits MAP file buffers into chunks, and parses them.
+/// Chunks of all the buffers are parsed by one pool of threads, so that
+/// small files are parsed in parallel with parts of large ones.
+/// @param buffers The MAP file buffers
+/// @param opts Parsing options
+/// @param chunks Target list of parsed chunks, in order of buffers
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void parseMapChunks(const std::vector<MapFile::MAPBuffer> &buffers, const MapFile::MAPParseOptions &opts,
+    std::vector<MapFile::MAPChunk> &chunks)
+{
+
+    unsigned int numThreads = opts.numThreads;
+    if (numThreads == 0)
+        numThreads = std::thread::hardware_concurrency();
+    if (numThreads == 0)
+        numThreads = 1;
+
+    // Split the buffers into chunks at line boundaries
+    chunks.clear();
+    for (size_t fileNo = 0; fileNo < buffers.size(); fileNo++)
+    {
+        const char * pStart = buffers[fileNo].start;
+        const char * pEnd = buffers[fileNo].end;
+        size_t bufSize = (size_t)(pEnd - pStart);
+        size_t numChunks = 1;
+        if (numThreads > 1)
+        {
+            numChunks = bufSize / MapFile::MIN_CHUNK_SIZE;
+            if (numChunks > numThreads * MapFile::CHUNKS_PER_THREAD)
+                numChunks = numThreads * MapFile::CHUNKS_PER_THREAD;
+            if (numChunks < 1)
+                numChunks = 1;
+        }
+        const char * pChunk = pStart;
+        for (size_t i = 1; (i <= numChunks) && (pChunk < pEnd); i++)
+        {
+            const char * pChunkEnd = pEnd;
+            if (i < numChunks)
+                pChunkEnd = findNextLineStart(pStart + (bufSize / numChunks) * i, pEnd);
+            if (pChunkEnd <= pChunk)
+                continue;
+            chunks.push_back(MapFile::MAPChunk());
+            MapFile::MAPChunk &chunk = chunks.back();
+            chunk.start = pChunk;
+            chunk.end = pChunkEnd;
+            chunk.mapBase = buffers[fileNo].mapBase;
+            chunk.fileNo = fileNo;
+            chunk.startSection = MapFile::NO_SECTION;
+            chunk.endSection = MapFile::NO_SECTION;
+            pChunk = pChunkEnd;
+        }
+    }
+    if (chunks.size() < 2)
+    {
+        for (size_t i = 0; i < chunks.size(); i++)
+            parseChunk(chunks[i], opts);
+        return;
+    }
+
+    // Pre-scan the chunks for section markers; markers of the last chunk
+    // of a file do not affect any other chunk
+    std::vector< std::vector<MapFile::MAPLine> > markers(chunks.size());
+    std::vector<size_t> prescanned;
+    for (size_t chunkNo = 0; chunkNo + 1 < chunks.size(); chunkNo++)
+    {
+        if (chunks[chunkNo].fileNo == chunks[chunkNo + 1].fileNo)
+            prescanned.push_back(chunkNo);
+    }
+    MapFile::runInParallel(numThreads, prescanned.size(), [&](size_t jobNo)
+    {
+        size_t chunkNo = prescanned[jobNo];
+        prescanChunk(chunks[chunkNo], opts.minLineLen, markers[chunkNo]);
+    });
+
+    // Replay the markers to guess section state at start of each chunk
+    MapFile::SectionType sectnHdr = MapFile::NO_SECTION;
+    for (size_t chunkNo = 0; chunkNo < chunks.size(); chunkNo++)
+    {
+        if ((chunkNo > 0) && (chunks[chunkNo].fileNo != chunks[chunkNo - 1].fileNo))
+            sectnHdr = MapFile::NO_SECTION;
+        chunks[chunkNo].startSection = sectnHdr;
+        for (size_t i = 0; i < markers[chunkNo].size(); i++)
+        {
+            const MapFile::MAPLine &line = markers[chunkNo][i];
+            if (sectnHdr == MapFile::NO_SECTION)
+                sectnHdr = MapFile::recognizeSectionStart(line.start, line.len);
+            else
+                sectnHdr = MapFile::recognizeSectionEnd(sectnHdr, line.start, line.len);
+        }
+    }
+
+    MapFile::runInParallel(numThreads, chunks.size(), [&](size_t chunkNo)
+    {
+        parseChunk(chunks[chunkNo], opts);
+    });
+
+    // Section may have ended on a line which could not be parsed; the pre-scan
+    // does not see that, so verify the guess and re-parse chunks where it was wrong
+    if ((opts.progress != NULL) && opts.progress->cancelled())
+        return;
+    for (size_t chunkNo = 1; chunkNo < chunks.size(); chunkNo++)
+    {
+        if (chunks[chunkNo].fileNo != chunks[chunkNo - 1].fileNo)
+            continue;
+        if (chunks[chunkNo].startSection == chunks[chunkNo - 1].endSection)
+            continue;
+        chunks[chunkNo].startSection = chunks[chunkNo - 1].endSection;
+        parseChunk(chunks[chunkNo], opts);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Joins parsed chunks of one MAP file into a symbol table.
+/// @param chunks List of parsed chunks
+/// @param firstChunk Index of the first chunk of the file
+/// @param endChunk Index after the last chunk of the file
+/// @param filter The import filter, NULL if there is none
+/// @param symbols Target symbol table
+/// @param stats Target parsing summary
+/// @param log Target buffer for verbose messages
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void mergeFileChunks(std::vector<MapFile::MAPChunk> &chunks, size_t firstChunk, size_t endChunk,
+    const MapFile::MAPFilter * filter, MapFile::MAPSymbolTable &symbols, MapFile::MAPParseStats &stats,
+    std::string &log)
+{
+    // Merge the chunks, in file order
+    size_t numSymbols = 0;
+    size_t numStrings = 0;
+    size_t stringsSize = 0;
+    unsigned int moduleId = MapFile::STRING_NONE;
+    unsigned int sourceId = MapFile::STRING_NONE;
+    MapFile::clearParseStats(stats);
+    for (size_t chunkNo = firstChunk; chunkNo < endChunk; chunkNo++)
+    {
+        numSymbols += chunks[chunkNo].symbols.size();
+        numStrings += chunks[chunkNo].symbols.strings().size();
+        stringsSize += chunks[chunkNo].symbols.strings().dataSize();
+        MapFile::addParseStats(stats, chunks[chunkNo].stats);
+    }
+    symbols.clear();
+    log.clear();
+    if (stats.binary)
+        return;
+    if (endChunk - firstChunk == 1)
+    {
+        symbols.swap(chunks[firstChunk].symbols);
+        filterLeadingSymbols(symbols, 0, chunks[firstChunk].leadingSymbols, moduleId, filter, stats);
+        symbols.lines().sort();
+        log.swap(chunks[firstChunk].log);
+        return;
+    }
+    // The first chunk is taken as it is, so only following ones are interned again
+    symbols.swap(chunks[firstChunk].symbols);
+    filterLeadingSymbols(symbols, 0, chunks[firstChunk].leadingSymbols, moduleId, filter, stats);
+    symbols.reserve(numSymbols, numStrings, stringsSize);
+    log.swap(chunks[firstChunk].log);
+    moduleId = chunks[firstChunk].lastModule;
+    sourceId = chunks[firstChunk].lastSource;
+    for (size_t chunkNo = firstChunk + 1; chunkNo < endChunk; chunkNo++)
+    {
+        appendChunkSymbols(symbols, chunks[chunkNo], moduleId, sourceId, filter, stats);
+        MapFile::MAPSymbolTable().swap(chunks[chunkNo].symbols);
+        log.append(chunks[chunkNo].log);
+    }
+    symbols.releaseIndex();
+    symbols.lines().sort();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets all counters of parsing summary to zero.
+/// @param stats The parsing summary
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::clearParseStats(MapFile::MAPParseStats &stats)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds counters of one parsing summary to another.
+/// @param stats Target parsing summary
+/// @param other The summary to add
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::addParseStats(MapFile::MAPParseStats &stats, const MapFile::MAPParseStats &other)
+{
+    stats.sectionsFound += other.sectionsFound;
+    stats.invalidLines += other.invalidLines;
+    stats.binary |= other.binary;
+    stats.bytes += other.bytes;
+    stats.lines += other.lines;
+    for (unsigned int i = 0; i < MapFile::SECTION_TYPE_COUNT; i++)
+        stats.sectionLines[i] += other.sectionLines[i];
+    for (unsigned int i = 0; i < MapFile::PARSE_RESULT_COUNT; i++)
+        stats.lineResults[i] += other.lineResults[i];
+    stats.scanSeconds += other.scanSeconds;
+    stats.parseSeconds += other.parseSeconds;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Parses whole MAP file buffer into a symbol table.
+/// Symbols within the table are in the same order as in the file.
+/// @param pStart Pointer to start of buffer
+/// @param pEnd Pointer to end of buffer
+/// @param opts Parsing options
+/// @param symbols Target symbol table
+/// @param stats Target parsing summary
+/// @param log Target buffer for verbose messages
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::parseMapBuffer(const char * pStart, const char * pEnd, const MapFile::MAPParseOptions &opts,
+    MapFile::MAPSymbolTable &symbols, MapFile::MAPParseStats &stats, std::string &log)
+{
+    std::vector<MapFile::MAPBuffer> buffers(1);
+    buffers[0].start = pStart;
+    buffers[0].end = pEnd;
+    buffers[0].mapBase = opts.mapBase;
+    std::vector<MapFile::MAPChunk> chunks;
+    parseMapChunks(buffers, opts, chunks);
+    mergeFileChunks(chunks, 0, chunks.size(), opts.filter, symbols, stats, log);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Parses several MAP file buffers, each into its own symbol table.
+/// The files are parsed at the same time, by one pool of threads.
+/// @param buffers The MAP file buffers
+/// @param opts Parsing options; mapBase is taken from each buffer instead
+/// @param results Target parsing results, one for each buffer
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::parseMapBuffers(const std::vector<MapFile::MAPBuffer> &buffers, const MapFile::MAPParseOptions &opts,
+    std::vector<MapFile::MAPParseResult> &results)
+{
+    std::vector<MapFile::MAPChunk> chunks;
+    parseMapChunks(buffers, opts, chunks);
+    results.resize(buffers.size());
+    size_t firstChunk = 0;
+    for (size_t fileNo = 0; fileNo < buffers.size(); fileNo++)
+    {
+        size_t endChunk = firstChunk;
+        while ((endChunk < chunks.size()) && (chunks[endChunk].fileNo == fileNo))
+            endChunk++;
+        mergeFileChunks(chunks, firstChunk, endChunk, opts.filter, results[fileNo].symbols,
+            results[fileNo].stats, results[fileNo].log);
+        firstChunk = endChunk;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Parses MAP file given by streaming reader into a symbol table.
+/// Blocks are parsed while the reader fetches next ones in background; section
+/// state is passed from one block to the next.
+/// @param reader Opened reader of the MAP file
+/// @param opts Parsing options; mapBase is ignored
+/// @param symbols Target symbol table
+/// @param stats Target parsing summary
+/// @param log Target buffer for verbose messages
+/// @return False if reading the file failed; symbols parsed so far are kept
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::parseMapStream(MapFile::MAPStreamReader &reader, const MapFile::MAPParseOptions &opts,
+    MapFile::MAPSymbolTable &symbols, MapFile::MAPParseStats &stats, std::string &log)
+{
+    MapFile::MAPChunk chunk;
+    chunk.mapBase = NULL;
+    chunk.fileNo = 0;
+    chunk.endSection = MapFile::NO_SECTION;
+    unsigned int moduleId = MapFile::STRING_NONE;
+    unsigned int sourceId = MapFile::STRING_NONE;
+    MapFile::clearParseStats(stats);
+    symbols.clear();
+    log.clear();
+
+    const char * pStart;
+    const char * pEnd;
+    while (reader.nextBlock(pStart, pEnd))
+    {
+        if ((opts.progress != NULL) && opts.progress->cancelled())
+            break;
+        chunk.start = pStart;
+        chunk.end = pEnd;
+        chunk.startSection = chunk.endSection;
+        parseChunk(chunk, opts);
+        MapFile::addParseStats(stats, chunk.stats);
+        if (chunk.stats.binary)
+        {
+            symbols.clear();
+            log.clear();
+            break;
+        }
+        appendChunkSymbols(symbols, chunk, moduleId, sourceId, opts.filter, stats);
+        log.append(chunk.log);
+    }
+    symbols.releaseIndex();
+    symbols.lines().sort();
+    if (reader.linesSkipped() > 0)
+    {
+        stats.invalidLines += reader.linesSkipped();
+        chunk.log.clear();
+        CHUNK_LOG_VERBOSE(chunk, opts, "Skipped %lu lines longer than %lu bytes.\n",
+            reader.linesSkipped(), (unsigned long)MapFile::STREAM_CARRY_SIZE);
+        log.append(chunk.log);
+    }
+    return !reader.failed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPParser.h
+///     MAP file parsing state machine header.
+/// @par Purpose:
+///     Parses MAP file buffer into list of symbols, using multiple threads.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPPARSER_H_
+#define MAPPARSER_H_
+
+#include  <cstdio>
+#include  <vector>
+#include  <string>
+#include  <functional>
+
+#include  "MAPReader.h"
+#include  "MAPSymbols.h"
+#include  "MAPSegments.h"
+#include  "MAPFilter.h"
+#include  "MAPStream.h"
+#include  "MAPProgress.h"
+
+namespace MapFile {
+
+/// Settings of the parsing process.
+typedef struct {
+    size_t minLineLen;
+    const MAPSegmentMap * segments;     ///< Segments of the target executable
+    bool verbose;
+    unsigned int numThreads;    ///< Amount of worker threads, 0 for auto
+    const char * mapBase;       ///< Start of the file mapping, to release parsed pages; NULL to keep them
+    MAPProgress * progress;     ///< Receives amount of parsed bytes, and stops parsing when cancelled; NULL if not needed
+    const MAPFilter * filter;   ///< Selects symbols to keep; NULL to keep all
+    bool lineNumbers;           ///< Parse line number tables; if not set, they are skipped
+} MAPParseOptions;
+
+/// Summary of the parsing process.
+typedef struct {
+    unsigned long sectionsFound;
+    unsigned long invalidLines;
+    bool binary;                ///< NUL character found, the file is not a text file
+    unsigned long long bytes;   ///< Amount of parsed text
+    unsigned long long lines;   ///< Non-blank lines long enough to hold a symbol
+    unsigned long sectionLines[SECTION_TYPE_COUNT]; ///< Lines other than section markers, by section they are in
+    unsigned long lineResults[PARSE_RESULT_COUNT];  ///< Lines other than section markers, by result of parsing
+    double scanSeconds;         ///< Time of splitting the text into lines, summed over all threads
+    double parseSeconds;        ///< Time of parsing the lines, summed over all threads
+} MAPParseStats;
+
+/// Content of one MAP file given to the parser.
+typedef struct {
+    const char * start;
+    const char * end;
+    const char * mapBase;       ///< Start of the file mapping, to release parsed pages; NULL to keep them
+} MAPBuffer;
+
+/// Result of parsing one MAP file.
+typedef struct {
+    MAPSymbolTable symbols;
+    MAPParseStats stats;
+    std::string log;
+} MAPParseResult;
+
+void clearParseStats(MAPParseStats &stats);
+void addParseStats(MAPParseStats &stats, const MAPParseStats &other);
+void parseMapBuffer(const char * pStart, const char * pEnd, const MAPParseOptions &opts,
+    MAPSymbolTable &symbols, MAPParseStats &stats, std::string &log);
+void parseMapBuffers(const std::vector<MAPBuffer> &buffers, const MAPParseOptions &opts,
+    std::vector<MAPParseResult> &results);
+bool parseMapStream(MAPStreamReader &reader, const MAPParseOptions &opts,
+    MAPSymbolTable &symbols, MAPParseStats &stats, std::string &log);
+void runInParallel(unsigned int numThreads, size_t numJobs, const std::function<void(size_t)> &job);
+
+};
+
+#endif
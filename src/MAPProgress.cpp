@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPProgress.cpp
+///     Progress reporting and cancellation.
+/// @par Purpose:
+///     Counts work done by parsing threads, and lets the thread which started
+///     the work show the progress and cancel it, at low cost to the workers.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPProgress.h"
+
+using namespace std;
+
+static inline double secondsBetween(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+{
+    return std::chrono::duration<double>(to - from).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Creates the progress; it is reported from the calling thread.
+/// @param func Function which shows the progress; may be NULL, to only
+///     allow cancelling the work with cancel()
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+MapFile::MAPProgress::MAPProgress(MapFile::MAPProgressFunc func)
+    : reportFunc(func), owner(std::this_thread::get_id()), numDone(0), isCancelled(false),
+    phaseName(""), phaseTotal(0), phaseInBytes(false), lastDone(0), lastRate(0.0)
+{
+    phaseStart = lastReport = std::chrono::steady_clock::now();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Starts next phase of the work, and reports it at once.
+/// Must not be called while other threads count work done.
+/// @param name Name of the phase, shown to the user; must stay valid during the phase
+/// @param total Amount of work within the phase, 0 if not known
+/// @param inBytes True if the work is counted in bytes, false if in items
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPProgress::startPhase(const char * name, unsigned long long total, bool inBytes)
+{
+    phaseName = name;
+    phaseTotal = total;
+    phaseInBytes = inBytes;
+    numDone.store(0, std::memory_order_relaxed);
+    lastDone = 0;
+    lastRate = 0.0;
+    phaseStart = std::chrono::steady_clock::now();
+    report(phaseStart);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reports the progress if enough time passed since previous report.
+/// Cheap enough to be called after each block of parsed lines; on threads
+/// other than the owner, only checks for cancellation.
+/// @return False if the work was cancelled and should stop
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPProgress::poll(void)
+{
+    if ((reportFunc != NULL) && (std::this_thread::get_id() == owner))
+    {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now - lastReport >= std::chrono::milliseconds(PROGRESS_INTERVAL_MS))
+            report(now);
+    }
+    return !cancelled();
+}
+
+void MapFile::MAPProgress::report(std::chrono::steady_clock::time_point now)
+{
+    unsigned long long curDone = done();
+    double interval = secondsBetween(lastReport, now);
+    if ((interval > 0.0) && (curDone >= lastDone))
+        lastRate = (double)(curDone - lastDone) / interval;
+    lastDone = curDone;
+    lastReport = now;
+    if ((reportFunc != NULL) && !reportFunc(*this))
+        cancel();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives amount of work done within the current phase.
+/// Work may be counted twice when a part of it is redone, so the amount
+/// is limited to the phase total.
+/// @return Amount of work done
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+unsigned long long MapFile::MAPProgress::done(void) const
+{
+    unsigned long long curDone = numDone.load(std::memory_order_relaxed);
+    return ((phaseTotal > 0) && (curDone > phaseTotal)) ? phaseTotal : curDone;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Estimates time needed to finish the current phase.
+/// Uses average rate since start of the phase, as it changes less than the
+/// rate between reports.
+/// @return Amount of seconds, or negative value if it cannot be estimated
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+double MapFile::MAPProgress::secondsLeft(void) const
+{
+    unsigned long long curDone = done();
+    double elapsed = secondsBetween(phaseStart, lastReport);
+    if ((phaseTotal == 0) || (curDone == 0) || (elapsed <= 0.0))
+        return -1.0;
+    return elapsed * (double)(phaseTotal - curDone) / (double)curDone;
+}
+
+////////////////////////////////////////////////////////////////////////////////
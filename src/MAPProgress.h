@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPProgress.h
+///     Progress reporting and cancellation header.
+/// @par Purpose:
+///     Counts work done by parsing threads, and lets the thread which started
+///     the work show the progress and cancel it, at low cost to the workers.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPPROGRESS_H_
+#define MAPPROGRESS_H_
+
+#include  <cstdio>
+#include  <atomic>
+#include  <chrono>
+#include  <thread>
+
+namespace MapFile {
+
+/// Minimal time between two reports of progress, in milliseconds.
+const unsigned int PROGRESS_INTERVAL_MS = 250;
+
+class MAPProgress;
+
+/// Shows the progress; returns false if the user wants to cancel the work.
+typedef bool (*MAPProgressFunc)(const MAPProgress &progress);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Progress of a long operation, split into phases.
+/// Any thread may count work done and check for cancellation; the progress
+/// is only reported from the thread which created the object, as UI calls
+/// are not allowed from other threads.
+////////////////////////////////////////////////////////////////////////////////
+class MAPProgress {
+public:
+    MAPProgress(MAPProgressFunc func);
+    void startPhase(const char * name, unsigned long long total, bool inBytes);
+    void add(unsigned long long amount) { numDone.fetch_add(amount, std::memory_order_relaxed); }
+    bool poll(void);
+    void cancel(void) { isCancelled.store(true, std::memory_order_relaxed); }
+    bool cancelled(void) const { return isCancelled.load(std::memory_order_relaxed); }
+
+    const char * phase(void) const { return phaseName; }
+    unsigned long long done(void) const;
+    unsigned long long total(void) const { return phaseTotal; }
+    bool inBytes(void) const { return phaseInBytes; }
+    double rate(void) const { return lastRate; }
+    double secondsLeft(void) const;
+
+private:
+    MAPProgress(const MAPProgress &);
+    MAPProgress & operator=(const MAPProgress &);
+    void report(std::chrono::steady_clock::time_point now);
+
+    MAPProgressFunc reportFunc;
+    std::thread::id owner;
+    std::atomic<unsigned long long> numDone;
+    std::atomic<bool> isCancelled;
+    const char * phaseName;
+    unsigned long long phaseTotal;
+    bool phaseInBytes;          ///< Work is counted in bytes, not in items
+    std::chrono::steady_clock::time_point phaseStart;
+    std::chrono::steady_clock::time_point lastReport;
+    unsigned long long lastDone;
+    double lastRate;            ///< Amount done per second, between the last two reports
+};
+
+};
+
+#endif
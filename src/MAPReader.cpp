@@ -14,14 +14,25 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include  "MAPReader.h"
+#include  "MAPSegments.h"
+#include  "MAPLines.h"
 
 #include  <cstring>
 #include  <cctype>
 #include  <cassert>
 #include  <cstdlib>
+#include  <cerrno>
 
 #include "stdafx.h"
 
+#if !defined(_WIN32)
+#include  <stdint.h>
+#include  <fcntl.h>
+#include  <unistd.h>
+#include  <sys/mman.h>
+#include  <sys/stat.h>
+#endif
+
 using namespace std;
 
 namespace MapFile {
@@ -34,7 +45,7 @@ const char BCCL_HDR_NAME_START[]   = "Address         Publics by Name";
 const char BCCL_HDR_VALUE_START[]  = "Address         Publics by Value";
 const char WATCOM_MEMMAP_START[]   = "Address        Symbol";
 const char WATCOM_MEMMAP_SKIP[]   = "=======        ======";
-const char WATCOM_MEMMAP_COMMENT[] = "Module: ";
+const char WATCOM_MEMMAP_MODULE[]  = "Module: ";
 const char WATCOM_END_TABLE_HDR[]  = "+----------------------+";
 const char MSVC_LINE_NUMBER[]      = "Line numbers for ";
 const char MSVC_FIXUP[]            = "FIXUPS: ";
@@ -49,6 +60,85 @@ const char GCC_MEMMAP_LOAD[]       = "LOAD ";
 
 /// @}
 
+/// Marker line which starts or ends a section.
+typedef struct {
+    const char * text;
+    size_t len;
+    size_t minLen;          ///< Shortest line accepted as start marker
+    SectionType section;
+    bool prefix;            ///< Start marker is case-sensitive prefix of the line, like end markers
+} MAPSectionMarker;
+
+#define SECTION_MARKER(text, minLen, section) { text, sizeof(text) - 1, minLen, section, false }
+#define SECTION_PREFIX(text, section) { text, sizeof(text) - 1, sizeof(text) - 1, section, true }
+
+/// Lines which start symbol sections, in order of precedence.
+/// The BCCL_HDR_VALUE_START line is matched by MSVC entries, which share the parser.
+const MAPSectionMarker START_MARKERS[] = {
+    SECTION_MARKER(MSVC_HDR_START,       sizeof(BCCL_HDR_VALUE_START) - 1, MSVC_MAP),
+    SECTION_MARKER(MSVC_HDR_START2,      sizeof(BCCL_HDR_VALUE_START) - 1, MSVC_MAP),
+    SECTION_MARKER(BCCL_HDR_NAME_START,  sizeof(BCCL_HDR_NAME_START) - 1,  BCCL_NAM_MAP),
+    SECTION_MARKER(BCCL_HDR_VALUE_START, sizeof(BCCL_HDR_VALUE_START) - 1, BCCL_VAL_MAP),
+    SECTION_MARKER(WATCOM_MEMMAP_START,  sizeof(WATCOM_MEMMAP_START) - 1,  WATCOM_MAP),
+    SECTION_MARKER(GCC_MEMMAP_START,     sizeof(GCC_MEMMAP_START) - 1,     GCC_MAP),
+    SECTION_PREFIX(MSVC_LINE_NUMBER,     MSVC_LINES_MAP),
+};
+
+/// Lines which end symbol sections; matched as case-sensitive prefix of the line.
+const MAPSectionMarker END_MARKERS[] = {
+    SECTION_MARKER(MSVC_LINE_NUMBER,     0, MSVC_MAP),
+    SECTION_MARKER(MSVC_FIXUP,           0, MSVC_MAP),
+    SECTION_MARKER(MSVC_EXPORTS,         0, MSVC_MAP),
+    SECTION_MARKER(MSVC_FIXUP,           0, MSVC_LINES_MAP),
+    SECTION_MARKER(MSVC_EXPORTS,         0, MSVC_LINES_MAP),
+    SECTION_MARKER(WATCOM_END_TABLE_HDR, 0, WATCOM_MAP),
+    SECTION_MARKER(GCC_MEMMAP_END,       0, GCC_MAP),
+};
+
+#undef SECTION_MARKER
+#undef SECTION_PREFIX
+
+/// Registry of section types, indexed by SectionType.
+const MAPSectionFormat SECTION_FORMATS[] = {
+    { NO_SECTION,     "none",           NULL,                  false },
+    { MSVC_MAP,       "MSVC",           parseMsSymbolView,     false },
+    { BCCL_NAM_MAP,   "Borland name",   parseMsSymbolView,     false },
+    { BCCL_VAL_MAP,   "Borland value",  parseMsSymbolView,     false },
+    { WATCOM_MAP,     "Watcom",         parseWatcomSymbolView, false },
+    { GCC_MAP,        "GCC",            parseGccSymbolView,    false },
+    { MSVC_LINES_MAP, "MSVC lines",     parseMsLinesView,      true },
+};
+
+/// Markers to compare, selected by first character of the line; bit N is set
+/// for entry N of the markers table.
+typedef struct {
+    unsigned short startMask[256];
+    unsigned short endMask[256];
+} MAPMarkerDispatch;
+
+static_assert(sizeof(START_MARKERS) / sizeof(START_MARKERS[0]) <= 16, "Too many start markers for dispatch mask");
+static_assert(sizeof(END_MARKERS) / sizeof(END_MARKERS[0]) <= 16, "Too many end markers for dispatch mask");
+
+static MAPMarkerDispatch buildMarkerDispatch(void)
+{
+    MAPMarkerDispatch dispatch;
+    memset(&dispatch, 0, sizeof(dispatch));
+    for (size_t i = 0; i < sizeof(START_MARKERS) / sizeof(START_MARKERS[0]); i++)
+    {
+        unsigned char c = (unsigned char)START_MARKERS[i].text[0];
+        dispatch.startMask[tolower(c)] |= (unsigned short)(1 << i);
+        dispatch.startMask[toupper(c)] |= (unsigned short)(1 << i);
+    }
+    for (size_t i = 0; i < sizeof(END_MARKERS) / sizeof(END_MARKERS[0]); i++)
+    {
+        unsigned char c = (unsigned char)END_MARKERS[i].text[0];
+        dispatch.endMask[c] |= (unsigned short)(1 << i);
+    }
+    return dispatch;
+}
+
+const MAPMarkerDispatch MARKER_DISPATCH = buildMarkerDispatch();
+
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -70,31 +160,43 @@ MapFile::MAPResult MapFile::openMAP(const char * fileName, char * &mapAddr, size
     assert(NULL != fileName);
     if (NULL == fileName)
     {
+#if defined(_WIN32)
         SetLastError(ERROR_INVALID_PARAMETER);
-        return WIN32_ERROR;
+#else
+        errno = EINVAL;
+#endif
+        return OS_ERROR;
     }
 
+#if defined(_WIN32)
     // Open the file
     HANDLE hFile = CreateFile(fileName, GENERIC_READ, FILE_SHARE_READ, NULL,
-                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
     if (INVALID_HANDLE_VALUE == hFile)
     {
-        return WIN32_ERROR;
+        return OS_ERROR;
     }
 
-    dwSize = GetFileSize(hFile, NULL);
-    if ((INVALID_MAPFILE_SIZE == dwSize) || (0 == dwSize))
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize) || (fileSize.QuadPart < 0) ||
+        ((unsigned long long)fileSize.QuadPart >= INVALID_MAPFILE_SIZE))
     {
-        // File too large or empty
+        // File too large for address space, or size unknown
         WIN32CHECK(CloseHandle(hFile));
-        return ((0 == dwSize) ? FILE_EMPTY_ERROR : WIN32_ERROR);
+        return OS_ERROR;
+    }
+    dwSize = (size_t)fileSize.QuadPart;
+    if (0 == dwSize)
+    {
+        WIN32CHECK(CloseHandle(hFile));
+        return FILE_EMPTY_ERROR;
     }
 
     HANDLE hMap = CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
     if (NULL == hMap)
     {
         WIN32CHECK(CloseHandle(hFile));
-        return WIN32_ERROR;
+        return OS_ERROR;
     }
 
     // Mapping creation successful, do not need file handle anymore
@@ -104,32 +206,160 @@ MapFile::MAPResult MapFile::openMAP(const char * fileName, char * &mapAddr, size
     if (NULL == mapAddr)
     {
         WIN32CHECK(CloseHandle(hMap));
-        return WIN32_ERROR;
+        return OS_ERROR;
     }
 
     // Map View successful, do not need the map handle anymore
     WIN32CHECK(CloseHandle(hMap));
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+    {
+        return OS_ERROR;
+    }
 
-    if (NULL != memchr(mapAddr, 0, dwSize))
+    struct stat st;
+    int err = 0;
+    if (fstat(fd, &st) != 0)
+        err = errno;
+    else if (!S_ISREG(st.st_mode)) // Pipes and devices cannot be mapped
+        err = EINVAL;
+    else if ((unsigned long long)st.st_size >= INVALID_MAPFILE_SIZE)
+        err = EFBIG;
+    if (0 != err)
     {
-        // File is binary or Unicode file
-        WIN32CHECK(UnmapViewOfFile(mapAddr));
-        mapAddr = NULL;
-        return FILE_BINARY_ERROR;
+        close(fd);
+        errno = err;
+        return OS_ERROR;
     }
+    dwSize = (size_t)st.st_size;
+    if (0 == dwSize)
+    {
+        close(fd);
+        return FILE_EMPTY_ERROR;
+    }
+
+    void * addr = mmap(NULL, dwSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    // Mapping keeps its own reference to the file, do not need descriptor anymore
+    err = errno;
+    close(fd);
+    if (MAP_FAILED == addr)
+    {
+        errno = err;
+        return OS_ERROR;
+    }
+    mapAddr = (char *)addr;
+#endif
+
+    // We will go through the file once, from start to end
+    adviseMAP(mapAddr, dwSize, ADVISE_SEQUENTIAL);
+    adviseMAP(mapAddr, dwSize, ADVISE_WILLNEED);
 
+    // Binary or Unicode files are detected while splitting the file into lines,
+    // to avoid an additional pass through the whole file here
     return OPEN_NO_ERROR;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief Close memory map file which opened by MemMapFileOpen function.
 /// @param lpAddr: Pointer to memory return by MemMapFileOpen.
+/// @param dwSize: Size of the mapped file, as returned by MemMapFileOpen.
 /// @author TQN
 /// @date 2004.09.12
 ////////////////////////////////////////////////////////////////////////////////
-void MapFile::closeMAP(const void * lpAddr)
+void MapFile::closeMAP(const void * lpAddr, size_t dwSize)
 {
+#if defined(_WIN32)
     WIN32CHECK(UnmapViewOfFile(lpAddr));
+#else
+    munmap((void *)lpAddr, dwSize);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives error code of the last failed system call within openMAP().
+/// @return Win32 error code on Windows, errno value on other systems
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+unsigned long MapFile::getLastErrorCode(void)
+{
+#if defined(_WIN32)
+    return GetLastError();
+#else
+    return (unsigned long)errno;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Informs the OS on how we intend to access given part of mapped file.
+/// @param lpAddr Start of the memory range; does not have to be page aligned.
+/// @param dwSize Size of the memory range.
+/// @param advice The intended access pattern.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::adviseMAP(const void * lpAddr, size_t dwSize, MAPAdvice advice)
+{
+    if ((NULL == lpAddr) || (0 == dwSize))
+        return;
+#if defined(_WIN32)
+    switch (advice)
+    {
+    case ADVISE_DONTNEED:
+        // Unlocking pages which were never locked removes them from working set
+        VirtualUnlock((LPVOID)lpAddr, dwSize);
+        break;
+    case ADVISE_SEQUENTIAL: // Handled by FILE_FLAG_SEQUENTIAL_SCAN on open
+    case ADVISE_WILLNEED: // Prefetching requires Win8; the cache manager reads ahead anyway
+    default:
+        break;
+    }
+#else
+    // madvise() requires page aligned start; extend the range down to page boundary
+    const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)lpAddr & ~(uintptr_t)(pageSize - 1);
+    size_t len = dwSize + ((uintptr_t)lpAddr - start);
+    switch (advice)
+    {
+    case ADVISE_SEQUENTIAL:
+        madvise((void *)start, len, MADV_SEQUENTIAL);
+        break;
+    case ADVISE_WILLNEED:
+        madvise((void *)start, len, MADV_WILLNEED);
+        break;
+    case ADVISE_DONTNEED:
+        madvise((void *)start, len, MADV_DONTNEED);
+        break;
+    }
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Releases pages of the mapped file which were already parsed.
+/// Only whole pages within the given range are released, so that a line
+/// straddling the page boundary stays accessible.
+/// @param lpMapAddr Start of the mapped file.
+/// @param relStart Offset of the first byte which may be released.
+/// @param relEnd Offset of the first byte which is still needed.
+/// @return Offset up to which the pages were released; start of next range.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+size_t MapFile::releaseMAP(const char * lpMapAddr, size_t relStart, size_t relEnd)
+{
+#if defined(_WIN32)
+    const size_t pageSize = 4096;
+#else
+    const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+#endif
+    // Pages are aligned relative to the mapping start, which is page aligned
+    size_t alStart = (relStart + pageSize - 1) & ~(pageSize - 1);
+    size_t alEnd = relEnd & ~(pageSize - 1);
+    if (alEnd <= alStart)
+        return relStart;
+    adviseMAP(lpMapAddr + alStart, alEnd - alStart, ADVISE_DONTNEED);
+    return alEnd;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -180,6 +410,9 @@ const char * MapFile::findEOL(const char * pStart, const char * pEnd)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief Checks if a line is the starting line of a section to be analyzed.
+/// The line must be a case-insensitive prefix of the marker, not shorter than
+/// the part of the marker which identifies the section; or, for sections
+/// which start with a header of their first record, begin with the marker.
 /// @param  pLine Pointer to start of buffer
 /// @param  lineLen Length of the current line
 /// @return Type of the new section, or NO_SECTION
@@ -188,21 +421,30 @@ const char * MapFile::findEOL(const char * pStart, const char * pEnd)
 ////////////////////////////////////////////////////////////////////////////////
 MapFile::SectionType MapFile::recognizeSectionStart(const char *pLine, size_t lineLen)
 {
-    if (strncasecmp(pLine, MSVC_HDR_START, lineLen) == 0 || strncasecmp(pLine, MSVC_HDR_START2, lineLen) == 0)
-        return MapFile::MSVC_MAP;
-    if (strncasecmp(pLine, BCCL_HDR_NAME_START, lineLen) == 0)
-        return MapFile::BCCL_NAM_MAP;
-    if (strncasecmp(pLine, BCCL_HDR_VALUE_START, lineLen) == 0)
-        return MapFile::BCCL_VAL_MAP;
-    if (strncasecmp(pLine, WATCOM_MEMMAP_START, lineLen) == 0)
-        return MapFile::WATCOM_MAP;
-    if (strncasecmp(pLine, GCC_MEMMAP_START, lineLen) == 0)
-        return MapFile::GCC_MAP;
+    if (lineLen < 1)
+        return MapFile::NO_SECTION;
+    // Only markers starting with the same character need to be compared
+    unsigned int mask = MARKER_DISPATCH.startMask[(unsigned char)pLine[0]];
+    for (size_t i = 0; mask != 0; i++, mask >>= 1)
+    {
+        const MAPSectionMarker &marker = START_MARKERS[i];
+        if ((mask & 1) == 0)
+            continue;
+        if (marker.prefix)
+        {
+            if ((lineLen >= marker.len) && (strncmp(pLine, marker.text, marker.len) == 0))
+                return marker.section;
+        }
+        else if ((lineLen >= marker.minLen) && (lineLen <= marker.len) &&
+            (strncasecmp(pLine, marker.text, lineLen) == 0))
+            return marker.section;
+    }
     return MapFile::NO_SECTION;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief Checks if a line is the ending line of a section we analyzed.
+/// The line which ends a section may at the same time start the next one.
 /// @param secType Type of the opened section.
 /// @param  pLine Pointer to start of buffer
 /// @param  lineLen Length of the current line
@@ -212,213 +454,722 @@ MapFile::SectionType MapFile::recognizeSectionStart(const char *pLine, size_t li
 ////////////////////////////////////////////////////////////////////////////////
 MapFile::SectionType MapFile::recognizeSectionEnd(MapFile::SectionType secType, const char *pLine, size_t lineLen)
 {
-    switch (secType)
+    if (lineLen < 1)
+        return secType;
+    unsigned int mask = MARKER_DISPATCH.endMask[(unsigned char)pLine[0]];
+    for (size_t i = 0; mask != 0; i++, mask >>= 1)
     {
-    case MapFile::MSVC_MAP:
-        if (strncmp(pLine, MSVC_LINE_NUMBER, std::strlen(MSVC_LINE_NUMBER)) == 0)
-            return MapFile::NO_SECTION;
-        if (strncmp(pLine, MSVC_FIXUP, std::strlen(MSVC_FIXUP)) == 0)
-            return MapFile::NO_SECTION;
-        if (strncmp(pLine, MSVC_EXPORTS, std::strlen(MSVC_EXPORTS)) == 0)
-            return MapFile::NO_SECTION;
-        break;
-    case MapFile::BCCL_NAM_MAP:
-    case MapFile::BCCL_VAL_MAP:
-        break;
-    case MapFile::WATCOM_MAP:
-        if (strncmp(pLine, WATCOM_END_TABLE_HDR, std::strlen(WATCOM_END_TABLE_HDR)) == 0)
-            return MapFile::NO_SECTION;
-        break;
-    case MapFile::GCC_MAP:
-        if (strncmp(pLine, GCC_MEMMAP_END, std::strlen(GCC_MEMMAP_END)) == 0)
-            return MapFile::NO_SECTION;
-        break;
+        const MAPSectionMarker &marker = END_MARKERS[i];
+        if (((mask & 1) != 0) && (marker.section == secType) && (lineLen >= marker.len) &&
+            (strncmp(pLine, marker.text, marker.len) == 0))
+            return recognizeSectionStart(pLine, lineLen);
     }
     return secType;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief Reads one entry of Ms-like MAP file.
-/// @param sym Target  buffer for symbol data.
+/// @brief Checks if a line starts or ends any section.
 /// @param  pLine Pointer to start of buffer
 /// @param  lineLen Length of the current line
-/// @param  minLineLen Minimal accepted length of line
-/// @param numOfSegs Number of segments in IDA, used to verify segment number range
+/// @return True if the line may change section state
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::isSectionMarker(const char *pLine, size_t lineLen)
+{
+    if (lineLen < 1)
+        return false;
+    if (recognizeSectionStart(pLine, lineLen) != MapFile::NO_SECTION)
+        return true;
+    unsigned int mask = MARKER_DISPATCH.endMask[(unsigned char)pLine[0]];
+    for (size_t i = 0; mask != 0; i++, mask >>= 1)
+    {
+        const MAPSectionMarker &marker = END_MARKERS[i];
+        if (((mask & 1) != 0) && (lineLen >= marker.len) &&
+            (strncmp(pLine, marker.text, marker.len) == 0))
+            return true;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives properties of given section type.
+/// @param secType Type of the section
+/// @return Entry of the formats registry; never NULL
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+const MapFile::MAPSectionFormat * MapFile::getSectionFormat(MapFile::SectionType secType)
+{
+    if ((size_t)secType >= sizeof(SECTION_FORMATS) / sizeof(SECTION_FORMATS[0]))
+        secType = MapFile::NO_SECTION;
+    assert(SECTION_FORMATS[secType].section == secType);
+    return &SECTION_FORMATS[secType];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives the line which starts given section, for writing MAP files.
+/// @param secType Type of the section
+/// @return The first start marker of the section, or NULL if there is none
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+const char * MapFile::getSectionStartMarker(MapFile::SectionType secType)
+{
+    for (size_t i = 0; i < sizeof(START_MARKERS) / sizeof(START_MARKERS[0]); i++)
+    {
+        if (START_MARKERS[i].section == secType)
+            return START_MARKERS[i].text;
+    }
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives a line which ends given section, for writing MAP files.
+/// @param secType Type of the section
+/// @return The first end marker of the section, or NULL if there is none
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+const char * MapFile::getSectionEndMarker(MapFile::SectionType secType)
+{
+    for (size_t i = 0; i < sizeof(END_MARKERS) / sizeof(END_MARKERS[0]); i++)
+    {
+        if (END_MARKERS[i].section == secType)
+            return END_MARKERS[i].text;
+    }
+    return NULL;
+}
+
+/// @name Line tokenizing helpers used by the symbol line parsers.
+/// They work directly on the mapped file bytes, without copying the line.
+/// The behaviour of each helper mimics the matching scanf() directive.
+/// @{
+
+/// Checks for white space characters, as isspace() in "C" locale.
+static inline bool isSpaceChr(char c)
+{
+    return (c == ' ') || ((unsigned char)(c - '\t') <= (unsigned char)('\r' - '\t'));
+}
+
+/// Skips white space characters, as the space in scanf() format string.
+static inline const char * skipSpaceChrs(const char * p, const char * pEnd)
+{
+    while ((p < pEnd) && isSpaceChr(*p))
+        p++;
+    return p;
+}
+
+/// Case-insensitive check if the buffer starts with given ASCII text.
+static inline bool hasPrefixNoCase(const char * p, const char * pEnd, const char * prefix, size_t prefixLen)
+{
+    return ((size_t)(pEnd - p) >= prefixLen) && (strncasecmp(p, prefix, prefixLen) == 0);
+}
+
+/// Returns bit 7 set in each byte of the word which is within given range.
+/// Only valid for bytes below 0x80.
+static inline unsigned long long swarBytesInRange(unsigned long long w, unsigned char lo, unsigned char hi)
+{
+    const unsigned long long ones = 0x0101010101010101ULL;
+    unsigned long long geLo = w + ones * (0x80 - lo);
+    unsigned long long gtHi = w + ones * (0x7f - hi);
+    return geLo & ~gtHi & (ones * 0x80);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Decodes a run of hex digits, up to 8 at a time.
+/// Bytes are classified and converted in parallel within a 64-bit word
+/// (SWAR), so there are no per-character branches.
+/// @param p Pointer to the first digit
+/// @param maxDigits Max amount of digits to decode; also the amount of
+///     bytes which can be safely accessed
+/// @param val Out variable to receive the decoded value
+/// @return Amount of digits decoded
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static inline size_t decodeHexRun8(const char * p, size_t maxDigits, unsigned long long &val)
+{
+    const unsigned long long ones = 0x0101010101010101ULL;
+    unsigned long long w = 0;
+    // Missing bytes are zero, which is not a hex digit; assumes little endian
+    memcpy(&w, p, (maxDigits < 8) ? maxDigits : 8);
+    unsigned long long w7 = w & (ones * 0x7f);
+    unsigned long long isHex = (swarBytesInRange(w7, '0', '9') |
+        swarBytesInRange(w7 | (ones * 0x20), 'a', 'f')) & ~w;
+    unsigned long long notHex = ~isHex & (ones * 0x80);
+    size_t n = 8;
+    if (notHex != 0)
+    {
+        n = 0;
+        while ((notHex & 0x80) == 0)
+        {
+            notHex >>= 8;
+            n++;
+        }
+    }
+    if (n > maxDigits)
+        n = maxDigits;
+    if (n == 0)
+    {
+        val = 0;
+        return 0;
+    }
+    // Nibble value of each digit; letters have bit 6 set
+    unsigned long long nib = (w & (ones * 0x0f)) + ((w >> 6) & ones) * 9;
+    // Align digits so that the last one lands in the top byte
+    nib <<= 8 * (8 - n);
+    nib = ((nib << 4) + (nib >> 8)) & 0x00ff00ff00ff00ffULL;
+    nib = ((nib << 8) + (nib >> 16)) & 0x0000ffff0000ffffULL;
+    nib = ((nib << 16) + (nib >> 32)) & 0x00000000ffffffffULL;
+    val = nib;
+    return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads hex number limited to given width, like scanf() "%<width>X".
+/// Leading white spaces are skipped; sign and "0x" prefix are accepted
+/// and count into the width, as scanf() does.
+/// @param p Pointer to start of the field
+/// @param pEnd Pointer to end of the line
+/// @param width Max field width, not including leading spaces
+/// @param val Out variable to receive the value
+/// @return Pointer just after the number, or NULL if no number was found
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static const char * scanHexField(const char * p, const char * pEnd, size_t width, unsigned long long &val)
+{
+    p = skipSpaceChrs(p, pEnd);
+    const char * pLim = ((size_t)(pEnd - p) > width) ? (p + width) : pEnd;
+    bool negative = false;
+    bool haveDigits = false;
+    if ((p < pLim) && ((*p == '-') || (*p == '+')))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+    if ((p < pLim) && (*p == '0'))
+    {
+        haveDigits = true;
+        p++;
+        if ((p < pLim) && ((*p | 0x20) == 'x'))
+            p++;
+    }
+    unsigned long long v = 0;
+    while (p < pLim)
+    {
+        unsigned long long part;
+        size_t n = decodeHexRun8(p, (size_t)(pLim - p), part);
+        if (n == 0)
+            break;
+        v = (n < 8) ? ((v << (4 * n)) | part) : ((v << 32) | part);
+        haveDigits = true;
+        p += n;
+        if (n < 8)
+            break;
+    }
+    if (!haveDigits)
+        return NULL;
+    val = negative ? (0 - v) : v;
+    return p;
+}
+
+/// Reads a non-empty string up to one of terminating chars, like scanf() "%[^...]".
+static inline const char * scanNameField(const char * p, const char * pEnd, bool stopAtSpace, size_t &nameLen)
+{
+    const char * pName = p;
+    while ((p < pEnd) && (*p != '\t') && (*p != '\n') && (*p != ';') && (!stopAtSpace || (*p != ' ')))
+        p++;
+    nameLen = (size_t)(p - pName);
+    return (nameLen > 0) ? p : NULL;
+}
+
+/// Finds object file column of MSVC line, which follows "Rva+Base" column and function flags.
+static inline void scanMsObjectField(const char * p, const char * pEnd, MapFile::MAPSymbolView &sym)
+{
+    // "Rva+Base" must be there, otherwise it is not MSVC map with object files
+    p = skipSpaceChrs(p, pEnd);
+    const char * pField = p;
+    while ((p < pEnd) && isxdigit((unsigned char)*p))
+        p++;
+    if ((p == pField) || ((p < pEnd) && !isSpaceChr(*p)))
+        return;
+    // Skip flags - 'f' for functions, 'i' for inlines; object may be missing
+    for (;;)
+    {
+        p = skipSpaceChrs(p, pEnd);
+        if ((p >= pEnd) || ((*p != 'f') && (*p != 'i')) || ((pEnd - p >= 2) && !isSpaceChr(p[1])))
+            break;
+        p++;
+    }
+    const char * pObjEnd = pEnd;
+    while ((pObjEnd > p) && isSpaceChr(pObjEnd[-1]))
+        pObjEnd--;
+    sym.object = p;
+    sym.objectLen = (size_t)(pObjEnd - p);
+}
+
+/// Checks if a name field starts at given position, so the line is a symbol if its address is valid.
+static inline bool hasNameField(const char * pName, const char * pEnd)
+{
+    return (pName < pEnd) && (*pName != ';');
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks segment and offset of a symbol line against import filter,
+/// before its name is read.
+/// Only lines which would give a valid symbol are rejected, so that the
+/// filter never changes where the section ends.
+/// @param sym The symbol, with segment number as in MAP file and offset set
+/// @param pName Start of the name field
+/// @param pEnd End of the line
+/// @param segs Segments of the target executable, with the filter
+/// @return True if the line is rejected
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static inline bool isFilteredSegAddr(const MapFile::MAPSymbolView &sym, const char * pName, const char * pEnd,
+    MapFile::MAPSegmentCursor &segs)
+{
+    if (!hasNameField(pName, pEnd) || (sym.seg == 0) || (sym.seg > segs.segments().size()) ||
+        ((MapFile::MAPAddress)-1 == sym.addr))
+        return false;
+    return !segs.acceptsAddress(sym.seg - 1, segs.segments().segStart(sym.seg - 1) + sym.addr);
+}
+
+/// Limits the parsed part of a line, as the name in fixed MAPSymbol buffer has limited length.
+static inline size_t cutLineLen(size_t lineLen, size_t minLineLen)
+{
+    return (lineLen > MAXNAMELEN + minLineLen) ? (MAXNAMELEN + minLineLen) : lineLen;
+}
+
+/// @}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads one entry of Ms-like MAP file, without copying the line.
+/// @param sym Target  buffer for symbol data; name will point into the line.
+/// @param  pLine Pointer to start of buffer
+/// @param  lineLen Length of the current line
+/// @param segs Segments of the target executable, used to verify segment number and compute address
 /// @return Result of the parsing
 /// @author TL
-/// @date 2011.09.10
+/// @date 2026.10.17
 ////////////////////////////////////////////////////////////////////////////////
-MapFile::ParseResult MapFile::parseMsSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, size_t numOfSegs)
+MapFile::ParseResult MapFile::parseMsSymbolView(MapFile::MAPSymbolView &sym, const char *pLine, size_t lineLen, MapFile::MAPSegmentCursor &segs)
 {
     // Get segment number, address, name, by pass spaces at beginning,
     // between ':' character, between address and name
-    long lineCut = lineLen;
-    if (lineCut > MAXNAMELEN + minLineLen)
-        lineCut = MAXNAMELEN + minLineLen;
-    char * dupLine = (char *)std::malloc(lineCut+1);
-    strncpy(dupLine,pLine,lineCut);
-    dupLine[lineCut] = '\0';
-    if (strncasecmp(dupLine, ";", 1) == 0)
-    {
-        strncpy(sym.name,dupLine+1,MAXNAMELEN-1);
-        sym.name[MAXNAMELEN] = '\0';
-        std::free(dupLine);
+    const char * pEnd = pLine + lineLen;
+    sym.objectLen = 0;
+    if ((pLine < pEnd) && (*pLine == ';'))
+    {
+        sym.name = pLine + 1;
+        sym.nameLen = (size_t)(pEnd - sym.name);
         return MapFile::COMMENT_LINE;
     }
-    sym.addr = -1;
-    int ret;
-#ifdef __EA64__
-    ret = sscanf(dupLine, " %04lX : %016llX %[^\t\n ;]", &sym.seg, &sym.addr, sym.name);
-#else
-    ret = sscanf(dupLine, " %04lX : %08lX %[^\t\n ;]", &sym.seg, &sym.addr, sym.name);
-#endif
-    std::free(dupLine);
-    if (3 != ret)
+    sym.addr = (MAPAddress)-1;
+    unsigned long long val;
+    // Equivalent of scanf(" %04lX : %08lX %[^\t\n ;]")
+    const char * p = scanHexField(pLine, pEnd, 4, val);
+    if (p != NULL)
+    {
+        sym.seg = (unsigned long)val;
+        p = skipSpaceChrs(p, pEnd);
+        p = ((p < pEnd) && (*p == ':')) ? (p + 1) : NULL;
+    }
+    if (p != NULL)
+    {
+        p = scanHexField(p, pEnd, ADDRESS_FIELD_WIDTH, val);
+    }
+    if (p != NULL)
+    {
+        sym.addr = (MAPAddress)val;
+        sym.name = skipSpaceChrs(p, pEnd);
+        if (segs.filtersAddresses() && isFilteredSegAddr(sym, sym.name, pEnd, segs))
+            return MapFile::FILTERED_LINE;
+        p = scanNameField(sym.name, pEnd, true, sym.nameLen);
+    }
+    if (p == NULL)
     {
         // we have parsed to end of value/name symbols table or reached EOF
         return MapFile::FINISHING_LINE;
     }
-    else if ((0 == sym.seg) || (--sym.seg >= numOfSegs) ||
-            (-1 == sym.addr) || (std::strlen(sym.name) == 0) )
+    else if ((0 == sym.seg) || (--sym.seg >= segs.segments().size()) ||
+            ((MAPAddress)-1 == sym.addr))
     {
         return MapFile::INVALID_LINE;
     }
-    // Ensure name is NULL terminated
-    sym.name[MAXNAMELEN] = '\0';
+    scanMsObjectField(p, pEnd, sym);
+    sym.ea = segs.segments().segStart(sym.seg) + sym.addr;
     return MapFile::SYMBOL_LINE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief Reads one entry of Watcom-like MAP file.
-/// @param sym Target  buffer for symbol data.
+/// @brief Reads one entry of Watcom-like MAP file, without copying the line.
+/// @param sym Target  buffer for symbol data; name will point into the line.
 /// @param  pLine Pointer to start of buffer
 /// @param  lineLen Length of the current line
-/// @param  minLineLen Minimal accepted length of line
-/// @param numOfSegs Number of segments in IDA, used to verify segment number range
+/// @param segs Segments of the target executable, used to verify segment number and compute address
 /// @return Result of the parsing
 /// @author TL
-/// @date 2011.09.10
+/// @date 2026.10.17
 ////////////////////////////////////////////////////////////////////////////////
-MapFile::ParseResult MapFile::parseWatcomSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, size_t numOfSegs)
+MapFile::ParseResult MapFile::parseWatcomSymbolView(MapFile::MAPSymbolView &sym, const char *pLine, size_t lineLen, MapFile::MAPSegmentCursor &segs)
 {
     // Get segment number, address, name, by pass spaces at beginning,
     // between ':' character, between address and name
-    long lineCut = lineLen;
-    if (lineCut > MAXNAMELEN + minLineLen)
-        lineCut = MAXNAMELEN + minLineLen;
-    char * dupLine = (char *)std::malloc(lineCut+1);
-    strncpy(dupLine,pLine,lineCut);
-    dupLine[lineCut] = '\0';
-    if (strncasecmp(dupLine, ";", 1) == 0)
-    {
-        strncpy(sym.name,dupLine+1,MAXNAMELEN-1);
-        sym.name[MAXNAMELEN] = '\0';
-        std::free(dupLine);
+    const char * pEnd = pLine + lineLen;
+    sym.objectLen = 0;
+    if ((pLine < pEnd) && (*pLine == ';'))
+    {
+        sym.name = pLine + 1;
+        sym.nameLen = (size_t)(pEnd - sym.name);
         return MapFile::COMMENT_LINE;
     }
-    if (strncasecmp(dupLine, WATCOM_MEMMAP_SKIP, std::strlen(WATCOM_MEMMAP_SKIP)) == 0)
+    if (hasPrefixNoCase(pLine, pEnd, WATCOM_MEMMAP_SKIP, sizeof(WATCOM_MEMMAP_SKIP) - 1))
     {
-        std::free(dupLine);
         return MapFile::SKIP_LINE;
     }
-    if (strncasecmp(dupLine, WATCOM_MEMMAP_COMMENT, std::strlen(WATCOM_MEMMAP_COMMENT)) == 0)
+    if (hasPrefixNoCase(pLine, pEnd, WATCOM_MEMMAP_MODULE, sizeof(WATCOM_MEMMAP_MODULE) - 1))
     {
-        strncpy(sym.name,dupLine+std::strlen(WATCOM_MEMMAP_COMMENT),MAXNAMELEN-1);
-        sym.name[MAXNAMELEN] = '\0';
-        std::free(dupLine);
-        return MapFile::COMMENT_LINE;
+        // Symbols which follow are defined by this module
+        sym.name = skipSpaceChrs(pLine + sizeof(WATCOM_MEMMAP_MODULE) - 1, pEnd);
+        const char * pNameEnd = pEnd;
+        while ((pNameEnd > sym.name) && isSpaceChr(pNameEnd[-1]))
+            pNameEnd--;
+        sym.nameLen = (size_t)(pNameEnd - sym.name);
+        return MapFile::MODULE_LINE;
     }
-    int ret;
-#ifdef __EA64__
-    ret = sscanf(dupLine, " %04lX : %016llX%*c %[^\t\n;]", &sym.seg, &sym.addr, sym.name);
-#else
-    ret = sscanf(dupLine, " %04lX : %08lX%*c %[^\t\n;]", &sym.seg, &sym.addr, sym.name);
-#endif
-    std::free(dupLine);
-    if (3 != ret)
+    unsigned long long val;
+    // Equivalent of scanf(" %04lX : %08lX%*c %[^\t\n;]")
+    const char * p = scanHexField(pLine, pEnd, 4, val);
+    if (p != NULL)
+    {
+        sym.seg = (unsigned long)val;
+        p = skipSpaceChrs(p, pEnd);
+        p = ((p < pEnd) && (*p == ':')) ? (p + 1) : NULL;
+    }
+    if (p != NULL)
+    {
+        p = scanHexField(p, pEnd, ADDRESS_FIELD_WIDTH, val);
+    }
+    if (p != NULL)
+    {
+        sym.addr = (MAPAddress)val;
+        // Skip the one character after address, usually a '*' or '+' marker
+        p = (p < pEnd) ? (p + 1) : NULL;
+    }
+    if (p != NULL)
+    {
+        sym.name = skipSpaceChrs(p, pEnd);
+        if (segs.filtersAddresses() && isFilteredSegAddr(sym, sym.name, pEnd, segs))
+            return MapFile::FILTERED_LINE;
+        p = scanNameField(sym.name, pEnd, false, sym.nameLen);
+    }
+    if (p == NULL)
     {
         // we have parsed to end of value/name symbols table or reached EOF
         return MapFile::FINISHING_LINE;
     }
-    else if ((0 == sym.seg) || (--sym.seg >= numOfSegs) ||
-            (-1 == sym.addr) || (std::strlen(sym.name) == 0) )
+    else if ((0 == sym.seg) || (--sym.seg >= segs.segments().size()) ||
+            ((MAPAddress)-1 == sym.addr))
     {
         return MapFile::INVALID_LINE;
     }
-    // Ensure name is NULL terminated
-    sym.name[MAXNAMELEN] = '\0';
+    sym.ea = segs.segments().segStart(sym.seg) + sym.addr;
     return MapFile::SYMBOL_LINE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief Reads one entry of GCC-like MAP file.
-/// @param sym Target  buffer for symbol data.
+/// @brief Reads one entry of GCC-like MAP file, without copying the line.
+/// @param sym Target  buffer for symbol data; name will point into the line.
 /// @param  pLine Pointer to start of buffer
 /// @param  lineLen Length of the current line
-/// @param  minLineLen Minimal accepted length of line
-/// @param numOfSegs Number of segments in IDA, used to verify segment number range
+/// @param segs Segments of the target executable, used to verify segment number and compute address
 /// @return Result of the parsing
 /// @author TL
-/// @date 2012.07.18
+/// @date 2026.10.17
 ////////////////////////////////////////////////////////////////////////////////
-MapFile::ParseResult MapFile::parseGccSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, size_t numOfSegs)
+MapFile::ParseResult MapFile::parseGccSymbolView(MapFile::MAPSymbolView &sym, const char *pLine, size_t lineLen, MapFile::MAPSegmentCursor &segs)
 {
     // Get segment number, address, name, by pass spaces at beginning,
     // between ':' character, between address and name
-    long lineCut = lineLen;
-    if (lineCut > MAXNAMELEN + minLineLen)
-        lineCut = MAXNAMELEN + minLineLen;
-    char * dupLine = (char *)std::malloc(lineCut+1);
-    strncpy(dupLine,pLine,lineCut);
-    dupLine[lineCut] = '\0';
-    if (strncasecmp(dupLine, ";", 1) == 0)
-    {
-        strncpy(sym.name,dupLine+1,MAXNAMELEN-1);
-        sym.name[MAXNAMELEN] = '\0';
-        std::free(dupLine);
+    const char * pEnd = pLine + lineLen;
+    sym.objectLen = 0;
+    if ((pLine < pEnd) && (*pLine == ';'))
+    {
+        sym.name = pLine + 1;
+        sym.nameLen = (size_t)(pEnd - sym.name);
         return MapFile::COMMENT_LINE;
     }
-    if ( (strncasecmp(dupLine, GCC_MEMMAP_SKIP1, std::strlen(GCC_MEMMAP_SKIP1)) == 0) ||
-         (strncasecmp(dupLine, GCC_MEMMAP_SKIP2, std::strlen(GCC_MEMMAP_SKIP2)) == 0) )
+    if (hasPrefixNoCase(pLine, pEnd, GCC_MEMMAP_SKIP1, sizeof(GCC_MEMMAP_SKIP1) - 1) ||
+        hasPrefixNoCase(pLine, pEnd, GCC_MEMMAP_SKIP2, sizeof(GCC_MEMMAP_SKIP2) - 1))
     {
-        std::free(dupLine);
         return MapFile::SKIP_LINE;
     }
-    if ( (strncasecmp(dupLine, GCC_MEMMAP_SKIP3, std::strlen(GCC_MEMMAP_SKIP3)) == 0) ||
-         (strncasecmp(dupLine, GCC_MEMMAP_SKIP4, std::strlen(GCC_MEMMAP_SKIP4)) == 0) )
+    if (hasPrefixNoCase(pLine, pEnd, GCC_MEMMAP_SKIP3, sizeof(GCC_MEMMAP_SKIP3) - 1) ||
+        hasPrefixNoCase(pLine, pEnd, GCC_MEMMAP_SKIP4, sizeof(GCC_MEMMAP_SKIP4) - 1))
     {
-        std::free(dupLine);
         return MapFile::SKIP_LINE;
     }
-    if (strncasecmp(dupLine, GCC_MEMMAP_LOAD, std::strlen(GCC_MEMMAP_LOAD)) == 0)
+    if (hasPrefixNoCase(pLine, pEnd, GCC_MEMMAP_LOAD, sizeof(GCC_MEMMAP_LOAD) - 1))
     {
-        strncpy(sym.name,dupLine,MAXNAMELEN-1);
-        sym.name[MAXNAMELEN] = '\0';
-        std::free(dupLine);
+        sym.name = pLine;
+        sym.nameLen = (size_t)(pEnd - sym.name);
         return MapFile::COMMENT_LINE;
     }
-    int ret;
-#ifdef __EA64__
-    unsigned long long linear_addr;
-    ret = sscanf(dupLine, " 0x%016llX%*c %[^\t\n;]", &linear_addr, sym.name);
-#else
-    unsigned long linear_addr;
-    ret = sscanf(dupLine, " 0x%08lX%*c %[^\t\n;]", &linear_addr, sym.name);
-#endif
-    std::free(dupLine);
-    if (2 != ret)
+    unsigned long long val;
+    // Equivalent of scanf(" 0x%016llX%*c %[^\t\n;]")
+    const char * p = skipSpaceChrs(pLine, pEnd);
+    p = ((pEnd - p >= 2) && (p[0] == '0') && (p[1] == 'x')) ? (p + 2) : NULL;
+    if (p != NULL)
+    {
+        p = scanHexField(p, pEnd, ADDRESS_FIELD_WIDTH, val);
+    }
+    if (p != NULL)
+    {
+        // Skip the one character after address
+        p = (p < pEnd) ? (p + 1) : NULL;
+    }
+    if (p != NULL)
+    {
+        sym.name = skipSpaceChrs(p, pEnd);
+        if (segs.filtersAddresses() && hasNameField(sym.name, pEnd) &&
+            segs.findLinear((MAPAddress)val, sym.seg, sym.addr) && !segs.acceptsAddress(sym.seg, (MAPAddress)val))
+            return MapFile::FILTERED_LINE;
+        p = scanNameField(sym.name, pEnd, false, sym.nameLen);
+    }
+    if (p == NULL)
     {
         // we have parsed to end of value/name symbols table or reached EOF
         return MapFile::FINISHING_LINE;
     }
-    linearAddressToSymbolAddr(sym, linear_addr);
-    if ((sym.seg >= numOfSegs) || (-1 == sym.addr) || (std::strlen(sym.name) == 0) )
+    // Convert linear address into seg:offs, using target executable segments list
+    sym.ea = (MAPAddress)val;
+    if (!segs.findLinear(sym.ea, sym.seg, sym.addr))
     {
+        sym.seg = (unsigned long)-1;
+        sym.addr = (MAPAddress)-1;
         return MapFile::INVALID_LINE;
     }
-    // Ensure name is NULL terminated
-    sym.name[MAXNAMELEN] = '\0';
     return MapFile::SYMBOL_LINE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads one line of MSVC line number tables, without copying the line.
+/// A table starts with "Line numbers for obj(source) segment name" header;
+/// lines of "line seg:offset" pairs follow, to be read by parseLineNumbers().
+/// @param sym Target  buffer for the line data; name will point into the line.
+/// @param  pLine Pointer to start of buffer
+/// @param  lineLen Length of the current line
+/// @param segs Segments of the target executable; not used
+/// @return Result of the parsing
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+MapFile::ParseResult MapFile::parseMsLinesView(MapFile::MAPSymbolView &sym, const char *pLine, size_t lineLen, MapFile::MAPSegmentCursor &segs)
+{
+    (void)segs;
+    const char * pEnd = pLine + lineLen;
+    sym.objectLen = 0;
+    if ((lineLen >= sizeof(MSVC_LINE_NUMBER) - 1) &&
+        (strncmp(pLine, MSVC_LINE_NUMBER, sizeof(MSVC_LINE_NUMBER) - 1) == 0))
+    {
+        const char * pObj = pLine + sizeof(MSVC_LINE_NUMBER) - 1;
+        // Source file is within the last parentheses; object may have them
+        // too, like "lib(member)", and so may folder names within the source
+        const char * pSrcEnd = pEnd;
+        while ((pSrcEnd > pObj) && (pSrcEnd[-1] != ')'))
+            pSrcEnd--;
+        const char * pSrc = NULL;
+        if (pSrcEnd > pObj)
+        {
+            pSrcEnd--;
+            int depth = 0;
+            for (const char * p = pSrcEnd - 1; p >= pObj; p--)
+            {
+                if (*p == ')')
+                {
+                    depth++;
+                }
+                else if ((*p == '(') && (depth-- == 0))
+                {
+                    pSrc = p + 1;
+                    break;
+                }
+            }
+        }
+        if (pSrc == NULL)
+        {
+            // No source file given, only the object
+            pSrc = pObj;
+            pSrcEnd = pEnd;
+            while ((pSrcEnd > pSrc) && isSpaceChr(pSrcEnd[-1]))
+                pSrcEnd--;
+        }
+        else
+        {
+            sym.object = pObj;
+            sym.objectLen = (size_t)(pSrc - 1 - pObj);
+        }
+        sym.name = pSrc;
+        sym.nameLen = (size_t)(pSrcEnd - pSrc);
+        return (sym.nameLen > 0) ? MapFile::SOURCE_LINE : MapFile::INVALID_LINE;
+    }
+    if ((pLine < pEnd) && (*pLine >= '0') && (*pLine <= '9'))
+    {
+        sym.name = pLine;
+        sym.nameLen = lineLen;
+        return MapFile::LINE_NUMBERS_LINE;
+    }
+    return MapFile::FINISHING_LINE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads "line seg:offset" pairs of MSVC line number tables.
+/// The pairs are added to the table in order in which they are listed.
+/// @param  pLine Pointer to start of the line
+/// @param  lineLen Length of the line
+/// @param segs Segments of the target executable, used to verify segment number and compute address
+/// @param fileId Source file of the lines, within strings of the owning symbol table
+/// @param lines Target table of source lines
+/// @return Amount of invalid pairs; the line is not read beyond an unreadable pair
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+size_t MapFile::parseLineNumbers(const char *pLine, size_t lineLen, MapFile::MAPSegmentCursor &segs,
+    unsigned int fileId, MapFile::MAPLineTable &lines)
+{
+    const char * pEnd = pLine + lineLen;
+    const char * p = skipSpaceChrs(pLine, pEnd);
+    size_t numInvalid = 0;
+    MapFile::MAPLineEntry entry;
+    entry.fileId = fileId;
+    while (p < pEnd)
+    {
+        // Decimal line number; up to 9 digits cannot overflow
+        const char * pNum = p;
+        unsigned long lineNum = 0;
+        while ((p < pEnd) && (*p >= '0') && (*p <= '9') && (p - pNum < 9))
+            lineNum = lineNum * 10 + (unsigned long)(*p++ - '0');
+        unsigned long long seg = 0;
+        unsigned long long offs = 0;
+        const char * pNext = NULL;
+        if ((p > pNum) && (p < pEnd) && isSpaceChr(*p))
+            pNext = scanHexField(p, pEnd, 4, seg);
+        if (pNext != NULL)
+        {
+            pNext = skipSpaceChrs(pNext, pEnd);
+            pNext = ((pNext < pEnd) && (*pNext == ':')) ? (pNext + 1) : NULL;
+        }
+        if (pNext != NULL)
+            pNext = scanHexField(pNext, pEnd, ADDRESS_FIELD_WIDTH, offs);
+        if ((pNext == NULL) || ((pNext < pEnd) && !isSpaceChr(*pNext)))
+        {
+            numInvalid++;
+            break;
+        }
+        p = skipSpaceChrs(pNext, pEnd);
+        if ((seg == 0) || (seg > segs.segments().size()))
+        {
+            numInvalid++;
+            continue;
+        }
+        entry.ea = segs.segments().segStart((unsigned long)(seg - 1)) + (MapFile::MAPAddress)offs;
+        entry.line = lineNum;
+        if (!segs.acceptsAddress((unsigned long)(seg - 1), entry.ea))
+            continue;
+        lines.append(entry);
+    }
+    return numInvalid;
+}
+
+/// Fills the fixed buffer symbol with data from symbol view.
+static MapFile::ParseResult copySymbolView(MapFile::MAPSymbol &sym, const MapFile::MAPSymbolView &view, MapFile::ParseResult parsed)
+{
+    size_t len;
+    switch (parsed)
+    {
+    case MapFile::COMMENT_LINE:
+    case MapFile::MODULE_LINE:
+        len = (view.nameLen < MAXNAMELEN - 1) ? view.nameLen : (MAXNAMELEN - 1);
+        memcpy(sym.name, view.name, len);
+        sym.name[len] = '\0';
+        break;
+    case MapFile::SYMBOL_LINE:
+    case MapFile::INVALID_LINE:
+        sym.seg = view.seg;
+        sym.addr = view.addr;
+        sym.ea = view.ea;
+        len = (view.nameLen < MAXNAMELEN) ? view.nameLen : MAXNAMELEN;
+        memcpy(sym.name, view.name, len);
+        sym.name[len] = '\0';
+        break;
+    default:
+        break;
+    }
+    return parsed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads one entry of Ms-like MAP file.
+/// @param sym Target  buffer for symbol data.
+/// @param  pLine Pointer to start of buffer
+/// @param  lineLen Length of the current line
+/// @param  minLineLen Minimal accepted length of line
+/// @param segs Segments of the target executable, used to verify segment number and compute address
+/// @return Result of the parsing
+/// @author TL
+/// @date 2011.09.10
+////////////////////////////////////////////////////////////////////////////////
+MapFile::ParseResult MapFile::parseMsSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, MapFile::MAPSegmentCursor &segs)
+{
+    MapFile::MAPSymbolView view;
+    view.seg = sym.seg;
+    view.addr = sym.addr;
+    view.ea = sym.ea;
+    return copySymbolView(sym, view, parseMsSymbolView(view, pLine, cutLineLen(lineLen, minLineLen), segs));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads one entry of Watcom-like MAP file.
+/// @param sym Target  buffer for symbol data.
+/// @param  pLine Pointer to start of buffer
+/// @param  lineLen Length of the current line
+/// @param  minLineLen Minimal accepted length of line
+/// @param segs Segments of the target executable, used to verify segment number and compute address
+/// @return Result of the parsing
+/// @author TL
+/// @date 2011.09.10
+////////////////////////////////////////////////////////////////////////////////
+MapFile::ParseResult MapFile::parseWatcomSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, MapFile::MAPSegmentCursor &segs)
+{
+    MapFile::MAPSymbolView view;
+    view.seg = sym.seg;
+    view.addr = sym.addr;
+    view.ea = sym.ea;
+    return copySymbolView(sym, view, parseWatcomSymbolView(view, pLine, cutLineLen(lineLen, minLineLen), segs));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads one entry of GCC-like MAP file.
+/// @param sym Target  buffer for symbol data.
+/// @param  pLine Pointer to start of buffer
+/// @param  lineLen Length of the current line
+/// @param  minLineLen Minimal accepted length of line
+/// @param segs Segments of the target executable, used to verify segment number and compute address
+/// @return Result of the parsing
+/// @author TL
+/// @date 2012.07.18
+////////////////////////////////////////////////////////////////////////////////
+MapFile::ParseResult MapFile::parseGccSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, MapFile::MAPSegmentCursor &segs)
+{
+    MapFile::MAPSymbolView view;
+    view.seg = sym.seg;
+    view.addr = sym.addr;
+    view.ea = sym.ea;
+    return copySymbolView(sym, view, parseGccSymbolView(view, pLine, cutLineLen(lineLen, minLineLen), segs));
+}
+
+////////////////////////////////////////////////////////////////////////////////
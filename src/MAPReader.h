@@ -19,7 +19,7 @@
 #include  <cstdio>
 
 #define MAXNAMELEN      512
-#define INVALID_MAPFILE_SIZE	(0xffffffff)
+#define INVALID_MAPFILE_SIZE	((size_t)-1)
 
 namespace MapFile {
 
@@ -29,12 +29,16 @@ typedef enum {
     BCCL_NAM_MAP,
     BCCL_VAL_MAP,
     WATCOM_MAP,
-    GCC_MAP
+    GCC_MAP,
+    MSVC_LINES_MAP,     ///< MSVC "Line numbers for" tables, from /MAPINFO:LINES
 } SectionType;
 
+/// Amount of SectionType values.
+const unsigned int SECTION_TYPE_COUNT = MSVC_LINES_MAP + 1;
+
 typedef enum {
     OPEN_NO_ERROR = 0,
-    WIN32_ERROR,
+    OS_ERROR,
     FILE_EMPTY_ERROR,
     FILE_BINARY_ERROR
 } MAPResult;
@@ -45,35 +49,86 @@ typedef enum {
     FINISHING_LINE,
     COMMENT_LINE,
     SYMBOL_LINE,
+    MODULE_LINE,        ///< Start of symbols of a module; the name is the module
+    SOURCE_LINE,        ///< Start of line numbers of a source file; the name is the file, the object is object file
+    LINE_NUMBERS_LINE,  ///< Line numbers and addresses; the name is the whole line, for parseLineNumbers()
+    FILTERED_LINE,      ///< Symbol rejected by import filter; the name may not be read
 } ParseResult;
 
-typedef struct {
-    unsigned long seg;
+/// Amount of ParseResult values.
+const unsigned int PARSE_RESULT_COUNT = FILTERED_LINE + 1;
+
+typedef enum {
+    ADVISE_SEQUENTIAL = 0,
+    ADVISE_WILLNEED,
+    ADVISE_DONTNEED,
+} MAPAdvice;
+
 #ifdef __EA64__
-    unsigned long long addr;
+typedef unsigned long long MAPAddress;
 #else
-    unsigned long addr;
+typedef unsigned long MAPAddress;
 #endif
+
+/// Address field width within MAP files, in hex digits.
+#ifdef __EA64__
+const size_t ADDRESS_FIELD_WIDTH = 16;
+#else
+const size_t ADDRESS_FIELD_WIDTH = 8;
+#endif
+
+class MAPSegmentCursor;
+
+typedef struct {
+    unsigned long seg;
+    MAPAddress addr;
+    MAPAddress ea;          ///< Linear address, segment start plus offset
     char name[MAXNAMELEN + 1];
 } MAPSymbol;
 
-void closeMAP(const void * lpAddr);
+/// Symbol data as a view of the parsed line; the name is not NUL-terminated.
+typedef struct {
+    unsigned long seg;
+    MAPAddress addr;
+    MAPAddress ea;
+    const char * name;
+    size_t nameLen;
+    const char * object;    ///< Object file given in the symbol line, like MSVC "Lib:Object" column
+    size_t objectLen;       ///< Length of the object file name, 0 if the line has none
+} MAPSymbolView;
+
+/// Parser of a single line within symbols section.
+typedef MapFile::ParseResult (*MAPLineParser)(MapFile::MAPSymbolView &sym, const char *pLine, size_t lineLen, MapFile::MAPSegmentCursor &segs);
+
+/// Entry of the registry of supported section types.
+typedef struct {
+    SectionType section;
+    const char * name;
+    MAPLineParser parseLine;    ///< NULL for NO_SECTION
+    bool parseStartLine;        ///< The line which starts the section is also given to parseLine
+} MAPSectionFormat;
+
+void closeMAP(const void * lpAddr, size_t dwSize);
 MAPResult openMAP(const char * lpszFileName, char * &lpMapAddr, size_t &dwSize);
+unsigned long getLastErrorCode(void);
+void adviseMAP(const void * lpAddr, size_t dwSize, MAPAdvice advice);
+size_t releaseMAP(const char * lpMapAddr, size_t relStart, size_t relEnd);
 const char * skipSpaces(const char * pStart, const char * pEnd);
 const char * findEOL(const char * pStart, const char * pEnd);
 MapFile::SectionType recognizeSectionStart(const char *pLine, size_t lineLen);
 MapFile::SectionType recognizeSectionEnd(MapFile::SectionType secType, const char *pLine, size_t lineLen);
-MapFile::ParseResult parseMsSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, size_t numOfSegs);
-MapFile::ParseResult parseWatcomSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, size_t numOfSegs);
-MapFile::ParseResult parseGccSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, size_t numOfSegs);
+bool isSectionMarker(const char *pLine, size_t lineLen);
+const MapFile::MAPSectionFormat * getSectionFormat(MapFile::SectionType secType);
+const char * getSectionStartMarker(MapFile::SectionType secType);
+const char * getSectionEndMarker(MapFile::SectionType secType);
+MapFile::ParseResult parseMsSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, MapFile::MAPSegmentCursor &segs);
+MapFile::ParseResult parseWatcomSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, MapFile::MAPSegmentCursor &segs);
+MapFile::ParseResult parseGccSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, MapFile::MAPSegmentCursor &segs);
+MapFile::ParseResult parseMsSymbolView(MapFile::MAPSymbolView &sym, const char *pLine, size_t lineLen, MapFile::MAPSegmentCursor &segs);
+MapFile::ParseResult parseWatcomSymbolView(MapFile::MAPSymbolView &sym, const char *pLine, size_t lineLen, MapFile::MAPSegmentCursor &segs);
+MapFile::ParseResult parseGccSymbolView(MapFile::MAPSymbolView &sym, const char *pLine, size_t lineLen, MapFile::MAPSegmentCursor &segs);
+MapFile::ParseResult parseMsLinesView(MapFile::MAPSymbolView &sym, const char *pLine, size_t lineLen, MapFile::MAPSegmentCursor &segs);
 
 };
 
-// Converts address in linear form into seg:offs, using target executable sections list
-#ifdef __EA64__
-void linearAddressToSymbolAddr(MapFile::MAPSymbol &sym, unsigned long long linear_addr);
-#else
-void linearAddressToSymbolAddr(MapFile::MAPSymbol &sym, unsigned long linear_addr);
-#endif
-
 #endif
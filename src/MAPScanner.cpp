@@ -0,0 +1,298 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPScanner.cpp
+///     MAP file line splitting routines.
+/// @par Purpose:
+///     Vectorized splitting of MAP file buffer into lines. Single pass over
+///     the buffer finds line ends and NUL characters; the NUL check replaces
+///     separate verification whether the file is a text file.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPScanner.h"
+
+#include  <cstring>
+#include  <cassert>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MAPSCANNER_X86 1
+#include  <emmintrin.h>
+#include  <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include  <intrin.h>
+#endif
+
+#if defined(MAPSCANNER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define MAPSCANNER_TARGET(x) __attribute__((target(x)))
+#else
+#define MAPSCANNER_TARGET(x)
+#endif
+
+namespace MapFile {
+
+/// Amount of bytes analyzed by single call to block masking function.
+const size_t SCAN_BLOCK_SIZE = 64;
+
+/// Function which marks positions of EOL and NUL characters within a block.
+typedef void (*ScanBlockFunc)(const char * p, unsigned long long &eolMask, unsigned long long &nulMask);
+
+};
+
+/// Checks for white space characters, as isspace() in "C" locale.
+static inline bool isBlankChr(char c)
+{
+    return (c == ' ') || ((unsigned char)(c - '\t') <= (unsigned char)('\r' - '\t'));
+}
+
+static void scanBlockScalar(const char * p, unsigned long long &eolMask, unsigned long long &nulMask)
+{
+    unsigned long long eol = 0, nul = 0;
+    for (size_t i = 0; i < MapFile::SCAN_BLOCK_SIZE; i++)
+    {
+        char c = p[i];
+        eol |= (unsigned long long)((c == '\n') || (c == '\r')) << i;
+        nul |= (unsigned long long)(c == '\0') << i;
+    }
+    eolMask = eol;
+    nulMask = nul;
+}
+
+#if defined(MAPSCANNER_X86)
+MAPSCANNER_TARGET("sse2")
+static void scanBlockSse2(const char * p, unsigned long long &eolMask, unsigned long long &nulMask)
+{
+    const __m128i vLF = _mm_set1_epi8('\n');
+    const __m128i vCR = _mm_set1_epi8('\r');
+    const __m128i vNul = _mm_setzero_si128();
+    unsigned long long eol = 0, nul = 0;
+    for (size_t i = 0; i < MapFile::SCAN_BLOCK_SIZE; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        __m128i e = _mm_or_si128(_mm_cmpeq_epi8(v, vLF), _mm_cmpeq_epi8(v, vCR));
+        eol |= (unsigned long long)(unsigned int)_mm_movemask_epi8(e) << i;
+        nul |= (unsigned long long)(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, vNul)) << i;
+    }
+    eolMask = eol;
+    nulMask = nul;
+}
+
+MAPSCANNER_TARGET("avx2")
+static void scanBlockAvx2(const char * p, unsigned long long &eolMask, unsigned long long &nulMask)
+{
+    const __m256i vLF = _mm256_set1_epi8('\n');
+    const __m256i vCR = _mm256_set1_epi8('\r');
+    const __m256i vNul = _mm256_setzero_si256();
+    __m256i v0 = _mm256_loadu_si256((const __m256i *)p);
+    __m256i v1 = _mm256_loadu_si256((const __m256i *)(p + 32));
+    __m256i e0 = _mm256_or_si256(_mm256_cmpeq_epi8(v0, vLF), _mm256_cmpeq_epi8(v0, vCR));
+    __m256i e1 = _mm256_or_si256(_mm256_cmpeq_epi8(v1, vLF), _mm256_cmpeq_epi8(v1, vCR));
+    eolMask = (unsigned long long)(unsigned int)_mm256_movemask_epi8(e0) |
+        ((unsigned long long)(unsigned int)_mm256_movemask_epi8(e1) << 32);
+    nulMask = (unsigned long long)(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v0, vNul)) |
+        ((unsigned long long)(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v1, vNul)) << 32);
+}
+
+/// Checks whether the CPU and OS both support AVX2 instructions.
+static bool cpuHasAvx2(void)
+{
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7)
+        return false;
+    __cpuid(regs, 1);
+    // OSXSAVE and AVX; then check whether OS saves YMM registers
+    if ((regs[2] & ((1 << 27) | (1 << 28))) != ((1 << 27) | (1 << 28)))
+        return false;
+    if ((_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+/// Checks whether the CPU supports SSE2 instructions.
+static bool cpuHasSse2(void)
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    return true;
+#elif defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 1);
+    return (regs[3] & (1 << 26)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2") != 0;
+#endif
+}
+#endif
+
+/// Gives index of the lowest set bit; the value must be non-zero.
+static inline unsigned int lowestBitIndex(unsigned long long v)
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long idx;
+    _BitScanForward64(&idx, v);
+    return (unsigned int)idx;
+#elif defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)__builtin_ctzll(v);
+#else
+    unsigned int idx = 0;
+    while ((v & 1) == 0)
+    {
+        v >>= 1;
+        idx++;
+    }
+    return idx;
+#endif
+}
+
+/// Block masking implementation, and its name.
+typedef struct {
+    MapFile::ScanBlockFunc func;
+    const char * name;
+} ScanBlockImpl;
+
+/// Finds the fastest block masking implementation supported by the CPU.
+static ScanBlockImpl detectScanBlock(void)
+{
+    ScanBlockImpl impl = { scanBlockScalar, "scalar" };
+#if defined(MAPSCANNER_X86)
+    if (cpuHasAvx2())
+    {
+        impl.func = scanBlockAvx2;
+        impl.name = "avx2";
+    } else
+    if (cpuHasSse2())
+    {
+        impl.func = scanBlockSse2;
+        impl.name = "sse2";
+    }
+#endif
+    return impl;
+}
+
+/// Gives the implementation selected for the CPU; detected once, by whichever
+/// parsing thread comes first, as initialization of local static is thread safe.
+static const ScanBlockImpl & selectScanBlock(void)
+{
+    static const ScanBlockImpl selected = detectScanBlock();
+    return selected;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives name of the line scanning implementation selected for the CPU.
+/// @return Name of the implementation, ie. "avx2"
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+const char * MapFile::getLineScannerName(void)
+{
+    return selectScanBlock().name;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Splits a memory buffer into non-blank lines.
+/// Gives the same lines as skipSpaces() followed by findEOL() would, but
+/// scans each byte only once, and also detects NUL characters in the buffer.
+/// @param pStart Pointer to start of buffer; should be start of a line
+/// @param pEnd Pointer to end of buffer
+/// @param lines Target array for the lines found
+/// @param maxLines Size of the target array
+/// @param minLineLen Lines shorter than this length are not stored
+/// @param pNext Out variable to receive pointer where the next scan should start
+/// @param nulFound Out variable set if a NUL character was found; lines
+///     after it are not returned, as the buffer is not a text file
+/// @return Amount of lines stored in the target array
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+size_t MapFile::scanLines(const char * pStart, const char * pEnd, MapFile::MAPLine * lines, size_t maxLines,
+    size_t minLineLen, const char * &pNext, bool &nulFound)
+{
+    assert(pStart != NULL);
+    assert(pEnd != NULL);
+    assert(pStart <= pEnd);
+
+    MapFile::ScanBlockFunc scanBlock = selectScanBlock().func;
+    size_t numLines = 0;
+    const char * pLine = pStart;
+    const char * p = pStart;
+    nulFound = false;
+    while (p < pEnd)
+    {
+        unsigned long long eolMask, nulMask;
+        size_t blockLen = SCAN_BLOCK_SIZE;
+        if ((size_t)(pEnd - p) >= SCAN_BLOCK_SIZE)
+        {
+            scanBlock(p, eolMask, nulMask);
+        } else
+        {
+            // Last, partial block; pad it with characters which are neither EOL nor NUL
+            char tail[SCAN_BLOCK_SIZE];
+            blockLen = (size_t)(pEnd - p);
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, p, blockLen);
+            scanBlockScalar(tail, eolMask, nulMask);
+        }
+        if (nulMask != 0)
+        {
+            // Only report lines which end before the NUL
+            unsigned long long nulBit = nulMask & (0 - nulMask);
+            eolMask &= nulBit - 1;
+            nulFound = true;
+        }
+        while (eolMask != 0)
+        {
+            const char * pEOL = p + lowestBitIndex(eolMask);
+            eolMask &= eolMask - 1;
+            while ((pLine < pEOL) && isBlankChr(*pLine))
+                pLine++;
+            if ((size_t)(pEOL - pLine) >= minLineLen)
+            {
+                if (numLines >= maxLines)
+                {
+                    pNext = pLine;
+                    return numLines;
+                }
+                lines[numLines].start = pLine;
+                lines[numLines].len = (size_t)(pEOL - pLine);
+                numLines++;
+            }
+            pLine = pEOL + 1;
+        }
+        if (nulFound)
+        {
+            pNext = pEnd;
+            return numLines;
+        }
+        p += blockLen;
+    }
+    // Last line, not terminated by EOL
+    while ((pLine < pEnd) && isBlankChr(*pLine))
+        pLine++;
+    if ((size_t)(pEnd - pLine) >= minLineLen)
+    {
+        if (numLines >= maxLines)
+        {
+            pNext = pLine;
+            return numLines;
+        }
+        lines[numLines].start = pLine;
+        lines[numLines].len = (size_t)(pEnd - pLine);
+        numLines++;
+    }
+    pNext = pEnd;
+    return numLines;
+}
+
+////////////////////////////////////////////////////////////////////////////////
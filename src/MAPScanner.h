@@ -0,0 +1,34 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPScanner.h
+///     MAP file line splitting routines header.
+/// @par Purpose:
+///     Vectorized splitting of MAP file buffer into lines.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPSCANNER_H_
+#define MAPSCANNER_H_
+
+#include  <cstdio>
+
+namespace MapFile {
+
+/// Single non-blank line of MAP file, with leading white spaces skipped.
+typedef struct {
+    const char * start;
+    size_t len;
+} MAPLine;
+
+size_t scanLines(const char * pStart, const char * pEnd, MAPLine * lines, size_t maxLines,
+    size_t minLineLen, const char * &pNext, bool &nulFound);
+const char * getLineScannerName(void);
+
+};
+
+#endif
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPSegments.cpp
+///     Snapshot of target executable segments.
+/// @par Purpose:
+///     Resolves segment numbers and linear addresses of MAP file symbols,
+///     without calling IDA API for every symbol.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPSegments.h"
+
+#include  <algorithm>
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes all segments from the map.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPSegmentMap::clear(void)
+{
+    starts.clear();
+    ends.clear();
+    ranges.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds next segment to the map.
+/// @param start Start address of the segment
+/// @param end First address after the segment
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPSegmentMap::append(MapFile::MAPAddress start, MapFile::MAPAddress end)
+{
+    MapFile::MAPSegmentRange range;
+    range.start = start;
+    range.end = end;
+    range.seg = (unsigned long)starts.size();
+    starts.push_back(start);
+    ends.push_back(end);
+    // Empty segment cannot contain any linear address
+    if (start >= end)
+        return;
+    // Segments usually come in order of addresses, so this is an append
+    std::vector<MapFile::MAPSegmentRange>::iterator pos = ranges.end();
+    while ((pos != ranges.begin()) && ((pos - 1)->start > start))
+        --pos;
+    ranges.insert(pos, range);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Finds segment which contains given linear address.
+/// @param linearAddr The linear address
+/// @param hint Index of range found by previous call; updated on success
+/// @param seg Target segment number
+/// @param offs Target offset within the segment
+/// @return True if the segment was found
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPSegmentMap::findLinear(MapFile::MAPAddress linearAddr, size_t &hint,
+    unsigned long &seg, MapFile::MAPAddress &offs) const
+{
+    size_t idx = hint;
+    if ((idx >= ranges.size()) || (linearAddr < ranges[idx].start) || (linearAddr >= ranges[idx].end))
+    {
+        // Find last range which starts at or below the address
+        std::vector<MapFile::MAPSegmentRange>::const_iterator it = std::upper_bound(ranges.begin(), ranges.end(),
+            linearAddr, [](MapFile::MAPAddress addr, const MapFile::MAPSegmentRange &range)
+        {
+            return addr < range.start;
+        });
+        if (it == ranges.begin())
+            return false;
+        idx = (size_t)(it - ranges.begin()) - 1;
+        if (linearAddr >= ranges[idx].end)
+            return false;
+        hint = idx;
+    }
+    seg = ranges[idx].seg;
+    offs = linearAddr - ranges[idx].start;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
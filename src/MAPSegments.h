@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPSegments.h
+///     Snapshot of target executable segments header.
+/// @par Purpose:
+///     Resolves segment numbers and linear addresses of MAP file symbols,
+///     without calling IDA API for every symbol.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPSEGMENTS_H_
+#define MAPSEGMENTS_H_
+
+#include  <cstdio>
+#include  <vector>
+
+#include  "MAPReader.h"
+#include  "MAPFilter.h"
+
+namespace MapFile {
+
+/// Address range of one segment.
+typedef struct {
+    MAPAddress start;
+    MAPAddress end;         ///< First address after the segment
+    unsigned long seg;      ///< Segment number
+} MAPSegmentRange;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief List of segments, taken once before parsing.
+/// Segment numbers are given in order of appending. The map is not modified
+/// while parsing, so it can be shared by all parsing threads.
+////////////////////////////////////////////////////////////////////////////////
+class MAPSegmentMap {
+public:
+    size_t size(void) const { return starts.size(); }
+    bool empty(void) const { return starts.empty(); }
+    void clear(void);
+    void append(MAPAddress start, MAPAddress end);
+    MAPAddress segStart(unsigned long seg) const { return starts[seg]; }
+    MAPAddress segEnd(unsigned long seg) const { return ends[seg]; }
+    bool findLinear(MAPAddress linearAddr, size_t &hint, unsigned long &seg, MAPAddress &offs) const;
+
+private:
+    std::vector<MAPAddress> starts;         ///< Start address, indexed by segment number
+    std::vector<MAPAddress> ends;           ///< End address, indexed by segment number
+    std::vector<MAPSegmentRange> ranges;    ///< Address ranges, sorted by start address
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Segment lookup state of a single parsing thread.
+/// Remembers the last segment hit, as consecutive symbols are usually
+/// within the same segment. Also carries the address part of import filter,
+/// so that line parsers can reject a line as soon as its address is known.
+////////////////////////////////////////////////////////////////////////////////
+class MAPSegmentCursor {
+public:
+    explicit MAPSegmentCursor(const MAPSegmentMap &segMap, const MAPFilter * addrFilter = NULL)
+        : segs(segMap), filter(addrFilter), lastHit(0) {}
+    const MAPSegmentMap & segments(void) const { return segs; }
+    bool findLinear(MAPAddress linearAddr, unsigned long &seg, MAPAddress &offs)
+        { return segs.findLinear(linearAddr, lastHit, seg, offs); }
+    /// Whether lines may be rejected by address; if not, acceptsAddress() need not be called.
+    bool filtersAddresses(void) const { return (filter != NULL); }
+    bool acceptsAddress(unsigned long seg, MAPAddress ea) const
+        { return (filter == NULL) || filter->acceptsAddress(seg, ea); }
+
+private:
+    const MAPSegmentMap &segs;
+    const MAPFilter * filter;   ///< Filter with segment or address conditions, NULL if there are none
+    size_t lastHit;
+};
+
+};
+
+#endif
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPSerialize.h
+///     Helpers of binary serialization header.
+/// @par Purpose:
+///     Little endian and variable length integers, shared by the modules
+///     which store their data in the database or in files.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPSERIALIZE_H_
+#define MAPSERIALIZE_H_
+
+#include  <cstddef>
+#include  <vector>
+
+namespace MapFile {
+
+/// Stores the lowest bytes of unsigned value, lowest first.
+inline void putLE(std::vector<unsigned char> &blob, unsigned long long val, size_t numBytes)
+{
+    for (size_t i = 0; i < numBytes; i++)
+        blob.push_back((unsigned char)(val >> (8 * i)));
+}
+
+inline unsigned long long getLE(const unsigned char * p, size_t numBytes)
+{
+    unsigned long long val = 0;
+    for (size_t i = 0; i < numBytes; i++)
+        val |= (unsigned long long)p[i] << (8 * i);
+    return val;
+}
+
+/// Stores unsigned value in 7-bit groups, lowest first; high bit marks continuation.
+inline void putVarint(std::vector<unsigned char> &blob, unsigned long long val)
+{
+    while (val >= 0x80)
+    {
+        blob.push_back((unsigned char)(val | 0x80));
+        val >>= 7;
+    }
+    blob.push_back((unsigned char)val);
+}
+
+inline bool getVarint(const unsigned char * &p, const unsigned char * pEnd, unsigned long long &val)
+{
+    val = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7)
+    {
+        if (p >= pEnd)
+            return false;
+        unsigned char b = *p++;
+        val |= (unsigned long long)(b & 0x7f) << shift;
+        if ((b & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+};
+
+#endif
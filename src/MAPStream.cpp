@@ -0,0 +1,322 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPStream.cpp
+///     Streaming MAP file reader.
+/// @par Purpose:
+///     Reads MAP file in blocks of complete lines, with bounded memory use,
+///     for pipes and files which cannot be memory mapped.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPStream.h"
+
+#include  <cstring>
+#include  <cerrno>
+#include  <chrono>
+
+#include "stdafx.h"
+
+#if !defined(_WIN32)
+#include  <poll.h>
+#include  <unistd.h>
+#endif
+
+using namespace std;
+
+namespace MapFile {
+
+/// Results of reading one piece of the file.
+enum {
+    READ_DATA = 0,
+    READ_END,           ///< End of file
+    READ_FAILED,
+    READ_WAITING,       ///< No data arrived within STREAM_POLL_MS; check for stop and retry
+};
+
+};
+
+MapFile::MAPStreamReader::MAPStreamReader(void)
+    : dataCapacity(0), fp(NULL), stopping(false), readerDone(true), readError(0), current(-1), carryStart(NULL),
+    carryLen(0), skipLine(false), finished(true), totalRead(0), longLines(0)
+{
+    memset(buffers, 0, sizeof(buffers));
+}
+
+MapFile::MAPStreamReader::~MAPStreamReader(void)
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Opens a file or pipe for reading, and starts reading it in background.
+/// @param fileName Path name of file to open
+/// @return OPEN_NO_ERROR, or OS_ERROR with errorCode() set
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+MapFile::MAPResult MapFile::MAPStreamReader::open(const char * fileName)
+{
+    close();
+    fp = fopen(fileName, "rb");
+    if (fp == NULL)
+    {
+        readError = errno;
+        return OS_ERROR;
+    }
+    // The data is copied into our buffers directly, no need for another one
+    setvbuf(fp, NULL, _IONBF, 0);
+
+    storage.resize(STREAM_MEMORY_LIMIT);
+    size_t bufSize = STREAM_MEMORY_LIMIT / 2;
+    dataCapacity = bufSize - STREAM_CARRY_SIZE;
+    for (int bufNo = 0; bufNo < 2; bufNo++)
+    {
+        buffers[bufNo].base = &storage[bufNo * bufSize];
+        buffers[bufNo].filled = 0;
+        buffers[bufNo].ready = false;
+        buffers[bufNo].last = false;
+    }
+    stopping = false;
+    readerDone = false;
+    readError = 0;
+    current = -1;
+    carryStart = NULL;
+    carryLen = 0;
+    skipLine = false;
+    finished = false;
+    totalRead = 0;
+    longLines = 0;
+    reader = std::thread(&MAPStreamReader::readerThread, this);
+    return OPEN_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Stops the background reading and closes the file.
+/// Does not wait for rest of the data; a pipe is closed with the data unread,
+/// so its writer gets an error on further writes.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPStreamReader::close(void)
+{
+    if (reader.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        changed.notify_all();
+#if defined(_WIN32)
+        // Read of a pipe waits for the writer; cancel it, again if it started after previous try
+        while (!readerDone)
+        {
+            CancelSynchronousIo((HANDLE)reader.native_handle());
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+#endif
+        reader.join();
+    }
+    if (fp != NULL)
+    {
+        fclose(fp);
+        fp = NULL;
+    }
+    finished = true;
+    std::vector<char>().swap(storage);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads a piece of the file, without waiting long for data of a pipe.
+/// @param pData Target buffer
+/// @param len Size of the buffer
+/// @param got Receives amount of data read
+/// @return READ_DATA, READ_END, READ_FAILED with errno set, or READ_WAITING
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+int MapFile::MAPStreamReader::readPiece(char * pData, size_t len, size_t &got)
+{
+    got = 0;
+#if defined(_WIN32)
+    // Blocking read; close() cancels it if needed
+    got = fread(pData, 1, len, fp);
+    if (got > 0)
+        return MapFile::READ_DATA;
+    return ferror(fp) ? MapFile::READ_FAILED : MapFile::READ_END;
+#else
+    int fd = fileno(fp);
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    int numReady = poll(&pfd, 1, MapFile::STREAM_POLL_MS);
+    if (numReady == 0)
+        return MapFile::READ_WAITING;
+    if (numReady < 0)
+        return (errno == EINTR) ? MapFile::READ_WAITING : MapFile::READ_FAILED;
+    ssize_t numRead = read(fd, pData, len);
+    if (numRead < 0)
+        return ((errno == EINTR) || (errno == EAGAIN)) ? MapFile::READ_WAITING : MapFile::READ_FAILED;
+    if (numRead == 0)
+        return MapFile::READ_END;
+    got = (size_t)numRead;
+    return MapFile::READ_DATA;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Fills the buffers in turns, whenever they are not used by the parser.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPStreamReader::readerThread(void)
+{
+    for (int bufNo = 0; ; bufNo ^= 1)
+    {
+        StreamBuffer &buf = buffers[bufNo];
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            changed.wait(guard, [&] { return stopping || (!buf.ready && (current != bufNo)); });
+            if (stopping)
+                break;
+        }
+        char * pData = buf.base + STREAM_CARRY_SIZE;
+        size_t filled = 0;
+        bool last = false;
+        int err = 0;
+        while ((filled < dataCapacity) && !stopping)
+        {
+            size_t len = dataCapacity - filled;
+            if (len > MapFile::STREAM_READ_PIECE)
+                len = MapFile::STREAM_READ_PIECE;
+            size_t got;
+            int res = readPiece(pData + filled, len, got);
+            filled += got;
+            if (res == MapFile::READ_WAITING)
+                continue;
+            if (res != MapFile::READ_DATA)
+            {
+                if (res == MapFile::READ_FAILED)
+                    err = (errno != 0) ? errno : EIO;
+                last = true;
+                break;
+            }
+        }
+        if (stopping)
+            break;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            buf.filled = filled;
+            buf.last = last;
+            buf.ready = true;
+            readError = err;
+            totalRead += filled;
+        }
+        changed.notify_all();
+        if (last)
+            break;
+    }
+    readerDone = true;
+}
+
+/// Finds the last line end within given range.
+static const char * findLastLineEnd(const char * pStart, const char * pEnd)
+{
+    while (pEnd > pStart)
+    {
+        pEnd--;
+        if ((*pEnd == '\n') || (*pEnd == '\r'))
+            return pEnd;
+    }
+    return NULL;
+}
+
+/// Finds the first line end within given range.
+static const char * findFirstLineEnd(const char * pStart, const char * pEnd)
+{
+    for (; pStart < pEnd; pStart++)
+    {
+        if ((*pStart == '\n') || (*pStart == '\r'))
+            return pStart;
+    }
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives next block of the file. The block ends at line boundary, except
+/// for the last one. The data is valid until next call.
+/// @param pStart Receives start of the block
+/// @param pEnd Receives end of the block
+/// @return True if a block was given; false at end of file or on read error,
+///     which can be told apart by failed()
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPStreamReader::nextBlock(const char * &pStart, const char * &pEnd)
+{
+    while (!finished)
+    {
+        int bufNo = (current < 0) ? 0 : (current ^ 1);
+        StreamBuffer &buf = buffers[bufNo];
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            changed.wait(guard, [&] { return buf.ready; });
+        }
+        // Move unfinished line of the previous block before the new data,
+        // then give the previous buffer back to the reading thread
+        char * pData = buf.base + STREAM_CARRY_SIZE;
+        char * pBlock = pData - carryLen;
+        if (carryLen > 0)
+            memmove(pBlock, carryStart, carryLen);
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            buf.ready = false;
+            current = bufNo;
+        }
+        changed.notify_all();
+
+        const char * pBlockEnd = pData + buf.filled;
+        carryLen = 0;
+        if (skipLine)
+        {
+            const char * pEOL = findFirstLineEnd(pBlock, pBlockEnd);
+            skipLine = (pEOL == NULL);
+            pBlock = (char *)((pEOL != NULL) ? pEOL : pBlockEnd);
+        }
+        if (buf.last)
+        {
+            finished = true;
+            if (pBlock >= pBlockEnd)
+                break;
+            pStart = pBlock;
+            pEnd = pBlockEnd;
+            return true;
+        }
+        const char * pEOL = findLastLineEnd(pBlock, pBlockEnd);
+        const char * pCarry = (pEOL != NULL) ? (pEOL + 1) : pBlock;
+        if ((size_t)(pBlockEnd - pCarry) > STREAM_CARRY_SIZE)
+        {
+            // Line does not fit into the carry area; drop it
+            skipLine = true;
+            longLines++;
+        }
+        else
+        {
+            carryStart = pCarry;
+            carryLen = (size_t)(pBlockEnd - pCarry);
+        }
+        if (pEOL == NULL)
+            continue;
+        pStart = pBlock;
+        pEnd = pEOL + 1;
+        return true;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPStream.h
+///     Streaming MAP file reader header.
+/// @par Purpose:
+///     Reads MAP file in blocks of complete lines, with bounded memory use,
+///     for pipes and files which cannot be memory mapped.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPSTREAM_H_
+#define MAPSTREAM_H_
+
+#include  <cstdio>
+#include  <vector>
+#include  <thread>
+#include  <mutex>
+#include  <condition_variable>
+#include  <atomic>
+
+#include  "MAPReader.h"
+
+namespace MapFile {
+
+/// Memory used by the stream buffers, regardless of file size.
+const size_t STREAM_MEMORY_LIMIT = 8 * 1024 * 1024;
+/// Part of each buffer reserved for a line which continues from previous block;
+/// longer lines are skipped.
+const size_t STREAM_CARRY_SIZE = 1024 * 1024;
+/// Largest amount read at once; stop requests are checked between reads.
+const size_t STREAM_READ_PIECE = 1024 * 1024;
+/// Longest wait for data of a pipe before stop request is checked again, in milliseconds.
+const int STREAM_POLL_MS = 100;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads a file sequentially, giving blocks which end at line boundary.
+/// Two buffers are used; while one block is parsed, next one is read in
+/// background. Part of line at end of a block is moved to the next block.
+/// close() may be called at any time, also before all the data was read;
+/// the reading thread notices it between reads, or while waiting for data
+/// of a pipe, so it does not wait for the writer of the pipe to finish.
+/// Rest of the pipe data is not drained; the pipe is closed unread.
+////////////////////////////////////////////////////////////////////////////////
+class MAPStreamReader {
+public:
+    MAPStreamReader(void);
+    ~MAPStreamReader(void);
+    MAPResult open(const char * fileName);
+    void close(void);
+    bool nextBlock(const char * &pStart, const char * &pEnd);
+    bool failed(void) const { return (readError != 0); }
+    unsigned long errorCode(void) const { return (unsigned long)readError; }
+    unsigned long long bytesRead(void) const { return totalRead; }
+    unsigned long linesSkipped(void) const { return longLines; }
+
+private:
+    MAPStreamReader(const MAPStreamReader &);
+    MAPStreamReader & operator=(const MAPStreamReader &);
+
+    /// One of the two buffers; data is read after the carry area.
+    typedef struct {
+        char * base;
+        size_t filled;
+        bool ready;         ///< Filled by the reading thread, not yet taken
+        bool last;          ///< End of file or error reached while filling
+    } StreamBuffer;
+
+    void readerThread(void);
+    int readPiece(char * pData, size_t len, size_t &got);
+
+    std::vector<char> storage;
+    StreamBuffer buffers[2];
+    size_t dataCapacity;
+    FILE * fp;
+    std::thread reader;
+    std::mutex lock;
+    std::condition_variable changed;
+    std::atomic<bool> stopping;     ///< Set by close(), checked by the reading thread between reads
+    std::atomic<bool> readerDone;   ///< Reading thread finished, or was never started
+    int readError;
+    int current;            ///< Buffer given by the last nextBlock(), -1 if none
+    const char * carryStart;
+    size_t carryLen;
+    bool skipLine;          ///< Dropping rest of too long line
+    bool finished;
+    unsigned long long totalRead;
+    unsigned long longLines;
+};
+
+};
+
+#endif
@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPStrings.cpp
+///     Interned string pool.
+/// @par Purpose:
+///     Keeps each distinct string once, within single arena, and identifies
+///     it by 32-bit number; used for symbol names, modules and object files.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPStrings.h"
+#include  "MAPHash.h"
+
+#include  <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include  <xmmintrin.h>
+#define STRING_PREFETCH(p) _mm_prefetch((const char *)(p), _MM_HINT_T0)
+#elif defined(__GNUC__) || defined(__clang__)
+#define STRING_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define STRING_PREFETCH(p)
+#endif
+
+using namespace std;
+
+namespace MapFile {
+
+/// Initial amount of index slots; always a power of 2.
+const size_t STRING_INDEX_MIN_SLOTS = 1024;
+
+};
+
+static inline unsigned int hashString(const char * str, size_t len)
+{
+    return (unsigned int)MapFile::hashBuffer(str, len, 0);
+}
+
+/// Index slot holds hash of the string in upper half, and identifier plus one in lower half.
+static inline unsigned long long makeSlot(unsigned int hash, unsigned int id)
+{
+    return ((unsigned long long)hash << 32) | (unsigned long long)(id + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes all strings from the pool.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPStringPool::clear(void)
+{
+    arena.clear();
+    offs.clear();
+    lens.clear();
+    slots.clear();
+    numIndexed = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Pre-allocates space for given amount of strings.
+/// @param numStrings Expected amount of distinct strings
+/// @param dataSize Expected total size of strings, including terminators
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPStringPool::reserve(size_t numStrings, size_t dataSize)
+{
+    arena.reserve(dataSize);
+    offs.reserve(numStrings);
+    lens.reserve(numStrings);
+    reserveIndex(numStrings);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Exchanges content of this pool with another one, without copying.
+/// @param other The pool to exchange content with
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPStringPool::swap(MapFile::MAPStringPool &other)
+{
+    arena.swap(other.arena);
+    offs.swap(other.offs);
+    lens.swap(other.lens);
+    slots.swap(other.slots);
+    std::swap(numIndexed, other.numIndexed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Frees the index used to find strings.
+/// Strings stay available; the index is rebuilt on next interning.
+/// When names are mostly distinct, the index takes as much memory as
+/// the strings, so it is dropped once parsing is done.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPStringPool::releaseIndex(void)
+{
+    std::vector<unsigned long long>().swap(slots);
+    numIndexed = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Makes sure the index has room for given total amount of strings.
+/// The index is kept at most half full, so that probe sequences stay short.
+/// Slots are moved in order, and a slot can only go to the same position or
+/// to the one shifted by old size, so growing the index does not jump around
+/// memory. Strings loaded by assign() are hashed here, on first use.
+/// @param numStrings Amount of strings the index should be able to hold
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPStringPool::reserveIndex(size_t numStrings)
+{
+    if ((2 * numStrings <= slots.size()) && (numIndexed == offs.size()))
+        return;
+    size_t numSlots = (slots.size() > 0) ? slots.size() : STRING_INDEX_MIN_SLOTS;
+    while (numSlots < 2 * numStrings)
+        numSlots *= 2;
+    std::vector<unsigned long long> oldSlots(numSlots, 0);
+    oldSlots.swap(slots);
+    size_t mask = numSlots - 1;
+    for (size_t oldSlot = 0; oldSlot < oldSlots.size(); oldSlot++)
+    {
+        unsigned long long entry = oldSlots[oldSlot];
+        if (entry == 0)
+            continue;
+        size_t slot = (size_t)(entry >> 32) & mask;
+        while (slots[slot] != 0)
+            slot = (slot + 1) & mask;
+        slots[slot] = entry;
+    }
+    for (; numIndexed < offs.size(); numIndexed++)
+    {
+        unsigned int hash = hashString(&arena[offs[numIndexed]], lens[numIndexed]);
+        size_t slot = hash & mask;
+        while (slots[slot] != 0)
+            slot = (slot + 1) & mask;
+        slots[slot] = makeSlot(hash, (unsigned int)numIndexed);
+    }
+}
+
+unsigned int MapFile::MAPStringPool::insert(const char * str, size_t len, unsigned int hash)
+{
+    size_t mask = slots.size() - 1;
+    size_t slot = hash & mask;
+    for (unsigned long long entry = slots[slot]; entry != 0; entry = slots[slot])
+    {
+        unsigned int id = (unsigned int)entry - 1;
+        if (((unsigned int)(entry >> 32) == hash) && (lens[id] == len) && (memcmp(&arena[offs[id]], str, len) == 0))
+            return id;
+        slot = (slot + 1) & mask;
+    }
+    unsigned int id = (unsigned int)offs.size();
+    offs.push_back(arena.size());
+    lens.push_back((unsigned int)len);
+    arena.insert(arena.end(), str, str + len);
+    arena.push_back('\0');
+    slots[slot] = makeSlot(hash, id);
+    numIndexed++;
+    return id;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives identifier of a string, adding it to the pool if needed.
+/// @param str The string; does not have to be NUL-terminated
+/// @param len Length of the string
+/// @return Identifier of the string within this pool
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+unsigned int MapFile::MAPStringPool::intern(const char * str, size_t len)
+{
+    reserveIndex(offs.size() + 1);
+    return insert(str, len, hashString(str, len));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives identifiers of several strings, adding them to the pool if needed.
+/// All strings are hashed and their index slots prefetched first, then strings
+/// which may already be in the pool get their records prefetched, so that
+/// lookups do not wait for memory one by one.
+/// @param count Amount of strings; at most STRING_BATCH_SIZE
+/// @param strList The strings; do not have to be NUL-terminated
+/// @param lenList Lengths of the strings
+/// @param ids Receives identifiers of the strings within this pool
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPStringPool::internMany(size_t count, const char * const * strList, const size_t * lenList,
+    unsigned int * ids)
+{
+    unsigned int hashes[STRING_BATCH_SIZE];
+    reserveIndex(offs.size() + count);
+    size_t mask = slots.size() - 1;
+    for (size_t i = 0; i < count; i++)
+    {
+        hashes[i] = hashString(strList[i], lenList[i]);
+        STRING_PREFETCH(&slots[hashes[i] & mask]);
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        unsigned long long entry = slots[hashes[i] & mask];
+        if ((entry != 0) && ((unsigned int)(entry >> 32) == hashes[i]))
+        {
+            STRING_PREFETCH(&offs[(unsigned int)entry - 1]);
+            STRING_PREFETCH(&lens[(unsigned int)entry - 1]);
+        }
+    }
+    for (size_t i = 0; i < count; i++)
+        ids[i] = insert(strList[i], lenList[i], hashes[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Replaces content of the pool with given arrays.
+/// Used to load previously stored pool; the data must be already verified,
+/// and the strings must be distinct. The index is built on first interning.
+/// @param numStrings Amount of strings
+/// @param offData Offsets of strings within the data buffer
+/// @param lenData Lengths of strings
+/// @param strData Buffer of NUL-terminated strings
+/// @param strDataLen Size of the data buffer
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPStringPool::assign(size_t numStrings, const unsigned long long * offData, const unsigned int * lenData,
+    const char * strData, size_t strDataLen)
+{
+    clear();
+    arena.assign(strData, strData + strDataLen);
+    offs.assign(offData, offData + numStrings);
+    lens.assign(lenData, lenData + numStrings);
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPStrings.h
+///     Interned string pool header.
+/// @par Purpose:
+///     Keeps each distinct string once, within single arena, and identifies
+///     it by 32-bit number; used for symbol names, modules and object files.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPSTRINGS_H_
+#define MAPSTRINGS_H_
+
+#include  <cstdio>
+#include  <vector>
+
+namespace MapFile {
+
+/// Identifier used where there is no string.
+const unsigned int STRING_NONE = 0xFFFFFFFF;
+/// Maximal amount of strings given to MAPStringPool::internMany() at once.
+const size_t STRING_BATCH_SIZE = 32;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Pool of distinct strings, each one stored once.
+/// Strings are NUL-terminated within the arena, so pointers to them can be
+/// given to C APIs; equal strings always get the same identifier, so they
+/// can be compared and hashed by identifiers.
+////////////////////////////////////////////////////////////////////////////////
+class MAPStringPool {
+public:
+    MAPStringPool(void) : numIndexed(0) {}
+    size_t size(void) const { return offs.size(); }
+    bool empty(void) const { return offs.empty(); }
+    void clear(void);
+    void reserve(size_t numStrings, size_t dataSize);
+    void swap(MAPStringPool &other);
+    void releaseIndex(void);
+    unsigned int intern(const char * str, size_t len);
+    void internMany(size_t count, const char * const * strList, const size_t * lenList, unsigned int * ids);
+    void assign(size_t numStrings, const unsigned long long * offData, const unsigned int * lenData,
+        const char * strData, size_t strDataLen);
+
+    const char * str(unsigned int id) const { return &arena[offs[id]]; }
+    size_t len(unsigned int id) const { return lens[id]; }
+    size_t offset(unsigned int id) const { return offs[id]; }
+    size_t dataSize(void) const { return arena.size(); }
+    const char * data(void) const { return arena.empty() ? NULL : &arena[0]; }
+
+private:
+    unsigned int insert(const char * str, size_t len, unsigned int hash);
+    void reserveIndex(size_t numStrings);
+
+    std::vector<char> arena;
+    std::vector<size_t> offs;
+    std::vector<unsigned int> lens;
+    std::vector<unsigned long long> slots;  ///< Open addressing index, hash and string identifier plus one
+    size_t numIndexed;                      ///< Amount of strings within the index
+};
+
+};
+
+#endif
@@ -0,0 +1,315 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPSymbols.cpp
+///     Symbol table for MAP file entries.
+/// @par Purpose:
+///     Compact storage of symbols parsed from MAP file.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPSymbols.h"
+
+#include  <cstring>
+#include  <algorithm>
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes all symbols from the table.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPSymbolTable::clear(void)
+{
+    segs.clear();
+    addrs.clear();
+    eas.clear();
+    kinds.clear();
+    nameIds.clear();
+    objIds.clear();
+    strs.clear();
+    lineTab.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Pre-allocates space for given amount of symbols.
+/// @param numSymbols Expected amount of symbols
+/// @param numStrings Expected amount of distinct names, modules and object files
+/// @param stringsSize Expected total size of the distinct strings, including terminators
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPSymbolTable::reserve(size_t numSymbols, size_t numStrings, size_t stringsSize)
+{
+    segs.reserve(numSymbols);
+    addrs.reserve(numSymbols);
+    eas.reserve(numSymbols);
+    kinds.reserve(numSymbols);
+    nameIds.reserve(numSymbols);
+    objIds.reserve(numSymbols);
+    strs.reserve(numStrings, stringsSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds a symbol at end of the table.
+/// @param seg Segment index
+/// @param addr Offset within the segment
+/// @param ea Linear address
+/// @param kind How the symbol should be applied
+/// @param name The symbol name; does not have to be NUL-terminated
+/// @param nameLen Length of the name
+/// @param objectId Module or object file, from intern() of this table; STRING_NONE if not known
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPSymbolTable::append(unsigned long seg, MapFile::MAPAddress addr, MapFile::MAPAddress ea, MapFile::SymbolKind kind,
+    const char * name, size_t nameLen, unsigned int objectId)
+{
+    appendInterned(seg, addr, ea, kind, strs.intern(name, nameLen), objectId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds a symbol with already interned name at end of the table.
+/// @param seg Segment index
+/// @param addr Offset within the segment
+/// @param ea Linear address
+/// @param kind How the symbol should be applied
+/// @param nameId The symbol name, from intern() or internMany() of this table
+/// @param objectId Module or object file, from intern() of this table; STRING_NONE if not known
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPSymbolTable::appendInterned(unsigned long seg, MapFile::MAPAddress addr, MapFile::MAPAddress ea,
+    MapFile::SymbolKind kind, unsigned int nameId, unsigned int objectId)
+{
+    segs.push_back(seg);
+    addrs.push_back(addr);
+    eas.push_back(ea);
+    kinds.push_back((unsigned char)kind);
+    nameIds.push_back(nameId);
+    objIds.push_back(objectId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Exchanges content of this table with another one, without copying.
+/// @param other The table to exchange content with
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPSymbolTable::swap(MapFile::MAPSymbolTable &other)
+{
+    segs.swap(other.segs);
+    addrs.swap(other.addrs);
+    eas.swap(other.eas);
+    kinds.swap(other.kinds);
+    nameIds.swap(other.nameIds);
+    objIds.swap(other.objIds);
+    strs.swap(other.strs);
+    lineTab.swap(other.lineTab);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Replaces content of the table with given arrays of symbol fields.
+/// Used to load previously stored table; the data must be already verified.
+/// Source lines are removed, and have to be assigned separately.
+/// @param numSymbols Amount of symbols in each array
+/// @param segData Segment indexes
+/// @param addrData Offsets within segments
+/// @param eaData Linear addresses
+/// @param kindData SymbolKind values
+/// @param nameIdData Identifiers of names within the pool
+/// @param objIdData Identifiers of object files within the pool, or STRING_NONE
+/// @param pool The string pool; its content is moved into the table
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPSymbolTable::assign(size_t numSymbols, const unsigned int * segData, const unsigned long long * addrData,
+    const unsigned long long * eaData, const unsigned char * kindData, const unsigned int * nameIdData,
+    const unsigned int * objIdData, MapFile::MAPStringPool &pool)
+{
+    segs.assign(segData, segData + numSymbols);
+    addrs.assign(addrData, addrData + numSymbols);
+    eas.assign(eaData, eaData + numSymbols);
+    kinds.assign(kindData, kindData + numSymbols);
+    nameIds.assign(nameIdData, nameIdData + numSymbols);
+    objIds.assign(objIdData, objIdData + numSymbols);
+    strs.clear();
+    strs.swap(pool);
+    lineTab.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds all symbols and source lines from another table at end of this table.
+/// Each distinct string of the other table is interned once.
+/// @param other The source table
+/// @param noFileId Source file within this table given to lines of the other
+///     table which have none, STRING_NONE to leave them without file
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPSymbolTable::appendTable(const MapFile::MAPSymbolTable &other, unsigned int noFileId)
+{
+    if (empty() && strs.empty() && lineTab.empty())
+    {
+        *this = other;
+        return;
+    }
+    size_t baseIdx = nameIds.size();
+    segs.insert(segs.end(), other.segs.begin(), other.segs.end());
+    addrs.insert(addrs.end(), other.addrs.begin(), other.addrs.end());
+    eas.insert(eas.end(), other.eas.begin(), other.eas.end());
+    kinds.insert(kinds.end(), other.kinds.begin(), other.kinds.end());
+    nameIds.insert(nameIds.end(), other.nameIds.begin(), other.nameIds.end());
+    objIds.insert(objIds.end(), other.objIds.begin(), other.objIds.end());
+    // Intern strings of the other table in batches, then translate identifiers
+    std::vector<unsigned int> idMap(other.strs.size());
+    const char * batchStrs[STRING_BATCH_SIZE];
+    size_t batchLens[STRING_BATCH_SIZE];
+    for (size_t first = 0; first < idMap.size(); first += STRING_BATCH_SIZE)
+    {
+        size_t count = std::min(STRING_BATCH_SIZE, idMap.size() - first);
+        for (size_t k = 0; k < count; k++)
+        {
+            batchStrs[k] = other.strs.str((unsigned int)(first + k));
+            batchLens[k] = other.strs.len((unsigned int)(first + k));
+        }
+        strs.internMany(count, batchStrs, batchLens, &idMap[first]);
+    }
+    for (size_t i = baseIdx; i < nameIds.size(); i++)
+    {
+        nameIds[i] = idMap[nameIds[i]];
+        if (objIds[i] != STRING_NONE)
+            objIds[i] = idMap[objIds[i]];
+    }
+    lineTab.appendTable(other.lineTab, idMap.empty() ? NULL : &idMap[0], noFileId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes symbols which have no object file, within given range.
+/// Order of the remaining symbols is kept; their strings stay in the pool.
+/// @param first Index of the first symbol of the range
+/// @param count Amount of symbols in the range
+/// @return Amount of removed symbols
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+size_t MapFile::MAPSymbolTable::removeWithoutObject(size_t first, size_t count)
+{
+    size_t dst = first;
+    for (size_t i = first; i < first + count; i++)
+    {
+        if (objIds[i] == STRING_NONE)
+            continue;
+        segs[dst] = segs[i];
+        addrs[dst] = addrs[i];
+        eas[dst] = eas[i];
+        kinds[dst] = kinds[i];
+        nameIds[dst] = nameIds[i];
+        objIds[dst] = objIds[i];
+        dst++;
+    }
+    size_t numRemoved = first + count - dst;
+    if (numRemoved == 0)
+        return 0;
+    segs.erase(segs.begin() + dst, segs.begin() + first + count);
+    addrs.erase(addrs.begin() + dst, addrs.begin() + first + count);
+    eas.erase(eas.begin() + dst, eas.begin() + first + count);
+    kinds.erase(kinds.begin() + dst, kinds.begin() + first + count);
+    nameIds.erase(nameIds.begin() + dst, nameIds.begin() + first + count);
+    objIds.erase(objIds.begin() + dst, objIds.begin() + first + count);
+    return numRemoved;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Lists symbols in order of effective addresses, to apply them in one pass.
+/// Symbols at the same address stay in file order, so the result of applying them
+/// does not change. Consecutive exact duplicates at the same address are dropped.
+/// @param symbols The symbol table
+/// @param sorted Target list of symbol references
+/// @return Amount of duplicates dropped
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+size_t MapFile::sortSymbolsByAddress(const MapFile::MAPSymbolTable &symbols, std::vector<MapFile::MAPSymbolRef> &sorted)
+{
+    sorted.resize(symbols.size());
+    bool isSorted = true;
+    for (size_t symNo = 0; symNo < symbols.size(); symNo++)
+    {
+        MapFile::MAPSymbolRef &ref = sorted[symNo];
+        ref.ea = symbols.ea(symNo);
+        ref.symNo = symNo;
+        if ((symNo > 0) && (ref.ea < sorted[symNo - 1].ea))
+            isSorted = false;
+    }
+    // Files listing symbols by value are already sorted
+    if (!isSorted)
+    {
+        std::sort(sorted.begin(), sorted.end(), [](const MapFile::MAPSymbolRef &a, const MapFile::MAPSymbolRef &b)
+        {
+            return (a.ea < b.ea) || ((a.ea == b.ea) && (a.symNo < b.symNo));
+        });
+    }
+    size_t numKept = 0;
+    for (size_t i = 0; i < sorted.size(); i++)
+    {
+        if (numKept > 0)
+        {
+            const MapFile::MAPSymbolRef &prev = sorted[numKept - 1];
+            size_t symNo = sorted[i].symNo;
+            if ((prev.ea == sorted[i].ea) && (symbols.kind(prev.symNo) == symbols.kind(symNo)) &&
+                (symbols.nameId(prev.symNo) == symbols.nameId(symNo)))
+                continue;
+        }
+        sorted[numKept++] = sorted[i];
+    }
+    size_t numDropped = sorted.size() - numKept;
+    sorted.resize(numKept);
+    return numDropped;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes symbols of all but one MAP file at addresses where the files conflict.
+/// @param fileStarts Index of the first symbol of each file within the merged table,
+///     in ascending order
+/// @param policy Tells which file wins at a conflicting address
+/// @param sorted List of symbol references ordered by address, from sortSymbolsByAddress()
+/// @return Amount of symbols dropped
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+size_t MapFile::resolveAddressConflicts(const std::vector<size_t> &fileStarts, MapFile::MAPMergePolicy policy,
+    std::vector<MapFile::MAPSymbolRef> &sorted)
+{
+    if ((policy == MapFile::MERGE_KEEP_ALL) || (fileStarts.size() < 2))
+        return 0;
+    size_t numKept = 0;
+    size_t refStart = 0;
+    while (refStart < sorted.size())
+    {
+        size_t refEnd = refStart + 1;
+        while ((refEnd < sorted.size()) && (sorted[refEnd].ea == sorted[refStart].ea))
+            refEnd++;
+        // References at one address are ordered by symbol index, so by file
+        size_t winner = (policy == MapFile::MERGE_FIRST_WINS) ? sorted[refStart].symNo : sorted[refEnd - 1].symNo;
+        size_t winFile = (size_t)(std::upper_bound(fileStarts.begin(), fileStarts.end(), winner) - fileStarts.begin());
+        size_t winStart = fileStarts[winFile - 1];
+        size_t winEnd = (winFile < fileStarts.size()) ? fileStarts[winFile] : (size_t)-1;
+        for (size_t i = refStart; i < refEnd; i++)
+        {
+            if ((sorted[i].symNo >= winStart) && (sorted[i].symNo < winEnd))
+                sorted[numKept++] = sorted[i];
+        }
+        refStart = refEnd;
+    }
+    size_t numDropped = sorted.size() - numKept;
+    sorted.resize(numKept);
+    return numDropped;
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPSymbols.h
+///     Symbol table for MAP file entries header.
+/// @par Purpose:
+///     Compact storage of symbols parsed from MAP file.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPSYMBOLS_H_
+#define MAPSYMBOLS_H_
+
+#include  <cstdio>
+#include  <vector>
+
+#include  "MAPReader.h"
+#include  "MAPStrings.h"
+#include  "MAPLines.h"
+
+namespace MapFile {
+
+/// How the symbol should be applied.
+typedef enum {
+    SYMKIND_DEFAULT = 0, ///< Apply as name or comment, depending on plugin options
+    SYMKIND_NAME,        ///< Always apply as name (DeDe function)
+    SYMKIND_COMMENT,     ///< Always apply as comment (DeDe VCL control or method)
+} SymbolKind;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Table of symbols, stored as separate arrays for each field.
+/// Names and object files are interned within a string pool of the table,
+/// so there is no limit on name length, no per-symbol allocation, and
+/// repeated strings are stored once; equal names have equal identifiers.
+////////////////////////////////////////////////////////////////////////////////
+class MAPSymbolTable {
+public:
+    size_t size(void) const { return segs.size(); }
+    bool empty(void) const { return segs.empty(); }
+    void clear(void);
+    void reserve(size_t numSymbols, size_t numStrings, size_t stringsSize);
+    void append(unsigned long seg, MAPAddress addr, MAPAddress ea, SymbolKind kind, const char * name, size_t nameLen,
+        unsigned int objectId = STRING_NONE);
+    void appendInterned(unsigned long seg, MAPAddress addr, MAPAddress ea, SymbolKind kind, unsigned int nameId,
+        unsigned int objectId);
+    unsigned int intern(const char * str, size_t len) { return strs.intern(str, len); }
+    void internMany(size_t count, const char * const * strList, const size_t * lenList, unsigned int * ids)
+        { strs.internMany(count, strList, lenList, ids); }
+    void releaseIndex(void) { strs.releaseIndex(); }
+    void setObjectId(size_t idx, unsigned int objectId) { objIds[idx] = objectId; }
+    void appendTable(const MAPSymbolTable &other, unsigned int noFileId = STRING_NONE);
+    size_t removeWithoutObject(size_t first, size_t count);
+    void swap(MAPSymbolTable &other);
+    void assign(size_t numSymbols, const unsigned int * segData, const unsigned long long * addrData,
+        const unsigned long long * eaData, const unsigned char * kindData, const unsigned int * nameIdData,
+        const unsigned int * objIdData, MAPStringPool &pool);
+
+    unsigned long seg(size_t idx) const { return segs[idx]; }
+    MAPAddress addr(size_t idx) const { return addrs[idx]; }
+    MAPAddress ea(size_t idx) const { return eas[idx]; }
+    SymbolKind kind(size_t idx) const { return (SymbolKind)kinds[idx]; }
+    unsigned int nameId(size_t idx) const { return nameIds[idx]; }
+    const char * name(size_t idx) const { return strs.str(nameIds[idx]); }
+    size_t nameLen(size_t idx) const { return strs.len(nameIds[idx]); }
+    /// Module or object file which defines the symbol, STRING_NONE if not known.
+    unsigned int objectId(size_t idx) const { return objIds[idx]; }
+    const char * object(size_t idx) const { return (objIds[idx] != STRING_NONE) ? strs.str(objIds[idx]) : ""; }
+    size_t objectLen(size_t idx) const { return (objIds[idx] != STRING_NONE) ? strs.len(objIds[idx]) : 0; }
+    const MAPStringPool &strings(void) const { return strs; }
+    /// Source line numbers; source files are within strings of this table.
+    MAPLineTable &lines(void) { return lineTab; }
+    const MAPLineTable &lines(void) const { return lineTab; }
+
+private:
+    std::vector<unsigned long> segs;
+    std::vector<MAPAddress> addrs;
+    std::vector<MAPAddress> eas;
+    std::vector<unsigned char> kinds;
+    std::vector<unsigned int> nameIds;
+    std::vector<unsigned int> objIds;
+    MAPStringPool strs;
+    MAPLineTable lineTab;
+};
+
+/// Reference to a symbol at its effective address.
+typedef struct {
+    MAPAddress ea;
+    size_t symNo;
+} MAPSymbolRef;
+
+/// Which symbols are kept when several MAP files give symbols at the same address.
+typedef enum {
+    MERGE_FIRST_WINS = 0,   ///< Symbols from the file listed first are kept
+    MERGE_LAST_WINS,        ///< Symbols from the file listed last are kept
+    MERGE_KEEP_ALL,         ///< All symbols are kept, and applied in order of files
+} MAPMergePolicy;
+
+size_t sortSymbolsByAddress(const MAPSymbolTable &symbols, std::vector<MAPSymbolRef> &sorted);
+size_t resolveAddressConflicts(const std::vector<size_t> &fileStarts, MAPMergePolicy policy,
+    std::vector<MAPSymbolRef> &sorted);
+
+};
+
+#endif
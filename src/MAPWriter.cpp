@@ -0,0 +1,347 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPWriter.cpp
+///     MAP file writer.
+/// @par Purpose:
+///     Writes symbols as MAP files of MSVC or GCC linkers, in the form
+///     which the MAP file reader accepts. Lines are formatted directly into
+///     a large buffer, without printf(), so writing millions of symbols
+///     takes about as long as the disk needs to store them.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPWriter.h"
+
+#include  <cstring>
+#include  <cerrno>
+
+#include "stdafx.h"
+
+using namespace std;
+
+namespace MapFile {
+
+const char * const WRITE_FORMAT_NAMES[WRITE_FORMAT_COUNT] = { "msvc", "gcc" };
+
+/// Width to which MSVC symbol names are padded, before the Rva+Base column.
+const size_t MSVC_NAME_WIDTH = 26;
+/// Width to which MSVC segment names are padded, before the Class column.
+const size_t MSVC_SEGNAME_WIDTH = 23;
+/// Indentation of GCC symbol lines, and spacing between address and name.
+const char GCC_SYMBOL_INDENT[] = "                ";
+
+};
+
+/// Checks if the name would be read back whole; the reader ends names at these characters.
+static inline bool isNameReadable(const char * name, size_t nameLen, bool spaceAllowed)
+{
+    const char * pEnd = name + nameLen;
+    for (const char * p = name; p < pEnd; p++)
+    {
+        if ((*p == '\t') || (*p == '\n') || (*p == '\r') || (*p == ';') || (!spaceAllowed && (*p == ' ')))
+            return false;
+    }
+    return (nameLen > 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives name of given MAP file format, as accepted by writeFormatFromName().
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+const char * MapFile::writeFormatName(MapFile::MAPWriteFormat fmt)
+{
+    return ((unsigned int)fmt < MapFile::WRITE_FORMAT_COUNT) ? MapFile::WRITE_FORMAT_NAMES[fmt] : "unknown";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Finds MAP file format by its name.
+/// @param name Name of the format, case insensitive
+/// @param fmt Out variable to receive the format
+/// @return True if the name is known
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::writeFormatFromName(const char * name, MapFile::MAPWriteFormat &fmt)
+{
+    for (unsigned int i = 0; i < MapFile::WRITE_FORMAT_COUNT; i++)
+    {
+        if (strcasecmp(name, MapFile::WRITE_FORMAT_NAMES[i]) == 0)
+        {
+            fmt = (MapFile::MAPWriteFormat)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Creates writer to a file.
+/// @param fmt Format of the MAP file
+/// @param outFile The file, opened for writing in binary mode
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+MapFile::MAPWriter::MAPWriter(MapFile::MAPWriteFormat fmt, FILE * outFile)
+    : format(fmt), fp(outFile), buf(ownBuf), numSymbols(0), writeFailed(false), writeErrno(0)
+{
+    buf.reserve(MapFile::WRITE_BUFFER_SIZE + 4096);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Creates writer to text in memory.
+/// @param fmt Format of the MAP file
+/// @param outText The text, to which the MAP file is appended
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+MapFile::MAPWriter::MAPWriter(MapFile::MAPWriteFormat fmt, std::string &outText)
+    : format(fmt), fp(NULL), buf(outText), numSymbols(0), writeFailed(false), writeErrno(0)
+{
+}
+
+void MapFile::MAPWriter::flush(void)
+{
+    if (fp == NULL)
+        return;
+    if (!buf.empty() && (fwrite(buf.data(), 1, buf.size(), fp) != buf.size()) && !writeFailed)
+    {
+        writeFailed = true;
+        writeErrno = errno;
+    }
+    buf.clear();
+}
+
+void MapFile::MAPWriter::endLine(void)
+{
+    // Linkers on Windows end lines with CR LF
+    if (format == MapFile::WRITE_MSVC)
+        buf.push_back('\r');
+    buf.push_back('\n');
+    if ((fp != NULL) && (buf.size() >= MapFile::WRITE_BUFFER_SIZE))
+        flush();
+}
+
+/// Appends hex number with at least given amount of digits.
+void MapFile::MAPWriter::putHex(unsigned long long val, size_t minDigits, bool upper)
+{
+    const char * digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char tmp[16];
+    size_t pos = sizeof(tmp);
+    do {
+        tmp[--pos] = digits[val & 0xF];
+        val >>= 4;
+    } while ((val != 0) || (sizeof(tmp) - pos < minDigits));
+    buf.append(tmp + pos, sizeof(tmp) - pos);
+}
+
+/// Appends string followed by spaces up to given width; longer string is kept whole.
+void MapFile::MAPWriter::putPadded(const char * str, size_t len, size_t width)
+{
+    buf.append(str, len);
+    if (len < width)
+        buf.append(width - len, ' ');
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes lines which start the MAP file, before its segments.
+/// @param moduleName Name of the executable module
+/// @param loadBase Preferred load address of the module
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPWriter::writeHeader(const char * moduleName, MapFile::MAPAddress loadBase)
+{
+    module = (moduleName != NULL) ? moduleName : "";
+    if (format == MapFile::WRITE_GCC)
+    {
+        buf.append("Memory Configuration");
+        endLine();
+        endLine();
+        buf.append("Name             Origin             Length             Attributes");
+        endLine();
+        buf.append("*default*        0x");
+        putHex(0, MapFile::ADDRESS_FIELD_WIDTH, false);
+        buf.append(" 0x");
+        putHex((MapFile::MAPAddress)-1, MapFile::ADDRESS_FIELD_WIDTH, false);
+        endLine();
+        endLine();
+        return;
+    }
+    buf.push_back(' ');
+    buf.append(module);
+    endLine();
+    endLine();
+    buf.append(" Preferred load address is ");
+    putHex(loadBase, 8, true);
+    endLine();
+    endLine();
+    buf.append(" Start         Length     Name                   Class");
+    endLine();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes one entry of the segments table.
+/// GCC map files have no such table, so nothing is written for them.
+/// @param seg Index of the segment
+/// @param start Linear address of the segment start
+/// @param size Size of the segment
+/// @param name Name of the segment
+/// @param isCode True if the segment contains code
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPWriter::writeSegment(unsigned long seg, MapFile::MAPAddress start, MapFile::MAPAddress size,
+    const char * name, bool isCode)
+{
+    (void)start;
+    if (format != MapFile::WRITE_MSVC)
+        return;
+    buf.push_back(' ');
+    putHex(seg + 1, 4, true);
+    buf.append(":00000000 ");
+    putHex(size, 8, true);
+    buf.append("H ");
+    putPadded(name, strlen(name), MapFile::MSVC_SEGNAME_WIDTH);
+    buf.append(isCode ? " CODE" : " DATA");
+    endLine();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes the line which starts symbols section, as recognized by the reader.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPWriter::beginSymbols(void)
+{
+    if (format == MapFile::WRITE_GCC)
+    {
+        buf.append(MapFile::getSectionStartMarker(MapFile::GCC_MAP));
+        endLine();
+        endLine();
+        return;
+    }
+    endLine();
+    buf.append("  ");
+    buf.append(MapFile::getSectionStartMarker(MapFile::MSVC_MAP));
+    endLine();
+    endLine();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Starts symbols of a segment.
+/// In GCC map files, this writes the output section line; names of the
+/// sections start with a dot, so the reader skips the line.
+/// @param seg Index of the segment
+/// @param start Linear address of the segment start
+/// @param size Size of the segment
+/// @param name Name of the segment
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapFile::MAPWriter::beginSegment(unsigned long seg, MapFile::MAPAddress start, MapFile::MAPAddress size,
+    const char * name)
+{
+    if (format != MapFile::WRITE_GCC)
+        return;
+    endLine();
+    size_t nameLen = strlen(name);
+    buf.push_back('.');
+    if (nameLen == 0)
+    {
+        buf.append("seg");
+        putHex(seg + 1, 4, false);
+    }
+    else
+    {
+        if (name[0] == '.')
+            name++, nameLen--;
+        buf.append(name, nameLen);
+    }
+    buf.push_back(' ');
+    if (nameLen < 14)
+        buf.append(14 - nameLen, ' ');
+    buf.append(" 0x");
+    putHex(start, MapFile::ADDRESS_FIELD_WIDTH, false);
+    buf.append("     0x");
+    putHex(size, 1, false);
+    endLine();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes one symbol line.
+/// @param seg Index of the segment
+/// @param addr Offset within the segment
+/// @param ea Linear address of the symbol
+/// @param name Name of the symbol; not terminated
+/// @param nameLen Length of the name
+/// @param isFunc True if the symbol is a function
+/// @return False if the symbol is not written, as its name is empty or would not be read back whole
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPWriter::writeSymbol(unsigned long seg, MapFile::MAPAddress addr, MapFile::MAPAddress ea,
+    const char * name, size_t nameLen, bool isFunc)
+{
+    if (!isNameReadable(name, nameLen, (format == MapFile::WRITE_GCC)))
+        return false;
+    if (format == MapFile::WRITE_GCC)
+    {
+        // Equivalent of printf("                0x%016llx                %s")
+        buf.append(MapFile::GCC_SYMBOL_INDENT, sizeof(MapFile::GCC_SYMBOL_INDENT) - 1);
+        buf.append("0x", 2);
+        putHex(ea, MapFile::ADDRESS_FIELD_WIDTH, false);
+        buf.append(MapFile::GCC_SYMBOL_INDENT, sizeof(MapFile::GCC_SYMBOL_INDENT) - 1);
+        buf.append(name, nameLen);
+    }
+    else
+    {
+        // Equivalent of printf(" %04lX:%08lX       %-26s %08lX f")
+        buf.push_back(' ');
+        putHex(seg + 1, 4, true);
+        buf.push_back(':');
+        putHex(addr, 8, true);
+        buf.append("       ", 7);
+        putPadded(name, nameLen, MapFile::MSVC_NAME_WIDTH);
+        buf.push_back(' ');
+        putHex(ea, 8, true);
+        if (isFunc)
+            buf.append(" f", 2);
+    }
+    endLine();
+    numSymbols++;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes lines which end the MAP file, and flushes the output.
+/// @return False if writing to the file failed
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapFile::MAPWriter::finish(void)
+{
+    endLine();
+    // MSVC symbols section ends with the first line which is not a symbol
+    if (format == MapFile::WRITE_GCC)
+    {
+        buf.append(MapFile::getSectionEndMarker(MapFile::GCC_MAP));
+        buf.append(module);
+        buf.push_back(')');
+        endLine();
+    }
+    flush();
+    if ((fp != NULL) && (fflush(fp) != 0) && !writeFailed)
+    {
+        writeFailed = true;
+        writeErrno = errno;
+    }
+    return !writeFailed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPWriter.h
+///     MAP file writer header.
+/// @par Purpose:
+///     Writes symbols as MAP files of MSVC or GCC linkers, in the form
+///     which the MAP file reader accepts.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPWRITER_H_
+#define MAPWRITER_H_
+
+#include  <cstdio>
+#include  <string>
+
+#include  "MAPReader.h"
+
+namespace MapFile {
+
+/// Format of written MAP file.
+typedef enum {
+    WRITE_MSVC = 0,
+    WRITE_GCC,
+    WRITE_FORMAT_COUNT
+} MAPWriteFormat;
+
+/// Amount of output collected before it is written to file.
+const size_t WRITE_BUFFER_SIZE = 4 * 1024 * 1024;
+
+const char * writeFormatName(MAPWriteFormat fmt);
+bool writeFormatFromName(const char * name, MAPWriteFormat &fmt);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Writer of MAP files, with output collected in large blocks.
+/// Segments are given as 0-based indexes, same as in the symbol table.
+/// Calls are expected in order: writeHeader(), writeSegment() for each
+/// segment, beginSymbols(), then for each segment beginSegment() and
+/// writeSymbol() for its symbols, and finish() at end.
+////////////////////////////////////////////////////////////////////////////////
+class MAPWriter {
+public:
+    MAPWriter(MAPWriteFormat fmt, FILE * outFile);
+    MAPWriter(MAPWriteFormat fmt, std::string &outText);
+    ~MAPWriter(void) { flush(); }
+    void writeHeader(const char * moduleName, MAPAddress loadBase);
+    void writeSegment(unsigned long seg, MAPAddress start, MAPAddress size, const char * name, bool isCode);
+    void beginSymbols(void);
+    void beginSegment(unsigned long seg, MAPAddress start, MAPAddress size, const char * name);
+    bool writeSymbol(unsigned long seg, MAPAddress addr, MAPAddress ea, const char * name, size_t nameLen,
+        bool isFunc);
+    bool finish(void);
+    unsigned long long symbolCount(void) const { return numSymbols; }
+    bool failed(void) const { return writeFailed; }
+    int error(void) const { return writeErrno; }
+
+private:
+    void flush(void);
+    void endLine(void);
+    void putHex(unsigned long long val, size_t minDigits, bool upper);
+    void putPadded(const char * str, size_t len, size_t width);
+
+    MAPWriteFormat format;
+    FILE * fp;              ///< Target file, NULL if writing to text in memory
+    std::string ownBuf;
+    std::string &buf;
+    std::string module;
+    unsigned long long numSymbols;
+    bool writeFailed;
+    int writeErrno;         ///< Value of errno after the first failed write, 0 if none failed
+};
+
+};
+
+#endif
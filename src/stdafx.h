@@ -16,6 +16,7 @@
 #ifndef STDAFX_H_
 #define STDAFX_H_
 
+#if defined(_WIN32)
 #define WIN32_LEAN_AND_MEAN		// Exclude rarely-used stuff from Windows headers
 #define _OBJC_NO_COM
 //#define WINSHLWAPI
@@ -38,6 +39,14 @@
 #pragma comment(lib, "shlwapi.lib")
 
 #define strncasecmp strnicmp
+#define strcasecmp stricmp
+
+#else // POSIX systems (Linux, Mac OS)
+#include <cstddef>
+#include <cstdarg>
+#include <strings.h>
+
+#endif
 
 void pathExtensionSwitch(char * fname, const char * newext, size_t fnbuf_len);
 
@@ -0,0 +1,403 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPGenerator.cpp
+///     Synthetic MAP file generator.
+/// @par Purpose:
+///     Generates MAP files in formats of various linkers, for benchmarking.
+///     The content mimics real linker output, including headers, sections
+///     which are not parsed, invalid entries and comment lines.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPGenerator.h"
+
+#include  <cstring>
+#include  <cstdarg>
+#include  <strings.h>
+
+using namespace std;
+
+namespace MapGen {
+
+const char * const FORMAT_NAMES[FMT_COUNT] = { "msvc", "borland", "watcom", "gcc" };
+
+/// Words used to build identifiers.
+const char * const WORDS[] = {
+    "alloc", "buffer", "cache", "decode", "entry", "frame", "graph", "handle",
+    "index", "join", "kernel", "list", "map", "node", "object", "parse",
+    "queue", "render", "stream", "table", "update", "vector", "widget", "xform",
+};
+
+/// Small, reproducible pseudo-random number generator.
+typedef struct {
+    unsigned long long state;
+} Random;
+
+};
+
+static unsigned long nextRandom(MapGen::Random &rnd)
+{
+    // xorshift64*
+    rnd.state ^= rnd.state >> 12;
+    rnd.state ^= rnd.state << 25;
+    rnd.state ^= rnd.state >> 27;
+    return (unsigned long)((rnd.state * 2685821657736338717ULL) >> 32);
+}
+
+static const char * randomWord(MapGen::Random &rnd)
+{
+    return MapGen::WORDS[nextRandom(rnd) % (sizeof(MapGen::WORDS) / sizeof(MapGen::WORDS[0]))];
+}
+
+static void appendf(std::string &out, const char * format, ...)
+{
+    char buf[256];
+    va_list va;
+    va_start(va, format);
+    int len = vsnprintf(buf, sizeof(buf), format, va);
+    va_end(va);
+    if (len > 0)
+        out.append(buf, ((size_t)len < sizeof(buf)) ? (size_t)len : (sizeof(buf) - 1));
+}
+
+/// Appends a line with given content and the selected line ending.
+static void appendLine(std::string &out, const MapGen::GenOptions &opts, const std::string &line)
+{
+    out.append(line);
+    out.append(opts.crlf ? "\r\n" : "\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Creates a symbol name mangled in the style of given compiler.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void makeSymbolName(const MapGen::GenOptions &opts, MapGen::Random &rnd, unsigned long idx, std::string &name)
+{
+    const char * w1 = randomWord(rnd);
+    const char * w2 = randomWord(rnd);
+    // Long names are nested template instantiations, as in real C++ code
+    unsigned long depth = opts.longNames ? (2 + nextRandom(rnd) % 24) : 0;
+    name.clear();
+    switch (opts.format)
+    {
+    case MapGen::FMT_MSVC:
+        appendf(name, "?%s%lu@", w1, idx);
+        for (unsigned long i = 0; i < depth; i++)
+            appendf(name, "?$%s@V?$%s_impl@", randomWord(rnd), randomWord(rnd));
+        appendf(name, "%s@@QAEXH@Z", w2);
+        break;
+    case MapGen::FMT_BORLAND:
+        appendf(name, "@%s@", w1);
+        for (unsigned long i = 0; i < depth; i++)
+            appendf(name, "%%%s$t%s%%", randomWord(rnd), randomWord(rnd));
+        appendf(name, "%s%lu$qv", w2, idx);
+        break;
+    case MapGen::FMT_WATCOM:
+        if ((idx % 3) == 0)
+        {
+            appendf(name, "%s_%s%lu_", w1, w2, idx);
+            break;
+        }
+        appendf(name, "W?%s%lu$", w1, idx);
+        for (unsigned long i = 0; i < depth; i++)
+            appendf(name, ":%s$", randomWord(rnd));
+        appendf(name, "n(pn$%s$$)v", w2);
+        break;
+    case MapGen::FMT_GCC:
+    default:
+        appendf(name, "_ZN%u%s", (unsigned int)strlen(w1), w1);
+        for (unsigned long i = 0; i < depth; i++)
+        {
+            const char * w = randomWord(rnd);
+            appendf(name, "%u%sI", (unsigned int)strlen(w), w);
+        }
+        for (unsigned long i = 0; i < depth; i++)
+            name.append("E");
+        appendf(name, "%u%s%luEv", (unsigned int)(strlen(w2) + 1 + (idx > 9 ? 1 : 0) + (idx > 99 ? 1 : 0)), w2, idx);
+        break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Creates MSVC line number tables, as from /MAPINFO:LINES option.
+/// Tables of source files follow in order of addresses; every 8th table is
+/// of inline functions from a header, with addresses within earlier code.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void generateMsvcLines(const MapGen::GenOptions &opts, MapGen::Random &rnd, std::string &out)
+{
+    std::string line;
+    unsigned long long offs = 0x1000;
+    unsigned long pairNo = 0;
+    for (unsigned long tableNo = 0; pairNo < opts.numLines; tableNo++)
+    {
+        bool header = ((tableNo % 8) == 7);
+        const char * word = randomWord(rnd);
+        line.clear();
+        if (header)
+            appendf(line, "Line numbers for .\\Release\\%s%lu.obj(c:\\src\\include\\%s.h) segment .text",
+                word, tableNo - 1, word);
+        else
+            appendf(line, "Line numbers for .\\Release\\%s%lu.obj(c:\\src\\%s%lu.cpp) segment .text",
+                word, tableNo, word, tableNo);
+        appendLine(out, opts, line);
+        appendLine(out, opts, "");
+        unsigned long long lineOffs = header ? (offs / 2) : offs;
+        unsigned long lineNum = 1 + nextRandom(rnd) % 200;
+        unsigned long numPairs = 16 + nextRandom(rnd) % 512;
+        if (numPairs > opts.numLines - pairNo)
+            numPairs = opts.numLines - pairNo;
+        line.clear();
+        for (unsigned long i = 0; i < numPairs; i++)
+        {
+            appendf(line, "%6lu 0001:%08llX", lineNum, lineOffs);
+            lineNum += 1 + nextRandom(rnd) % 4;
+            lineOffs += 1 + nextRandom(rnd) % 8;
+            if (((i % 4) == 3) || (i + 1 == numPairs))
+            {
+                appendLine(out, opts, line);
+                line.clear();
+            }
+        }
+        appendLine(out, opts, "");
+        if (!header)
+            offs = lineOffs;
+        pairNo += numPairs;
+    }
+}
+
+static void generateMsvc(const MapGen::GenOptions &opts, MapGen::Random &rnd, std::string &out, bool borland)
+{
+    std::string line, name;
+    appendLine(out, opts, " program");
+    appendLine(out, opts, "");
+    appendLine(out, opts, " Timestamp is 5e8f2c3a (Thu Apr 09 12:00:00 2020)");
+    appendLine(out, opts, "");
+    appendLine(out, opts, " Preferred load address is 00400000");
+    appendLine(out, opts, "");
+    appendLine(out, opts, " Start         Length     Name                   Class");
+    appendLine(out, opts, " 0001:00000000 00f00000H .text                   CODE");
+    appendLine(out, opts, " 0002:00000000 00100000H .rdata                  DATA");
+    appendLine(out, opts, " 0003:00000000 00100000H .data                   DATA");
+    appendLine(out, opts, "");
+    if (borland)
+        appendLine(out, opts, "  Address         Publics by Name");
+    else
+        appendLine(out, opts, "  Address         Publics by Value              Rva+Base       Lib:Object");
+    appendLine(out, opts, "");
+    if (!borland)
+        appendLine(out, opts, " 0000:00000000       __except_list              00000000     <absolute>");
+    unsigned long long offs = 0x1000;
+    for (unsigned long i = 0; i < opts.numSymbols; i++)
+    {
+        unsigned long seg = 1 + ((i * 4) / (opts.numSymbols + 1)) % 3;
+        makeSymbolName(opts, rnd, i, name);
+        offs += 2 + nextRandom(rnd) % 64;
+        line.clear();
+        if (borland)
+            appendf(line, " %04lX:%08llX       ", seg, offs);
+        else
+            appendf(line, " %04lX:%08llX       ", seg, offs);
+        line.append(name);
+        if (!borland)
+        {
+            appendf(line, " %08llX %c   ", 0x401000ULL + offs, (seg == 1) ? 'f' : ' ');
+            appendf(line, "lib%s:%s%lu.obj", randomWord(rnd), randomWord(rnd), i % 512);
+        }
+        appendLine(out, opts, line);
+    }
+    appendLine(out, opts, "");
+    if (borland)
+    {
+        appendLine(out, opts, "Program entry point at 0001:00001000");
+        return;
+    }
+    appendLine(out, opts, " entry point at        0001:00001000");
+    appendLine(out, opts, "");
+    appendLine(out, opts, " Static symbols");
+    appendLine(out, opts, "");
+    for (unsigned long i = 0; i < opts.numSymbols / 16; i++)
+    {
+        line.clear();
+        appendf(line, " 0001:%08lX       _static_%s%lu  %08lX f   %s.obj", 0x1000 + i * 16, randomWord(rnd), i,
+            0x401000 + i * 16, randomWord(rnd));
+        appendLine(out, opts, line);
+    }
+    appendLine(out, opts, "");
+    if (opts.numLines > 0)
+    {
+        generateMsvcLines(opts, rnd, out);
+    }
+    else
+    {
+        appendLine(out, opts, "Line numbers for .\\Release\\main.obj(c:\\src\\main.cpp) segment .text");
+        appendLine(out, opts, "");
+        appendLine(out, opts, "    12 0001:00001000    13 0001:00001004    14 0001:0000100a    15 0001:00001010");
+        appendLine(out, opts, "");
+    }
+    appendLine(out, opts, "FIXUPS: 1000 4 10 8 c");
+}
+
+static void generateWatcom(const MapGen::GenOptions &opts, MapGen::Random &rnd, std::string &out)
+{
+    std::string line, name;
+    appendLine(out, opts, "Open Watcom Linker Version 1.9");
+    appendLine(out, opts, "Created on:       20/04/09 12:00:00");
+    appendLine(out, opts, "Executable Image: program.exe");
+    appendLine(out, opts, "");
+    appendLine(out, opts, "                        +------------+");
+    appendLine(out, opts, "                        |   Groups   |");
+    appendLine(out, opts, "                        +------------+");
+    appendLine(out, opts, "");
+    appendLine(out, opts, "Group                           Address              Size");
+    appendLine(out, opts, "=====                           =======              ====");
+    appendLine(out, opts, "DGROUP                          0002:00000000        00100000");
+    appendLine(out, opts, "");
+    appendLine(out, opts, "                        +----------------+");
+    appendLine(out, opts, "                        |   Memory Map   |");
+    appendLine(out, opts, "                        +----------------+");
+    appendLine(out, opts, "");
+    appendLine(out, opts, "* = unreferenced symbol");
+    appendLine(out, opts, "+ = symbol only referenced locally");
+    appendLine(out, opts, "");
+    appendLine(out, opts, "Address        Symbol");
+    appendLine(out, opts, "=======        ======");
+    appendLine(out, opts, "");
+    unsigned long long offs = 0x10;
+    for (unsigned long i = 0; i < opts.numSymbols; i++)
+    {
+        if ((i % 24) == 0)
+        {
+            line.clear();
+            appendf(line, "Module: %s%lu.obj(c:\\src\\%s%lu.c)", randomWord(rnd), i / 24, randomWord(rnd), i / 24);
+            appendLine(out, opts, line);
+        }
+        unsigned long seg = 1 + ((i * 2) / (opts.numSymbols + 1));
+        static const char markers[] = "  *+";
+        makeSymbolName(opts, rnd, i, name);
+        offs += 2 + nextRandom(rnd) % 64;
+        line.clear();
+        appendf(line, "%04lX:%08llX%c ", seg, offs, markers[nextRandom(rnd) % 4]);
+        line.append(name);
+        appendLine(out, opts, line);
+    }
+    appendLine(out, opts, "");
+    appendLine(out, opts, "");
+    appendLine(out, opts, "                        +----------------------+");
+    appendLine(out, opts, "                        |   Imported Symbols   |");
+    appendLine(out, opts, "                        +----------------------+");
+    appendLine(out, opts, "");
+    appendLine(out, opts, "Symbol                              Module");
+    appendLine(out, opts, "======                              ======");
+    appendLine(out, opts, "__imp_ExitProcess                   KERNEL32.DLL");
+}
+
+static void generateGcc(const MapGen::GenOptions &opts, MapGen::Random &rnd, std::string &out)
+{
+    std::string line, name;
+    appendLine(out, opts, "Archive member included to satisfy reference by file (symbol)");
+    appendLine(out, opts, "");
+    appendLine(out, opts, "/usr/lib/libc.a(printf.o)    main.o (printf)");
+    appendLine(out, opts, "");
+    appendLine(out, opts, "Memory Configuration");
+    appendLine(out, opts, "");
+    appendLine(out, opts, "Name             Origin             Length             Attributes");
+    appendLine(out, opts, "*default*        0x0000000000000000 0xffffffffffffffff");
+    appendLine(out, opts, "");
+    appendLine(out, opts, "Linker script and memory map");
+    appendLine(out, opts, "");
+    appendLine(out, opts, "LOAD /usr/lib/x86_64-linux-gnu/crt1.o");
+    appendLine(out, opts, "LOAD main.o");
+    appendLine(out, opts, "                0x0000000000400000                PROVIDE (__executable_start = SEGMENT_START (\"text-segment\", 0x400000))");
+    appendLine(out, opts, "");
+    appendLine(out, opts, ".text           0x0000000000401000   0xf00000");
+    appendLine(out, opts, " *(.text.unlikely .text.*_unlikely .text.unlikely.*)");
+    unsigned long long addr = 0x401000;
+    for (unsigned long i = 0; i < opts.numSymbols; i++)
+    {
+        if ((i % 16) == 0)
+        {
+            line.clear();
+            appendf(line, " .text          0x%016llx      0x%lx %s%lu.o", addr, 0x400UL, randomWord(rnd), i / 16);
+            appendLine(out, opts, line);
+        }
+        makeSymbolName(opts, rnd, i, name);
+        line.clear();
+        appendf(line, "                0x%016llx                ", addr);
+        line.append(name);
+        appendLine(out, opts, line);
+        addr += 2 + nextRandom(rnd) % 64;
+    }
+    appendLine(out, opts, "");
+    appendLine(out, opts, ".comment        0x0000000000000000       0x2b");
+    appendLine(out, opts, "OUTPUT(program elf64-x86-64)");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives name of given MAP file format.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+const char * MapGen::formatName(MapGen::MapFormat format)
+{
+    return (format < FMT_COUNT) ? FORMAT_NAMES[format] : "unknown";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Finds MAP file format by its name.
+/// @return True if the name was recognized
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+bool MapGen::formatFromName(const char * name, MapGen::MapFormat &format)
+{
+    for (int i = 0; i < FMT_COUNT; i++)
+    {
+        if (strcasecmp(name, FORMAT_NAMES[i]) == 0)
+        {
+            format = (MapFormat)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Generates MAP file content.
+/// @param opts Generator options
+/// @param out Target buffer; the content is appended to it
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapGen::generateMap(const MapGen::GenOptions &opts, std::string &out)
+{
+    MapGen::Random rnd;
+    rnd.state = 0x9E3779B97F4A7C15ULL ^ opts.seed;
+    // Reserve approximate size, to avoid re-allocations
+    out.reserve(out.size() + (size_t)opts.numSymbols * (opts.longNames ? 320 : 72) + (size_t)opts.numLines * 21);
+    switch (opts.format)
+    {
+    case FMT_MSVC:
+        generateMsvc(opts, rnd, out, false);
+        break;
+    case FMT_BORLAND:
+        generateMsvc(opts, rnd, out, true);
+        break;
+    case FMT_WATCOM:
+        generateWatcom(opts, rnd, out);
+        break;
+    case FMT_GCC:
+    default:
+        generateGcc(opts, rnd, out);
+        break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
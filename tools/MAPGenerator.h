@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPGenerator.h
+///     Synthetic MAP file generator header.
+/// @par Purpose:
+///     Generates MAP files in formats of various linkers, for benchmarking.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPGENERATOR_H_
+#define MAPGENERATOR_H_
+
+#include  <cstdio>
+#include  <string>
+
+namespace MapGen {
+
+typedef enum {
+    FMT_MSVC = 0,
+    FMT_BORLAND,
+    FMT_WATCOM,
+    FMT_GCC,
+    FMT_COUNT
+} MapFormat;
+
+typedef struct {
+    MapFormat format;
+    unsigned long numSymbols;
+    bool crlf;              ///< Use "\r\n" line endings instead of "\n"
+    bool longNames;         ///< Generate long, deeply templated mangled names
+    unsigned long numLines; ///< Line number pairs within MSVC "Line numbers for" tables; 0 for one short table
+    unsigned long seed;
+} GenOptions;
+
+const char * formatName(MapFormat format);
+bool formatFromName(const char * name, MapFormat &format);
+void generateMap(const GenOptions &opts, std::string &out);
+
+};
+
+#endif
@@ -0,0 +1,751 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPReference.cpp
+///     Reference MAP file parser.
+/// @par Purpose:
+///     Keeps the original sscanf() based line parsers, and compares output
+///     of the current parser with them on whole files and on mutated lines.
+///     Any change in parsing which is not listed here as intended, is
+///     reported as a mismatch.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  "MAPReference.h"
+
+#include  <cstdlib>
+#include  <cstring>
+#include  <cctype>
+#include  <strings.h>
+#include  <algorithm>
+
+using namespace std;
+
+namespace MapRef {
+
+const char WATCOM_MEMMAP_SKIP[]     = "=======        ======";
+const char WATCOM_MEMMAP_COMMENT[]  = "Module: ";
+const char GCC_MEMMAP_SKIP1[]       = ".";
+const char GCC_MEMMAP_SKIP2[]       = " .";
+const char GCC_MEMMAP_SKIP3[]       = "*";
+const char GCC_MEMMAP_SKIP4[]       = " *";
+const char GCC_MEMMAP_LOAD[]        = "LOAD ";
+const char MSVC_LINE_NUMBER[]       = "Line numbers for ";
+
+/// Characters used to mutate lines; the ones which are meaningful to the parsers are repeated.
+const char FUZZ_CHARS[] = "0123456789ABCDEFabcdef:::   \t\t;;xX0x+-*.@?$_<>()~rR\r\v\f";
+/// Maximal amount of mutations done on one line.
+const unsigned int FUZZ_MAX_MUTATIONS = 4;
+
+/// Line within a symbols section, kept to be mutated.
+typedef struct {
+    MapFile::SectionType section;
+    const char * start;
+    size_t len;
+} RefLine;
+
+/// Source line number found by the reference parser.
+typedef struct {
+    MapFile::MAPAddress ea;
+    unsigned long line;
+    std::string source;
+} RefLineNumber;
+
+/// Small, reproducible pseudo-random number generator.
+typedef struct {
+    unsigned long long state;
+} Random;
+
+};
+
+static unsigned long nextRandom(MapRef::Random &rnd)
+{
+    // xorshift64*
+    rnd.state ^= rnd.state >> 12;
+    rnd.state ^= rnd.state << 25;
+    rnd.state ^= rnd.state >> 27;
+    return (unsigned long)((rnd.state * 2685821657736338717ULL) >> 32);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Copies name found by sscanf() into the symbol.
+/// The original parsers scanned directly into the symbol, which could overflow
+/// it; here the name is scanned into a buffer of line size, and then cut the
+/// same way the original cut it.
+////////////////////////////////////////////////////////////////////////////////
+static void copyScannedName(MapFile::MAPSymbol &sym, const char * name)
+{
+    strncpy(sym.name, name, MAXNAMELEN);
+    // Ensure name is NULL terminated
+    sym.name[MAXNAMELEN] = '\0';
+}
+
+static void copyCommentName(MapFile::MAPSymbol &sym, const char * name)
+{
+    strncpy(sym.name, name, MAXNAMELEN-1);
+    sym.name[MAXNAMELEN-1] = '\0';
+    sym.name[MAXNAMELEN] = '\0';
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Converts linear address into segment number and offset.
+/// Equivalent of get_segm_num() and getnseg() calls of the original plugin.
+////////////////////////////////////////////////////////////////////////////////
+static void linearAddressToSymbolAddr(MapFile::MAPSymbol &sym, MapFile::MAPAddress linear_addr, const MapFile::MAPSegmentMap &segs)
+{
+    for (unsigned long seg = 0; seg < segs.size(); seg++)
+    {
+        if ((linear_addr >= segs.segStart(seg)) && (linear_addr < segs.segEnd(seg)))
+        {
+            sym.seg = seg;
+            sym.addr = linear_addr - segs.segStart(seg);
+            return;
+        }
+    }
+    sym.seg = (unsigned long)-1;
+    sym.addr = (MapFile::MAPAddress)-1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads one entry of Ms-like MAP file, the original way.
+/// @param sym Target  buffer for symbol data.
+/// @param  pLine Pointer to start of buffer
+/// @param  lineLen Length of the current line
+/// @param  minLineLen Minimal accepted length of line
+/// @param segs Segments, used to verify segment number range
+/// @return Result of the parsing
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+MapFile::ParseResult MapRef::parseMsSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, const MapFile::MAPSegmentMap &segs)
+{
+    size_t numOfSegs = segs.size();
+    // Get segment number, address, name, by pass spaces at beginning,
+    // between ':' character, between address and name
+    size_t lineCut = lineLen;
+    if (lineCut > MAXNAMELEN + minLineLen)
+        lineCut = MAXNAMELEN + minLineLen;
+    char * dupLine = (char *)std::malloc(lineCut+1);
+    char * name = (char *)std::malloc(lineCut+1);
+    strncpy(dupLine,pLine,lineCut);
+    dupLine[lineCut] = '\0';
+    if (strncasecmp(dupLine, ";", 1) == 0)
+    {
+        copyCommentName(sym, dupLine+1);
+        std::free(name);
+        std::free(dupLine);
+        return MapFile::COMMENT_LINE;
+    }
+    sym.addr = -1;
+    int ret;
+#ifdef __EA64__
+    ret = sscanf(dupLine, " %04lX : %016llX %[^\t\n ;]", &sym.seg, &sym.addr, name);
+#else
+    ret = sscanf(dupLine, " %04lX : %08lX %[^\t\n ;]", &sym.seg, &sym.addr, name);
+#endif
+    if (3 == ret)
+        copyScannedName(sym, name);
+    std::free(name);
+    std::free(dupLine);
+    if (3 != ret)
+    {
+        // we have parsed to end of value/name symbols table or reached EOF
+        return MapFile::FINISHING_LINE;
+    }
+    else if ((0 == sym.seg) || (--sym.seg >= numOfSegs) ||
+            ((MapFile::MAPAddress)-1 == sym.addr) || (std::strlen(sym.name) == 0) )
+    {
+        return MapFile::INVALID_LINE;
+    }
+    return MapFile::SYMBOL_LINE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads one entry of Watcom-like MAP file, the original way.
+/// @param sym Target  buffer for symbol data.
+/// @param  pLine Pointer to start of buffer
+/// @param  lineLen Length of the current line
+/// @param  minLineLen Minimal accepted length of line
+/// @param segs Segments, used to verify segment number range
+/// @return Result of the parsing
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+MapFile::ParseResult MapRef::parseWatcomSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, const MapFile::MAPSegmentMap &segs)
+{
+    size_t numOfSegs = segs.size();
+    // Get segment number, address, name, by pass spaces at beginning,
+    // between ':' character, between address and name
+    size_t lineCut = lineLen;
+    if (lineCut > MAXNAMELEN + minLineLen)
+        lineCut = MAXNAMELEN + minLineLen;
+    char * dupLine = (char *)std::malloc(lineCut+1);
+    char * name = (char *)std::malloc(lineCut+1);
+    strncpy(dupLine,pLine,lineCut);
+    dupLine[lineCut] = '\0';
+    if (strncasecmp(dupLine, ";", 1) == 0)
+    {
+        copyCommentName(sym, dupLine+1);
+        std::free(name);
+        std::free(dupLine);
+        return MapFile::COMMENT_LINE;
+    }
+    if (strncasecmp(dupLine, WATCOM_MEMMAP_SKIP, std::strlen(WATCOM_MEMMAP_SKIP)) == 0)
+    {
+        std::free(name);
+        std::free(dupLine);
+        return MapFile::SKIP_LINE;
+    }
+    if (strncasecmp(dupLine, WATCOM_MEMMAP_COMMENT, std::strlen(WATCOM_MEMMAP_COMMENT)) == 0)
+    {
+        copyCommentName(sym, dupLine+std::strlen(WATCOM_MEMMAP_COMMENT));
+        std::free(name);
+        std::free(dupLine);
+        return MapFile::COMMENT_LINE;
+    }
+    int ret;
+#ifdef __EA64__
+    ret = sscanf(dupLine, " %04lX : %016llX%*c %[^\t\n;]", &sym.seg, &sym.addr, name);
+#else
+    ret = sscanf(dupLine, " %04lX : %08lX%*c %[^\t\n;]", &sym.seg, &sym.addr, name);
+#endif
+    if (3 == ret)
+        copyScannedName(sym, name);
+    std::free(name);
+    std::free(dupLine);
+    if (3 != ret)
+    {
+        // we have parsed to end of value/name symbols table or reached EOF
+        return MapFile::FINISHING_LINE;
+    }
+    else if ((0 == sym.seg) || (--sym.seg >= numOfSegs) ||
+            ((MapFile::MAPAddress)-1 == sym.addr) || (std::strlen(sym.name) == 0) )
+    {
+        return MapFile::INVALID_LINE;
+    }
+    return MapFile::SYMBOL_LINE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads one entry of GCC-like MAP file, the original way.
+/// @param sym Target  buffer for symbol data.
+/// @param  pLine Pointer to start of buffer
+/// @param  lineLen Length of the current line
+/// @param  minLineLen Minimal accepted length of line
+/// @param segs Segments, used to find segment of the linear address
+/// @return Result of the parsing
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+MapFile::ParseResult MapRef::parseGccSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, const MapFile::MAPSegmentMap &segs)
+{
+    size_t numOfSegs = segs.size();
+    // Get segment number, address, name, by pass spaces at beginning,
+    // between ':' character, between address and name
+    size_t lineCut = lineLen;
+    if (lineCut > MAXNAMELEN + minLineLen)
+        lineCut = MAXNAMELEN + minLineLen;
+    char * dupLine = (char *)std::malloc(lineCut+1);
+    char * name = (char *)std::malloc(lineCut+1);
+    strncpy(dupLine,pLine,lineCut);
+    dupLine[lineCut] = '\0';
+    if (strncasecmp(dupLine, ";", 1) == 0)
+    {
+        copyCommentName(sym, dupLine+1);
+        std::free(name);
+        std::free(dupLine);
+        return MapFile::COMMENT_LINE;
+    }
+    if ( (strncasecmp(dupLine, GCC_MEMMAP_SKIP1, std::strlen(GCC_MEMMAP_SKIP1)) == 0) ||
+         (strncasecmp(dupLine, GCC_MEMMAP_SKIP2, std::strlen(GCC_MEMMAP_SKIP2)) == 0) )
+    {
+        std::free(name);
+        std::free(dupLine);
+        return MapFile::SKIP_LINE;
+    }
+    if ( (strncasecmp(dupLine, GCC_MEMMAP_SKIP3, std::strlen(GCC_MEMMAP_SKIP3)) == 0) ||
+         (strncasecmp(dupLine, GCC_MEMMAP_SKIP4, std::strlen(GCC_MEMMAP_SKIP4)) == 0) )
+    {
+        std::free(name);
+        std::free(dupLine);
+        return MapFile::SKIP_LINE;
+    }
+    if (strncasecmp(dupLine, GCC_MEMMAP_LOAD, std::strlen(GCC_MEMMAP_LOAD)) == 0)
+    {
+        copyCommentName(sym, dupLine);
+        std::free(name);
+        std::free(dupLine);
+        return MapFile::COMMENT_LINE;
+    }
+    int ret;
+    MapFile::MAPAddress linear_addr;
+#ifdef __EA64__
+    ret = sscanf(dupLine, " 0x%016llX%*c %[^\t\n;]", &linear_addr, name);
+#else
+    ret = sscanf(dupLine, " 0x%08lX%*c %[^\t\n;]", &linear_addr, name);
+#endif
+    if (2 == ret)
+        copyScannedName(sym, name);
+    std::free(name);
+    std::free(dupLine);
+    if (2 != ret)
+    {
+        // we have parsed to end of value/name symbols table or reached EOF
+        return MapFile::FINISHING_LINE;
+    }
+    linearAddressToSymbolAddr(sym, linear_addr, segs);
+    if ((sym.seg >= numOfSegs) || ((MapFile::MAPAddress)-1 == sym.addr) || (std::strlen(sym.name) == 0) )
+    {
+        return MapFile::INVALID_LINE;
+    }
+    return MapFile::SYMBOL_LINE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads one line of symbols section with the reference parser.
+/// @return Result of the parsing; SKIP_LINE if the section has no symbols
+////////////////////////////////////////////////////////////////////////////////
+static MapFile::ParseResult parseRefLine(MapFile::SectionType section, MapFile::MAPSymbol &sym,
+    const char * pLine, size_t lineLen, size_t minLineLen, const MapFile::MAPSegmentMap &segs)
+{
+    switch (section)
+    {
+    case MapFile::MSVC_MAP:
+    case MapFile::BCCL_NAM_MAP:
+    case MapFile::BCCL_VAL_MAP:
+        return MapRef::parseMsSymbolLine(sym, pLine, lineLen, minLineLen, segs);
+    case MapFile::WATCOM_MAP:
+        return MapRef::parseWatcomSymbolLine(sym, pLine, lineLen, minLineLen, segs);
+    case MapFile::GCC_MAP:
+        return MapRef::parseGccSymbolLine(sym, pLine, lineLen, minLineLen, segs);
+    case MapFile::NO_SECTION:
+    default:
+        return MapFile::SKIP_LINE;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads one line of symbols section with the current parser.
+/// @return Result of the parsing; SKIP_LINE if the section has no symbols
+////////////////////////////////////////////////////////////////////////////////
+static MapFile::ParseResult parseCurLine(MapFile::SectionType section, MapFile::MAPSymbol &sym,
+    const char * pLine, size_t lineLen, size_t minLineLen, MapFile::MAPSegmentCursor &segs)
+{
+    switch (section)
+    {
+    case MapFile::MSVC_MAP:
+    case MapFile::BCCL_NAM_MAP:
+    case MapFile::BCCL_VAL_MAP:
+        return MapFile::parseMsSymbolLine(sym, pLine, lineLen, minLineLen, segs);
+    case MapFile::WATCOM_MAP:
+        return MapFile::parseWatcomSymbolLine(sym, pLine, lineLen, minLineLen, segs);
+    case MapFile::GCC_MAP:
+        return MapFile::parseGccSymbolLine(sym, pLine, lineLen, minLineLen, segs);
+    case MapFile::NO_SECTION:
+    default:
+        return MapFile::SKIP_LINE;
+    }
+}
+
+static std::string trimSpaces(const char * str)
+{
+    const char * pEnd = str + strlen(str);
+    while ((str < pEnd) && isspace((unsigned char)*str))
+        str++;
+    while ((pEnd > str) && isspace((unsigned char)pEnd[-1]))
+        pEnd--;
+    return std::string(str, pEnd - str);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Compares results of both parsers on one line.
+/// Intended changes of the current parser are accepted:
+/// - Watcom "Module: " lines give MODULE_LINE instead of COMMENT_LINE, with
+///   spaces around the module name removed.
+/// @return Empty string if the results match, or description of the difference
+////////////////////////////////////////////////////////////////////////////////
+static std::string compareLine(MapFile::ParseResult refParsed, const MapFile::MAPSymbol &refSym,
+    MapFile::ParseResult curParsed, const MapFile::MAPSymbol &curSym)
+{
+    char desc[128];
+    if ((refParsed == MapFile::COMMENT_LINE) && (curParsed == MapFile::MODULE_LINE))
+    {
+        if (trimSpaces(refSym.name) != curSym.name)
+            return "module name differs";
+        return "";
+    }
+    if (refParsed != curParsed)
+    {
+        snprintf(desc, sizeof(desc), "result %d, reference %d", (int)curParsed, (int)refParsed);
+        return desc;
+    }
+    switch (refParsed)
+    {
+    case MapFile::SYMBOL_LINE:
+        if ((refSym.seg != curSym.seg) || (refSym.addr != curSym.addr))
+        {
+            snprintf(desc, sizeof(desc), "address %04lX:%08llX, reference %04lX:%08llX",
+                curSym.seg, (unsigned long long)curSym.addr, refSym.seg, (unsigned long long)refSym.addr);
+            return desc;
+        }
+        if (strcmp(refSym.name, curSym.name) != 0)
+            return "symbol name differs";
+        break;
+    case MapFile::COMMENT_LINE:
+        if (strcmp(refSym.name, curSym.name) != 0)
+            return "comment differs";
+        break;
+    default:
+        break;
+    }
+    return "";
+}
+
+static void reportMismatch(MapRef::VerifyStats &stats, const std::string &inputName, const char * kind,
+    const std::string &desc, const char * pLine, size_t lineLen)
+{
+    stats.mismatches++;
+    if (stats.mismatches > MapRef::MAX_REPORTED_MISMATCHES)
+        return;
+    if (lineLen > 160)
+        lineLen = 160;
+    printf("%s: %s mismatch, %s: '", inputName.c_str(), kind, desc.c_str());
+    for (size_t i = 0; i < lineLen; i++)
+    {
+        unsigned char c = (unsigned char)pLine[i];
+        if (isprint(c))
+            putchar(c);
+        else
+            printf("\\x%02x", c);
+    }
+    printf("'\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Walks through symbols sections of the MAP file, the original way.
+/// Calls the function for every line within symbols section, with results
+/// of the reference parser; the section ends on a finishing line.
+////////////////////////////////////////////////////////////////////////////////
+template <typename LineFunc>
+static void walkMap(const char * pStart, const char * pEnd, size_t minLineLen,
+    const MapFile::MAPSegmentMap &segs, LineFunc onLine)
+{
+    MapFile::SectionType sectnHdr = MapFile::NO_SECTION;
+    const char * pLine = pStart;
+    const char * pEOL = pStart;
+    MapFile::MAPSymbol sym;
+    while (pLine < pEnd)
+    {
+        // Skip the spaces, '\r', '\n' characters, blank lines, seek to the
+        // non space character at the beginning of a non blank line
+        pLine = MapFile::skipSpaces(pEOL, pEnd);
+
+        // Find the EOL '\r' or '\n' characters
+        pEOL = MapFile::findEOL(pLine, pEnd);
+
+        size_t lineLen = (size_t) (pEOL - pLine);
+        if (lineLen < minLineLen)
+        {
+            continue;
+        }
+
+        // Check if we're on section header or section end
+        if (sectnHdr == MapFile::NO_SECTION)
+        {
+            sectnHdr = MapFile::recognizeSectionStart(pLine, lineLen);
+            if ((sectnHdr != MapFile::NO_SECTION) && !MapFile::getSectionFormat(sectnHdr)->parseStartLine)
+                continue;
+        } else
+        {
+            sectnHdr = MapFile::recognizeSectionEnd(sectnHdr, pLine, lineLen);
+            if (sectnHdr == MapFile::NO_SECTION)
+                continue;
+        }
+        if (sectnHdr == MapFile::NO_SECTION)
+            continue;
+        sym.seg = 0;
+        sym.addr = (MapFile::MAPAddress)-1;
+        sym.name[0] = '\0';
+        MapFile::ParseResult parsed = parseRefLine(sectnHdr, sym, pLine, lineLen, minLineLen, segs);
+        onLine(sectnHdr, pLine, lineLen, parsed, sym);
+        if (parsed == MapFile::FINISHING_LINE)
+            sectnHdr = MapFile::NO_SECTION;
+    }
+}
+
+void MapRef::clearVerifyStats(MapRef::VerifyStats &stats)
+{
+    stats.lines = 0;
+    stats.symbols = 0;
+    stats.lineNumbers = 0;
+    stats.fuzzed = 0;
+    stats.mismatches = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes DeDe indicator from symbol name, like the original plugin did.
+////////////////////////////////////////////////////////////////////////////////
+static const char * skipDeDeIndicator(const char * pname)
+{
+    if (('<' == pname[0]) && ('-' == pname[1]))
+        return pname + 2;
+    else if ('*' == pname[0])
+        return pname + 1;
+    else if (('-' == pname[0]) && ('>' == pname[1]))
+        return pname + 2;
+    return pname;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Compares the symbol table from parsing whole file with reference symbols.
+/// The current parser does not cut long lines, so if the reference line was
+/// cut, its name only needs to be the beginning of the parsed name.
+////////////////////////////////////////////////////////////////////////////////
+static void verifyTable(const std::string &inputName, const std::vector<MapRef::RefSymbol> &refSymbols,
+    const MapFile::MAPSymbolTable &parsed, MapRef::VerifyStats &stats)
+{
+    size_t count = (refSymbols.size() < parsed.size()) ? refSymbols.size() : parsed.size();
+    for (size_t i = 0; i < count; i++)
+    {
+        const MapRef::RefSymbol &refSym = refSymbols[i];
+        stats.symbols++;
+        std::string refName(skipDeDeIndicator(refSym.name.c_str()));
+        std::string curName(parsed.name(i), parsed.nameLen(i));
+        bool nameOk = refSym.lineCut ? (curName.compare(0, refName.size(), refName) == 0) : (curName == refName);
+        if ((refSym.seg != parsed.seg(i)) || (refSym.addr != parsed.addr(i)) || !nameOk)
+        {
+            char desc[128];
+            snprintf(desc, sizeof(desc), "symbol %lu at %04lX:%08llX, reference at %04lX:%08llX",
+                (unsigned long)i, parsed.seg(i), (unsigned long long)parsed.addr(i),
+                refSym.seg, (unsigned long long)refSym.addr);
+            reportMismatch(stats, inputName, "table", desc, curName.data(), curName.size());
+        }
+    }
+    if (refSymbols.size() != parsed.size())
+    {
+        char desc[128];
+        snprintf(desc, sizeof(desc), "%lu symbols, reference %lu",
+            (unsigned long)parsed.size(), (unsigned long)refSymbols.size());
+        reportMismatch(stats, inputName, "table", desc, "", 0);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads a line of MSVC line number tables with sscanf(), the way
+/// the original parser read symbols.
+/// @param source Source file of the current table; set by table header line
+/// @return False if the line ends the line number tables
+////////////////////////////////////////////////////////////////////////////////
+static bool parseRefLineNumbers(const char * pLine, size_t lineLen, const MapFile::MAPSegmentMap &segs,
+    std::string &source, std::vector<MapRef::RefLineNumber> &refLines)
+{
+    std::string line(pLine, lineLen);
+    size_t hdrLen = sizeof(MapRef::MSVC_LINE_NUMBER) - 1;
+    if (line.compare(0, hdrLen, MapRef::MSVC_LINE_NUMBER) == 0)
+    {
+        // Source file is within the last parentheses, which may be nested
+        size_t srcEnd = line.rfind(')');
+        size_t srcStart = std::string::npos;
+        int depth = 0;
+        for (size_t i = srcEnd; (srcEnd != std::string::npos) && (i-- > hdrLen); )
+        {
+            if (line[i] == ')')
+                depth++;
+            else if ((line[i] == '(') && (depth-- == 0))
+            {
+                srcStart = i + 1;
+                break;
+            }
+        }
+        if (srcStart != std::string::npos)
+            source = line.substr(srcStart, srcEnd - srcStart);
+        else
+            source = trimSpaces(line.c_str() + hdrLen);
+        return true;
+    }
+    if (!isdigit((unsigned char)line[0]))
+        return false;
+    const char * p = line.c_str();
+    unsigned long lineNum, seg;
+    unsigned long long offs;
+    int n;
+    while (sscanf(p, " %lu %lx:%llx%n", &lineNum, &seg, &offs, &n) == 3)
+    {
+        p += n;
+        if ((seg == 0) || (seg > segs.size()))
+            continue;
+        MapRef::RefLineNumber refLine;
+        refLine.ea = segs.segStart(seg - 1) + (MapFile::MAPAddress)offs;
+        refLine.line = lineNum;
+        refLine.source = source;
+        refLines.push_back(refLine);
+    }
+    return true;
+}
+
+static bool refLineBefore(const MapRef::RefLineNumber &a, const MapRef::RefLineNumber &b)
+{
+    return (a.ea < b.ea);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Compares the line table from parsing whole file with reference line numbers.
+/// Line numbers at the same address must stay in order in which they are listed.
+////////////////////////////////////////////////////////////////////////////////
+static void verifyLineTable(const std::string &inputName, std::vector<MapRef::RefLineNumber> &refLines,
+    const MapFile::MAPSymbolTable &parsed, MapRef::VerifyStats &stats)
+{
+    std::stable_sort(refLines.begin(), refLines.end(), refLineBefore);
+    MapFile::MAPLineReader reader(parsed.lines());
+    MapFile::MAPLineEntry entry;
+    for (size_t i = 0; (i < refLines.size()) && reader.next(entry); i++)
+    {
+        const MapRef::RefLineNumber &refLine = refLines[i];
+        stats.lineNumbers++;
+        std::string curSource;
+        if (entry.fileId != MapFile::STRING_NONE)
+            curSource.assign(parsed.strings().str(entry.fileId), parsed.strings().len(entry.fileId));
+        if ((refLine.ea != entry.ea) || (refLine.line != entry.line) || (refLine.source != curSource))
+        {
+            char desc[128];
+            snprintf(desc, sizeof(desc), "line number %lu: %lu at %08llX, reference %lu at %08llX",
+                (unsigned long)i, entry.line, (unsigned long long)entry.ea,
+                refLine.line, (unsigned long long)refLine.ea);
+            reportMismatch(stats, inputName, "line table", desc, curSource.data(), curSource.size());
+        }
+    }
+    if (refLines.size() != parsed.lines().size())
+    {
+        char desc[128];
+        snprintf(desc, sizeof(desc), "%lu line numbers, reference %lu",
+            (unsigned long)parsed.lines().size(), (unsigned long)refLines.size());
+        reportMismatch(stats, inputName, "line table", desc, "", 0);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Changes the line in a few random places.
+/// Changes are done with characters meaningful to the parsers, to hit
+/// boundaries of fields, widths of hex numbers and name terminators.
+////////////////////////////////////////////////////////////////////////////////
+static void mutateLine(std::string &line, MapRef::Random &rnd)
+{
+    unsigned int numMutations = 1 + nextRandom(rnd) % MapRef::FUZZ_MAX_MUTATIONS;
+    for (unsigned int i = 0; i < numMutations; i++)
+    {
+        size_t pos = line.empty() ? 0 : (nextRandom(rnd) % (line.size() + 1));
+        char c = MapRef::FUZZ_CHARS[nextRandom(rnd) % (sizeof(MapRef::FUZZ_CHARS) - 1)];
+        switch (nextRandom(rnd) % 5)
+        {
+        case 0: // replace
+            if (pos < line.size())
+                line[pos] = c;
+            break;
+        case 1: // insert
+            line.insert(pos, 1, c);
+            break;
+        case 2: // delete
+            if (pos < line.size())
+                line.erase(pos, 1);
+            break;
+        case 3: // cut
+            line.resize(pos);
+            break;
+        case 4: // repeat a part
+        default:
+            if (pos < line.size())
+                line.insert(pos, line, pos, 1 + nextRandom(rnd) % 24);
+            break;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Compares the current parser with the reference one.
+/// Every line within symbols sections is parsed by both line parsers, the
+/// symbol table and the line table from parsing the whole file are compared
+/// with the ones found by the reference, and random lines are mutated and
+/// parsed again.
+/// @param inputName Name of the input, used in messages
+/// @param pStart Start of the file content
+/// @param pEnd End of the file content
+/// @param minLineLen Minimal accepted length of line
+/// @param segs Segments of the target executable
+/// @param parsed Symbol table made by the current parser from the whole file
+/// @param numFuzzed Amount of mutated lines to compare
+/// @param seed Seed of the mutations
+/// @param stats Results of the comparison; the counts are added to it
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+void MapRef::verifyMap(const std::string &inputName, const char * pStart, const char * pEnd, size_t minLineLen,
+    const MapFile::MAPSegmentMap &segs, const MapFile::MAPSymbolTable &parsed, unsigned long numFuzzed,
+    unsigned long seed, MapRef::VerifyStats &stats)
+{
+    MapFile::MAPSegmentCursor segCursor(segs);
+    std::vector<MapRef::RefSymbol> refSymbols;
+    std::vector<MapRef::RefLine> lines;
+    std::vector<MapRef::RefLineNumber> refLines;
+    std::string source;
+    bool inLineTables = false;
+    MapFile::MAPSymbol curSym;
+    walkMap(pStart, pEnd, minLineLen, segs, [&](MapFile::SectionType section, const char * pLine, size_t lineLen,
+        MapFile::ParseResult refParsed, const MapFile::MAPSymbol &refSym)
+    {
+        if (section == MapFile::MSVC_LINES_MAP)
+        {
+            // Line number tables have no symbols; lines after their end are ignored
+            // until next table header
+            bool header = (strncmp(pLine, MapRef::MSVC_LINE_NUMBER, sizeof(MapRef::MSVC_LINE_NUMBER) - 1) == 0);
+            if (header || inLineTables)
+                inLineTables = parseRefLineNumbers(pLine, lineLen, segs, source, refLines);
+            return;
+        }
+        inLineTables = false;
+        stats.lines++;
+        MapFile::ParseResult curParsed = parseCurLine(section, curSym, pLine, lineLen, minLineLen, segCursor);
+        std::string desc = compareLine(refParsed, refSym, curParsed, curSym);
+        if (!desc.empty())
+            reportMismatch(stats, inputName, "line", desc, pLine, lineLen);
+        MapRef::RefLine line;
+        line.section = section;
+        line.start = pLine;
+        line.len = lineLen;
+        lines.push_back(line);
+        if (refParsed != MapFile::SYMBOL_LINE)
+            return;
+        MapRef::RefSymbol sym;
+        sym.seg = refSym.seg;
+        sym.addr = refSym.addr;
+        sym.name = refSym.name;
+        sym.lineCut = (lineLen > MAXNAMELEN + minLineLen);
+        refSymbols.push_back(sym);
+    });
+    verifyTable(inputName, refSymbols, parsed, stats);
+    verifyLineTable(inputName, refLines, parsed, stats);
+
+    if (lines.empty())
+        return;
+    MapRef::Random rnd;
+    rnd.state = 0x9E3779B97F4A7C15ULL ^ seed;
+    MapFile::MAPSymbol refSym;
+    std::string line;
+    for (unsigned long i = 0; i < numFuzzed; i++)
+    {
+        const MapRef::RefLine &orig = lines[nextRandom(rnd) % lines.size()];
+        line.assign(orig.start, orig.len);
+        mutateLine(line, rnd);
+        stats.fuzzed++;
+        MapFile::ParseResult refParsed = parseRefLine(orig.section, refSym, line.data(), line.size(), minLineLen, segs);
+        MapFile::ParseResult curParsed = parseCurLine(orig.section, curSym, line.data(), line.size(), minLineLen, segCursor);
+        std::string desc = compareLine(refParsed, refSym, curParsed, curSym);
+        if (!desc.empty())
+            reportMismatch(stats, inputName, "fuzzed line", desc, line.data(), line.size());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file MAPReference.h
+///     Reference MAP file parser header.
+/// @par Purpose:
+///     Keeps the original sscanf() based line parsers, and compares output
+///     of the current parser with them on whole files and on mutated lines.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPREFERENCE_H_
+#define MAPREFERENCE_H_
+
+#include  <cstdio>
+#include  <string>
+#include  <vector>
+
+#include  "MAPReader.h"
+#include  "MAPSegments.h"
+#include  "MAPSymbols.h"
+
+namespace MapRef {
+
+/// Symbol found by the reference parser.
+typedef struct {
+    unsigned long seg;
+    MapFile::MAPAddress addr;
+    std::string name;
+    bool lineCut;           ///< The line was cut to maximal length, so the name may be cut as well
+} RefSymbol;
+
+/// Results of comparing the current parser with the reference one.
+typedef struct {
+    unsigned long long lines;       ///< Lines within symbol sections compared
+    unsigned long long symbols;     ///< Symbols compared with the parsed symbol table
+    unsigned long long lineNumbers; ///< Source line numbers compared with the parsed line table
+    unsigned long long fuzzed;      ///< Mutated lines compared
+    unsigned long long mismatches;
+} VerifyStats;
+
+/// Amount of mismatches which are described, before only counting them.
+const unsigned long MAX_REPORTED_MISMATCHES = 8;
+
+MapFile::ParseResult parseMsSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, const MapFile::MAPSegmentMap &segs);
+MapFile::ParseResult parseWatcomSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, const MapFile::MAPSegmentMap &segs);
+MapFile::ParseResult parseGccSymbolLine(MapFile::MAPSymbol &sym, const char *pLine, size_t lineLen, size_t minLineLen, const MapFile::MAPSegmentMap &segs);
+void clearVerifyStats(VerifyStats &stats);
+void verifyMap(const std::string &inputName, const char * pStart, const char * pEnd, size_t minLineLen,
+    const MapFile::MAPSegmentMap &segs, const MapFile::MAPSymbolTable &parsed, unsigned long numFuzzed,
+    unsigned long seed, VerifyStats &stats);
+
+};
+
+#endif
@@ -0,0 +1,612 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file loadmap-cli.cpp
+///     Command line MAP file converter.
+/// @par Purpose:
+///     Converts MAP files into a normalized list of symbols, without IDA.
+///     Output is JSON Lines, CSV, or IDC / IDAPython script which applies
+///     the symbols to a database.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  <cstdio>
+#include  <cstdlib>
+#include  <cstring>
+#include  <cerrno>
+#include  <string>
+#include  <vector>
+#include  <cxxabi.h>
+
+#include  "MAPReader.h"
+#include  "MAPParser.h"
+#include  "MAPSegments.h"
+#include  "MAPStream.h"
+#include  "MAPDemangle.h"
+#include  "MAPFilter.h"
+
+/// Minimal accepted length of symbol line, same as in the plugin.
+const size_t CLI_MIN_LINE_LEN = 14;
+/// Amount of output collected before it is written.
+const size_t CLI_OUTPUT_BLOCK = 1024 * 1024;
+/// Amount of segments which can be referenced by MAP file without segments layout.
+const size_t CLI_RAW_NUM_OF_SEGS = 0xFFFF;
+
+typedef enum {
+    OUT_JSONL = 0,
+    OUT_CSV,
+    OUT_IDC,
+    OUT_PY,
+} OutputFormat;
+
+/// How strings are quoted in the output.
+typedef enum {
+    QUOTE_JSON = 0,         ///< C-like escapes, control characters as \u00XX
+    QUOTE_CSV,              ///< Quotes are doubled
+    QUOTE_C,                ///< C-like escapes, valid in IDC and Python, octal for non-ASCII
+} QuoteStyle;
+
+typedef struct {
+    OutputFormat format;
+    bool resolved;          ///< Segments layout was given, so addresses are known
+    bool defaultAsName;     ///< Apply symbols of default kind as names in scripts
+    bool stream;            ///< Read files in blocks instead of mapping them
+    bool demangle;          ///< Add demangled names to the output
+    unsigned int numThreads;
+    const MapFile::MAPFilter * filter;  ///< Symbols to convert; NULL for all
+} CliOptions;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Output collected in large blocks, with formatting helpers.
+////////////////////////////////////////////////////////////////////////////////
+class OutputBuffer {
+public:
+    explicit OutputBuffer(FILE * outFile) : fp(outFile), writeFailed(false) { buf.reserve(CLI_OUTPUT_BLOCK + 4096); }
+    ~OutputBuffer(void) { flush(); }
+    void text(const char * str) { buf.append(str); }
+    void text(const char * str, size_t len) { buf.append(str, len); }
+    void hex(unsigned long long val);
+    void dec(unsigned long long val);
+    void quoted(const char * str, size_t len, QuoteStyle style);
+    void endLine(void) { buf.push_back('\n'); if (buf.size() >= CLI_OUTPUT_BLOCK) flush(); }
+    void flush(void);
+    bool failed(void) const { return writeFailed; }
+
+private:
+    std::string buf;
+    FILE * fp;
+    bool writeFailed;
+};
+
+void OutputBuffer::flush(void)
+{
+    if (!buf.empty() && (fwrite(buf.data(), 1, buf.size(), fp) != buf.size()))
+        writeFailed = true;
+    buf.clear();
+}
+
+/// Appends "0x" prefixed hex number, with at least 8 digits.
+void OutputBuffer::hex(unsigned long long val)
+{
+    static const char digits[] = "0123456789ABCDEF";
+    char tmp[2 + 16];
+    size_t pos = sizeof(tmp);
+    do {
+        tmp[--pos] = digits[val & 0xF];
+        val >>= 4;
+    } while ((val != 0) || (sizeof(tmp) - pos < 8));
+    tmp[--pos] = 'x';
+    tmp[--pos] = '0';
+    buf.append(tmp + pos, sizeof(tmp) - pos);
+}
+
+void OutputBuffer::dec(unsigned long long val)
+{
+    char tmp[20];
+    size_t pos = sizeof(tmp);
+    do {
+        tmp[--pos] = (char)('0' + val % 10);
+        val /= 10;
+    } while (val != 0);
+    buf.append(tmp + pos, sizeof(tmp) - pos);
+}
+
+/// Appends string in double quotes, escaped as required by given style.
+void OutputBuffer::quoted(const char * str, size_t len, QuoteStyle style)
+{
+    unsigned char maxPlain = (style == QUOTE_C) ? 0x7E : 0xFF;
+    buf.push_back('"');
+    const char * pEnd = str + len;
+    while (str < pEnd)
+    {
+        // Copy the longest run which does not need escaping
+        const char * pRun = str;
+        while ((str < pEnd) && (*str != '"') && (*str != '\\') && ((unsigned char)*str >= 0x20) &&
+            ((unsigned char)*str <= maxPlain))
+            str++;
+        buf.append(pRun, (size_t)(str - pRun));
+        if (str >= pEnd)
+            break;
+        unsigned char chr = (unsigned char)*str++;
+        if (style == QUOTE_CSV)
+        {
+            if (chr == '"')
+                buf.append("\"\"");
+            else
+                buf.push_back((char)chr);
+        }
+        else if ((chr == '"') || (chr == '\\'))
+        {
+            buf.push_back('\\');
+            buf.push_back((char)chr);
+        }
+        else
+        {
+            char esc[8];
+            if (style == QUOTE_JSON)
+                snprintf(esc, sizeof(esc), "\\u%04X", chr);
+            else
+                snprintf(esc, sizeof(esc), "\\%03o", chr);
+            buf.append(esc);
+        }
+    }
+    buf.push_back('"');
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Demangles Itanium ABI names, as produced by GCC and Clang.
+/// The runtime demangler is thread safe, so names are demangled in parallel.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool cxaDemangle(const char * name, std::string &demangled)
+{
+    // Mach-O adds another underscore before the mangled name
+    if ((name[0] == '_') && (name[1] == '_') && (name[2] == 'Z'))
+        name++;
+    if ((name[0] != '_') || (name[1] != 'Z'))
+        return false;
+    int status = 0;
+    char * text = abi::__cxa_demangle(name, NULL, NULL, &status);
+    if (text == NULL)
+        return false;
+    demangled.assign(text);
+    free(text);
+    return true;
+}
+
+static const char * kindName(MapFile::SymbolKind kind)
+{
+    switch (kind)
+    {
+    case MapFile::SYMKIND_NAME:
+        return "name";
+    case MapFile::SYMKIND_COMMENT:
+        return "comment";
+    default:
+        return "default";
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Parses segments layout given on command line.
+/// Ranges are separated by commas; each one is "start-end", "start+size",
+/// or just "start", which extends to end of address space. First range is
+/// segment 0001 of the MAP file.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool parseSegmentsLayout(const char * spec, MapFile::MAPSegmentMap &segments)
+{
+    segments.clear();
+    const char * p = spec;
+    while (*p != '\0')
+    {
+        char * pNext;
+        errno = 0;
+        unsigned long long start = strtoull(p, &pNext, 0);
+        if ((pNext == p) || (errno != 0))
+            return false;
+        unsigned long long end = (MapFile::MAPAddress)-1;
+        p = pNext;
+        if ((*p == '-') || (*p == '+'))
+        {
+            char sep = *p++;
+            unsigned long long val = strtoull(p, &pNext, 0);
+            if ((pNext == p) || (errno != 0))
+                return false;
+            p = pNext;
+            end = (sep == '+') ? (start + val) : val;
+        }
+        if ((end < start) || ((MapFile::MAPAddress)end != end))
+            return false;
+        segments.append((MapFile::MAPAddress)start, (MapFile::MAPAddress)end);
+        if (*p == ',')
+            p++;
+        else if (*p != '\0')
+            return false;
+    }
+    return !segments.empty();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Prepares segments which keep symbol addresses as given in MAP file.
+/// Every segment number is accepted, and offsets are not changed; linear
+/// addresses fall into the first segment.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void makeRawSegments(MapFile::MAPSegmentMap &segments)
+{
+    segments.clear();
+    segments.append(0, (MapFile::MAPAddress)-1);
+    for (size_t i = 1; i < CLI_RAW_NUM_OF_SEGS; i++)
+        segments.append(0, 0);
+}
+
+static void writeHeader(OutputBuffer &out, const CliOptions &copts)
+{
+    switch (copts.format)
+    {
+    case OUT_CSV:
+        out.text(copts.demangle ? "file,seg,offset,ea,kind,name,object,demangled" : "file,seg,offset,ea,kind,name,object");
+        out.endLine();
+        break;
+    case OUT_IDC:
+        out.text("// Generated by loadmap-cli\n#include <idc.idc>\n\nstatic main()\n{");
+        out.endLine();
+        break;
+    case OUT_PY:
+        out.text("# Generated by loadmap-cli\nimport ida_name\nimport ida_bytes\n\nSN = ida_name.SN_NOCHECK | ida_name.SN_NOWARN");
+        out.endLine();
+        break;
+    default:
+        break;
+    }
+}
+
+static void writeFooter(OutputBuffer &out, const CliOptions &copts)
+{
+    if (copts.format == OUT_IDC)
+    {
+        out.text("}");
+        out.endLine();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes symbols of one MAP file, in order in which they are in the file.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void writeSymbols(OutputBuffer &out, const char * fileName, const MapFile::MAPSymbolTable &symbols,
+    const MapFile::MAPDemangleCache &demangler, const std::vector<unsigned int> &demangledIds,
+    const CliOptions &copts)
+{
+    size_t fileNameLen = strlen(fileName);
+    if (copts.format == OUT_IDC)
+    {
+        out.text("  // ");
+        out.text(fileName, fileNameLen);
+        out.endLine();
+    }
+    else if (copts.format == OUT_PY)
+    {
+        out.text("# ");
+        out.text(fileName, fileNameLen);
+        out.endLine();
+    }
+    for (size_t i = 0; i < symbols.size(); i++)
+    {
+        MapFile::SymbolKind kind = symbols.kind(i);
+        const char * demangled = NULL;
+        if (!demangledIds.empty() && (demangledIds[i] != MapFile::DEMANGLE_NONE))
+            demangled = demangler.text(demangledIds[i]);
+        switch (copts.format)
+        {
+        case OUT_JSONL:
+            out.text("{\"file\":");
+            out.quoted(fileName, fileNameLen, QUOTE_JSON);
+            out.text(",\"seg\":");
+            out.dec(symbols.seg(i) + 1);
+            out.text(",\"offset\":\"");
+            out.hex(symbols.addr(i));
+            if (copts.resolved)
+            {
+                out.text("\",\"ea\":\"");
+                out.hex(symbols.ea(i));
+            }
+            out.text("\",\"kind\":\"");
+            out.text(kindName(kind));
+            out.text("\",\"name\":");
+            out.quoted(symbols.name(i), symbols.nameLen(i), QUOTE_JSON);
+            if (symbols.objectLen(i) > 0)
+            {
+                out.text(",\"object\":");
+                out.quoted(symbols.object(i), symbols.objectLen(i), QUOTE_JSON);
+            }
+            if (demangled != NULL)
+            {
+                out.text(",\"demangled\":");
+                out.quoted(demangled, strlen(demangled), QUOTE_JSON);
+            }
+            out.text("}");
+            break;
+        case OUT_CSV:
+            out.quoted(fileName, fileNameLen, QUOTE_CSV);
+            out.text(",");
+            out.dec(symbols.seg(i) + 1);
+            out.text(",");
+            out.hex(symbols.addr(i));
+            out.text(",");
+            if (copts.resolved)
+                out.hex(symbols.ea(i));
+            out.text(",");
+            out.text(kindName(kind));
+            out.text(",");
+            out.quoted(symbols.name(i), symbols.nameLen(i), QUOTE_CSV);
+            out.text(",");
+            if (symbols.objectLen(i) > 0)
+                out.quoted(symbols.object(i), symbols.objectLen(i), QUOTE_CSV);
+            if (copts.demangle)
+                out.text(",");
+            if (demangled != NULL)
+                out.quoted(demangled, strlen(demangled), QUOTE_CSV);
+            break;
+        case OUT_IDC:
+        case OUT_PY:
+        {
+            bool asName = (kind == MapFile::SYMKIND_NAME) ||
+                ((kind == MapFile::SYMKIND_DEFAULT) && copts.defaultAsName);
+            if (copts.format == OUT_IDC)
+                out.text(asName ? "  set_name(" : "  set_cmt(");
+            else
+                out.text(asName ? "ida_name.set_name(" : "ida_bytes.set_cmt(");
+            out.hex(symbols.ea(i));
+            out.text(", ");
+            out.quoted(symbols.name(i), symbols.nameLen(i), QUOTE_C);
+            if (copts.format == OUT_IDC)
+                out.text(asName ? ", SN_NOCHECK | SN_NOWARN);" : ", 0);");
+            else
+                out.text(asName ? ", SN)" : ", False)");
+            if (demangled == NULL)
+                break;
+            // Same as in the plugin, demangled name of a comment goes to repeatable comment
+            out.endLine();
+            out.text((copts.format == OUT_IDC) ? "  set_cmt(" : "ida_bytes.set_cmt(");
+            out.hex(symbols.ea(i));
+            out.text(", ");
+            out.quoted(demangled, strlen(demangled), QUOTE_C);
+            if (copts.format == OUT_IDC)
+                out.text(asName ? ", 0);" : ", 1);");
+            else
+                out.text(asName ? ", False)" : ", True)");
+            break;
+        }
+        }
+        out.endLine();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads and parses one MAP file.
+/// @return True if symbol sections were found and the file was read completely
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool convertMap(const char * fileName, const MapFile::MAPSegmentMap &segments, const CliOptions &copts,
+    MapFile::MAPDemangleCache &demangler, OutputBuffer &out)
+{
+    MapFile::MAPParseOptions opts;
+    opts.minLineLen = CLI_MIN_LINE_LEN;
+    opts.segments = &segments;
+    opts.verbose = false;
+    opts.numThreads = copts.numThreads;
+    opts.mapBase = NULL;
+    opts.progress = NULL;
+    opts.filter = copts.filter;
+    opts.lineNumbers = true;
+    MapFile::MAPSymbolTable symbols;
+    MapFile::MAPParseStats stats;
+    std::string log;
+
+    char * mapAddr = NULL;
+    size_t mapSize = INVALID_MAPFILE_SIZE;
+    MapFile::MAPResult res = MapFile::OS_ERROR;
+    if (!copts.stream)
+        res = MapFile::openMAP(fileName, mapAddr, mapSize);
+    if (res == MapFile::FILE_EMPTY_ERROR)
+    {
+        fprintf(stderr, "%s: file is empty\n", fileName);
+        return false;
+    }
+    if (res == MapFile::OPEN_NO_ERROR)
+    {
+        opts.mapBase = mapAddr;
+        MapFile::parseMapBuffer(mapAddr, mapAddr + mapSize, opts, symbols, stats, log);
+        MapFile::closeMAP(mapAddr, mapSize);
+    }
+    else
+    {
+        // Pipes and files which cannot be mapped are read in blocks
+        MapFile::MAPStreamReader reader;
+        if (reader.open(fileName) != MapFile::OPEN_NO_ERROR)
+        {
+            fprintf(stderr, "%s: %s\n", fileName, strerror((int)reader.errorCode()));
+            return false;
+        }
+        if (!MapFile::parseMapStream(reader, opts, symbols, stats, log))
+        {
+            fprintf(stderr, "%s: read failed: %s\n", fileName, strerror((int)reader.errorCode()));
+            return false;
+        }
+    }
+    if (stats.binary)
+    {
+        fprintf(stderr, "%s: seems to be a binary or Unicode file\n", fileName);
+        return false;
+    }
+    if (stats.sectionsFound == 0)
+    {
+        fprintf(stderr, "%s: not a valid MAP file, symbols section header not found\n", fileName);
+        return false;
+    }
+    std::vector<unsigned int> demangledIds;
+    if (copts.demangle)
+    {
+        MapFile::MAPDemangleStats demangleStats;
+        demangler.demangleSymbols(symbols, cxaDemangle, copts.numThreads, demangledIds, demangleStats);
+    }
+    writeSymbols(out, fileName, symbols, demangler, demangledIds, copts);
+    if (copts.filter != NULL)
+    {
+        fprintf(stderr, "%s: %lu symbols, %lu outside of filter, %lu invalid lines\n", fileName,
+            (unsigned long)symbols.size(), stats.lineResults[MapFile::FILTERED_LINE], stats.invalidLines);
+    }
+    else
+    {
+        fprintf(stderr, "%s: %lu symbols, %lu invalid lines\n", fileName,
+            (unsigned long)symbols.size(), stats.invalidLines);
+    }
+    return true;
+}
+
+static void usage(const char * prog)
+{
+    fprintf(stderr, "usage: %s [-f jsonl|csv|idc|py] [-o output] [--segments layout] [--comments]\n"
+        "          [-t threads] [--stream] [--demangle] [--filter spec] file.map ...\n"
+        "Converts MAP files into a list of symbols.\n"
+        "  --segments  segment address ranges, in order of segment numbers, like\n"
+        "              0x401000-0x405000,0x405000+0x2000; without it, segment and\n"
+        "              offset are given as in MAP file and addresses are not resolved\n"
+        "  --comments  apply symbols as comments in idc and py scripts\n"
+        "  --stream    read files in blocks instead of mapping them to memory\n"
+        "  --demangle  add demangled GCC and Clang names; in idc and py scripts,\n"
+        "              they are put in comments\n"
+        "  --filter    convert only symbols selected by segment, address range,\n"
+        "              object file or name, like \"seg=1 obj=*.obj name=?Draw*\";\n"
+        "              without --segments, addr= ranges are offsets in segments\n", prog);
+}
+
+int main(int argc, char * argv[])
+{
+    CliOptions copts;
+    copts.format = OUT_JSONL;
+    copts.resolved = false;
+    copts.defaultAsName = true;
+    copts.stream = false;
+    copts.demangle = false;
+    copts.numThreads = 0;
+    copts.filter = NULL;
+    const char * outName = NULL;
+    MapFile::MAPFilter filter;
+    const char * layout = NULL;
+    std::vector<const char *> fileNames;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasArg = (i + 1 < argc);
+        if ((strcmp(argv[i], "-f") == 0) && hasArg)
+        {
+            const char * fmt = argv[++i];
+            if (strcmp(fmt, "jsonl") == 0)
+                copts.format = OUT_JSONL;
+            else if (strcmp(fmt, "csv") == 0)
+                copts.format = OUT_CSV;
+            else if (strcmp(fmt, "idc") == 0)
+                copts.format = OUT_IDC;
+            else if (strcmp(fmt, "py") == 0)
+                copts.format = OUT_PY;
+            else
+            {
+                fprintf(stderr, "unknown output format '%s'\n", fmt);
+                return 2;
+            }
+        }
+        else if ((strcmp(argv[i], "-o") == 0) && hasArg)
+            outName = argv[++i];
+        else if ((strcmp(argv[i], "--segments") == 0) && hasArg)
+            layout = argv[++i];
+        else if ((strcmp(argv[i], "-t") == 0) && hasArg)
+            copts.numThreads = (unsigned int)strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "--comments") == 0)
+            copts.defaultAsName = false;
+        else if (strcmp(argv[i], "--stream") == 0)
+            copts.stream = true;
+        else if (strcmp(argv[i], "--demangle") == 0)
+            copts.demangle = true;
+        else if ((strcmp(argv[i], "--filter") == 0) && hasArg)
+        {
+            std::string error;
+            if (!filter.parse(argv[++i], error))
+            {
+                fprintf(stderr, "invalid filter: %s\n", error.c_str());
+                return 2;
+            }
+            copts.filter = filter.empty() ? NULL : &filter;
+        }
+        else if ((argv[i][0] != '-') || (strcmp(argv[i], "-") == 0))
+            fileNames.push_back((strcmp(argv[i], "-") == 0) ? "/dev/stdin" : argv[i]);
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (fileNames.empty())
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    MapFile::MAPSegmentMap segments;
+    if (layout != NULL)
+    {
+        if (!parseSegmentsLayout(layout, segments))
+        {
+            fprintf(stderr, "invalid segments layout '%s'\n", layout);
+            return 2;
+        }
+        copts.resolved = true;
+    }
+    else if ((copts.format == OUT_IDC) || (copts.format == OUT_PY))
+    {
+        fprintf(stderr, "idc and py output need addresses, give the segments layout\n");
+        return 2;
+    }
+    else
+    {
+        makeRawSegments(segments);
+    }
+
+    FILE * fp = (outName != NULL) ? fopen(outName, "wb") : stdout;
+    if (fp == NULL)
+    {
+        perror(outName);
+        return 1;
+    }
+    bool ok = true;
+    {
+        OutputBuffer out(fp);
+        MapFile::MAPDemangleCache demangler;
+        writeHeader(out, copts);
+        for (size_t i = 0; i < fileNames.size(); i++)
+            ok = convertMap(fileNames[i], segments, copts, demangler, out) && ok;
+        writeFooter(out, copts);
+        out.flush();
+        if (out.failed() || (fflush(fp) != 0))
+        {
+            fprintf(stderr, "write failed\n");
+            ok = false;
+        }
+    }
+    if (fp != stdout)
+        fclose(fp);
+    return ok ? 0 : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,742 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file mapbench.cpp
+///     MAP file parser benchmark.
+/// @par Purpose:
+///     Measures throughput of the MAP file parser outside of IDA. Reports
+///     MB/s, lines/s and heap allocations per line for each MAP format.
+///     Can also compare the parser with the original one, and fail when
+///     the results differ or the throughput is below given floor.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  <cstdio>
+#include  <cstdlib>
+#include  <cstring>
+#include  <string>
+#include  <vector>
+#include  <atomic>
+#include  <chrono>
+#include  <new>
+#include  <algorithm>
+
+#include  "MAPReader.h"
+#include  "MAPScanner.h"
+#include  "MAPParser.h"
+#include  "MAPSegments.h"
+#include  "MAPStream.h"
+#include  "MAPProgress.h"
+#include  "MAPWriter.h"
+#include  "MAPFilter.h"
+#include  "MAPGenerator.h"
+#include  "MAPReference.h"
+
+/// Minimal accepted length of symbol line, same as in the plugin.
+const size_t BENCH_MIN_LINE_LEN = 14;
+/// Amount of segments reported to the parser.
+const size_t BENCH_NUM_OF_SEGS = 16;
+/// Base address of the first segment.
+const MapFile::MAPAddress BENCH_SEG_BASE = 0x400000;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Allocation counting
+/// The binary is linked with --wrap for malloc family; operator new is
+/// replaced by a version which goes through malloc, so every heap
+/// allocation is counted exactly once.
+/// @{
+static std::atomic<unsigned long long> g_allocCount(0);
+
+extern "C" {
+void * __real_malloc(size_t size);
+void * __real_calloc(size_t num, size_t size);
+void * __real_realloc(void * ptr, size_t size);
+
+void * __wrap_malloc(size_t size)
+{
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    return __real_malloc(size);
+}
+
+void * __wrap_calloc(size_t num, size_t size)
+{
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    return __real_calloc(num, size);
+}
+
+void * __wrap_realloc(void * ptr, size_t size)
+{
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    return __real_realloc(ptr, size);
+}
+};
+
+void * operator new(size_t size)
+{
+    void * ptr = malloc(size ? size : 1);
+    if (ptr == NULL)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void * operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void * ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void * ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void * ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void * ptr, size_t) noexcept
+{
+    free(ptr);
+}
+/// @}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Prepares segments list which accepts symbols of the generated maps.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static void makeBenchSegments(MapFile::MAPSegmentMap &segments)
+{
+    // First segment covers GCC linear addresses, following ones are small
+    segments.clear();
+    segments.append(BENCH_SEG_BASE, 0x80000000);
+    for (size_t i = 1; i < BENCH_NUM_OF_SEGS; i++)
+        segments.append(0x80000000 + (i - 1) * 0x1000000, 0x80000000 + i * 0x1000000);
+}
+
+typedef struct {
+    std::string name;
+    const char * start;
+    size_t size;
+    unsigned long long numLines;
+    double minRate;         ///< Lowest accepted parsing rate in Mlines/s, 0 for no limit
+} BenchInput;
+
+typedef struct {
+    unsigned int numThreads;
+    unsigned int repeats;
+    bool stream;            ///< Also parse the files through the streaming reader
+    bool progress;          ///< Parse with progress reporting, to measure its cost
+    bool verify;            ///< Compare results with the reference parser, and written maps with their symbols
+    unsigned long fuzzLines;    ///< Amount of mutated lines to compare, when verifying
+    const MapFile::MAPFilter * filter;  ///< Also parse with this import filter; NULL if not requested
+} BenchOptions;
+
+/// Amount of progress reports received, to make sure they are not optimized out.
+static unsigned long g_progressReports = 0;
+
+static bool countProgress(const MapFile::MAPProgress &)
+{
+    g_progressReports++;
+    return true;
+}
+
+static double secondsSince(const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static unsigned long long countLines(const char * pStart, const char * pEnd)
+{
+    unsigned long long numLines = 0;
+    const char * p = pStart;
+    while (p < pEnd)
+    {
+        const char * pEOL = (const char *)memchr(p, '\n', pEnd - p);
+        numLines++;
+        if (pEOL == NULL)
+            break;
+        p = pEOL + 1;
+    }
+    return numLines;
+}
+
+static void printHeader(void)
+{
+    printf("%-24s %-9s %9s %10s %10s %9s %9s %11s\n", "input", "stage", "size MB",
+        "lines", "symbols", "MB/s", "Mlines/s", "allocs/line");
+}
+
+static double printRow(const BenchInput &input, const char * stage, double bestTime,
+    unsigned long long numSymbols, unsigned long long numAllocs)
+{
+    double sizeMB = (double)input.size / (1024.0 * 1024.0);
+    double allocsPerLine = (input.numLines > 0) ? ((double)numAllocs / (double)input.numLines) : 0.0;
+    if (bestTime <= 0.0)
+        bestTime = 1e-9;
+    double rate = (double)input.numLines / bestTime / 1e6;
+    printf("%-24s %-9s %9.1f %10llu %10llu %9.1f %9.2f %11.6f\n", input.name.c_str(), stage, sizeMB,
+        input.numLines, numSymbols, sizeMB / bestTime, rate, allocsPerLine);
+    return rate;
+}
+
+/// Orders symbols by segment and offset, as names are listed in IDA.
+class SymbolOrder {
+public:
+    explicit SymbolOrder(const MapFile::MAPSymbolTable &symbolTable) : symbols(symbolTable) {}
+    bool operator()(size_t a, size_t b) const
+    {
+        if (symbols.seg(a) != symbols.seg(b))
+            return (symbols.seg(a) < symbols.seg(b));
+        return (symbols.addr(a) < symbols.addr(b));
+    }
+private:
+    const MapFile::MAPSymbolTable &symbols;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Measures writing parsed symbols as MAP file of each format.
+/// Symbols are written segment by segment, as the plugin exports names;
+/// ones beyond end of their segment are left out, as they have no address.
+/// When verifying, the written map is parsed again and has to give back
+/// the same symbols.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool benchWrite(const BenchInput &input, const MapFile::MAPSymbolTable &symbols,
+    const MapFile::MAPSegmentMap &segments, const BenchOptions &bopts)
+{
+    const MapFile::MAPSegmentMap &segTab = segments;
+    std::vector<size_t> order;
+    order.reserve(symbols.size());
+    for (size_t i = 0; i < symbols.size(); i++)
+    {
+        unsigned long seg = symbols.seg(i);
+        if ((seg < segTab.size()) && (symbols.addr(i) < segTab.segEnd(seg) - segTab.segStart(seg)))
+            order.push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(), SymbolOrder(symbols));
+    bool ok = true;
+    std::vector<size_t> written;
+    written.reserve(order.size());
+    for (int fmt = 0; fmt < MapFile::WRITE_FORMAT_COUNT; fmt++)
+    {
+        std::string content;
+        double bestTime = -1.0;
+        unsigned long long numAllocs = 0;
+        for (unsigned int rep = 0; rep < bopts.repeats; rep++)
+        {
+            content.clear();
+            written.clear();
+            unsigned long long allocsBefore = g_allocCount.load();
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            MapFile::MAPWriter writer((MapFile::MAPWriteFormat)fmt, content);
+            writer.writeHeader("program", BENCH_SEG_BASE);
+            for (size_t seg = 0; seg < segTab.size(); seg++)
+                writer.writeSegment(seg, segTab.segStart(seg), segTab.segEnd(seg) - segTab.segStart(seg),
+                    ".text", (seg == 0));
+            writer.beginSymbols();
+            unsigned long curSeg = (unsigned long)-1;
+            for (size_t i = 0; i < order.size(); i++)
+            {
+                size_t symNo = order[i];
+                unsigned long seg = symbols.seg(symNo);
+                if (seg != curSeg)
+                {
+                    curSeg = seg;
+                    writer.beginSegment(seg, segTab.segStart(seg), segTab.segEnd(seg) - segTab.segStart(seg),
+                        ".text");
+                }
+                if (writer.writeSymbol(seg, symbols.addr(symNo), segTab.segStart(seg) + symbols.addr(symNo),
+                    symbols.name(symNo), symbols.nameLen(symNo), (symbols.kind(symNo) == MapFile::SYMKIND_DEFAULT)))
+                    written.push_back(symNo);
+            }
+            writer.finish();
+            double elapsed = secondsSince(start);
+            numAllocs = g_allocCount.load() - allocsBefore;
+            if ((bestTime < 0.0) || (elapsed < bestTime))
+                bestTime = elapsed;
+        }
+        BenchInput output;
+        output.name = input.name + ">" + MapFile::writeFormatName((MapFile::MAPWriteFormat)fmt);
+        output.start = content.data();
+        output.size = content.size();
+        output.numLines = countLines(output.start, output.start + output.size);
+        output.minRate = 0.0;
+        printRow(output, "write", bestTime, written.size(), numAllocs);
+        if (!bopts.verify)
+            continue;
+        MapFile::MAPParseOptions opts;
+        opts.minLineLen = BENCH_MIN_LINE_LEN;
+        opts.segments = &segments;
+        opts.verbose = false;
+        opts.numThreads = bopts.numThreads;
+        opts.mapBase = NULL;
+        opts.progress = NULL;
+        opts.filter = NULL;
+        opts.lineNumbers = true;
+        MapFile::MAPSymbolTable parsed;
+        MapFile::MAPParseStats stats;
+        std::string log;
+        MapFile::parseMapBuffer(output.start, output.start + output.size, opts, parsed, stats, log);
+        unsigned long long mismatches = (parsed.size() != written.size()) ? 1 : 0;
+        for (size_t i = 0; (i < written.size()) && (i < parsed.size()); i++)
+        {
+            size_t symNo = written[i];
+            if ((parsed.seg(i) == symbols.seg(symNo)) && (parsed.addr(i) == symbols.addr(symNo)) &&
+                (parsed.nameLen(i) == symbols.nameLen(symNo)) &&
+                (memcmp(parsed.name(i), symbols.name(symNo), parsed.nameLen(i)) == 0))
+                continue;
+            if (mismatches < MapRef::MAX_REPORTED_MISMATCHES)
+            {
+                printf("%s: symbol %lu read back as %04lX:%08llX %s, written %04lX:%08llX %s\n",
+                    output.name.c_str(), (unsigned long)i, parsed.seg(i) + 1, (unsigned long long)parsed.addr(i),
+                    parsed.name(i), symbols.seg(symNo) + 1, (unsigned long long)symbols.addr(symNo),
+                    symbols.name(symNo));
+            }
+            mismatches++;
+        }
+        printf("%s: read back %lu of %lu written symbols; %llu mismatches\n", output.name.c_str(),
+            (unsigned long)parsed.size(), (unsigned long)written.size(), mismatches);
+        if (mismatches > 0)
+            ok = false;
+    }
+    return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Measures the parser with an import filter.
+/// When verifying, the filtered symbols have to be the same as the ones of
+/// the complete parse which the filter accepts, in the same order.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool benchFilter(const BenchInput &input, const MapFile::MAPSymbolTable &symbols,
+    const MapFile::MAPSegmentMap &segments, const BenchOptions &bopts)
+{
+    MapFile::MAPParseOptions opts;
+    opts.minLineLen = BENCH_MIN_LINE_LEN;
+    opts.segments = &segments;
+    opts.verbose = false;
+    opts.numThreads = bopts.numThreads;
+    opts.mapBase = NULL;
+    opts.progress = NULL;
+    opts.filter = bopts.filter;
+    opts.lineNumbers = true;
+    double bestTime = -1.0;
+    unsigned long long numAllocs = 0;
+    MapFile::MAPSymbolTable filtered;
+    MapFile::MAPParseStats stats;
+    for (unsigned int rep = 0; rep < bopts.repeats; rep++)
+    {
+        std::string log;
+        filtered.clear();
+        unsigned long long allocsBefore = g_allocCount.load();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        MapFile::parseMapBuffer(input.start, input.start + input.size, opts, filtered, stats, log);
+        double elapsed = secondsSince(start);
+        numAllocs = g_allocCount.load() - allocsBefore;
+        if ((bestTime < 0.0) || (elapsed < bestTime))
+            bestTime = elapsed;
+    }
+    printRow(input, "filter", bestTime, filtered.size(), numAllocs);
+    if (!bopts.verify)
+        return true;
+    const MapFile::MAPFilter &filter = *bopts.filter;
+    unsigned long long numExpected = 0;
+    unsigned long long mismatches = 0;
+    size_t k = 0;
+    for (size_t i = 0; i < symbols.size(); i++)
+    {
+        if (!filter.acceptsAddress(symbols.seg(i), symbols.ea(i)) ||
+            !filter.acceptsObject(symbols.object(i), symbols.objectLen(i)) ||
+            !filter.acceptsName(symbols.name(i), symbols.nameLen(i)))
+            continue;
+        numExpected++;
+        if ((k < filtered.size()) && (filtered.seg(k) == symbols.seg(i)) && (filtered.addr(k) == symbols.addr(i)) &&
+            (filtered.nameLen(k) == symbols.nameLen(i)) &&
+            (memcmp(filtered.name(k), symbols.name(i), symbols.nameLen(i)) == 0) &&
+            (filtered.objectLen(k) == symbols.objectLen(i)) &&
+            (memcmp(filtered.object(k), symbols.object(i), symbols.objectLen(i)) == 0))
+        {
+            k++;
+            continue;
+        }
+        if (mismatches < MapRef::MAX_REPORTED_MISMATCHES)
+        {
+            printf("%s: filtered symbol %lu differs from accepted %04lX:%08llX %s %s\n", input.name.c_str(),
+                (unsigned long)k, symbols.seg(i) + 1, (unsigned long long)symbols.addr(i), symbols.name(i),
+                symbols.object(i));
+        }
+        mismatches++;
+        if (k < filtered.size())
+            k++;
+    }
+    if (filtered.size() != numExpected)
+        mismatches++;
+    printf("%s: filter kept %lu of %lu symbols, rejected %lu lines; %llu mismatches\n", input.name.c_str(),
+        (unsigned long)filtered.size(), (unsigned long)symbols.size(),
+        stats.lineResults[MapFile::FILTERED_LINE], mismatches);
+    return (mismatches == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Measures the line scanner alone, and then the whole parser.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool benchInput(const BenchInput &input, const BenchOptions &bopts)
+{
+    MapFile::MAPSegmentMap segments;
+    makeBenchSegments(segments);
+    // Line scanner only
+    {
+        std::vector<MapFile::MAPLine> lineIndex(4096);
+        double bestTime = -1.0;
+        unsigned long long numAllocs = 0;
+        for (unsigned int rep = 0; rep < bopts.repeats; rep++)
+        {
+            unsigned long long allocsBefore = g_allocCount.load();
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            const char * pScan = input.start;
+            const char * pEnd = input.start + input.size;
+            bool nulFound = false;
+            while (pScan < pEnd)
+            {
+                MapFile::scanLines(pScan, pEnd, &lineIndex[0], lineIndex.size(),
+                    BENCH_MIN_LINE_LEN, pScan, nulFound);
+            }
+            double elapsed = secondsSince(start);
+            numAllocs = g_allocCount.load() - allocsBefore;
+            if ((bestTime < 0.0) || (elapsed < bestTime))
+                bestTime = elapsed;
+        }
+        printRow(input, "scan", bestTime, 0, numAllocs);
+    }
+    // Complete parser
+    MapFile::MAPParseOptions opts;
+    opts.minLineLen = BENCH_MIN_LINE_LEN;
+    opts.segments = &segments;
+    opts.verbose = false;
+    opts.numThreads = bopts.numThreads;
+    opts.mapBase = NULL;
+    MapFile::MAPProgress progress(countProgress);
+    opts.progress = bopts.progress ? &progress : NULL;
+    opts.filter = NULL;
+    opts.lineNumbers = true;
+    double bestTime = -1.0;
+    unsigned long long numAllocs = 0;
+    unsigned long long numSymbols = 0;
+    MapFile::MAPSymbolTable symbols;
+    for (unsigned int rep = 0; rep < bopts.repeats; rep++)
+    {
+        MapFile::MAPParseStats stats;
+        std::string log;
+        symbols.clear();
+        unsigned long long allocsBefore = g_allocCount.load();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (opts.progress != NULL)
+            progress.startPhase("parse", input.size, true);
+        MapFile::parseMapBuffer(input.start, input.start + input.size, opts, symbols, stats, log);
+        double elapsed = secondsSince(start);
+        numAllocs = g_allocCount.load() - allocsBefore;
+        numSymbols = symbols.size();
+        if ((bestTime < 0.0) || (elapsed < bestTime))
+            bestTime = elapsed;
+        if (stats.sectionsFound == 0)
+        {
+            fprintf(stderr, "%s: no symbol sections recognized\n", input.name.c_str());
+            return false;
+        }
+    }
+    double rate = printRow(input, "parse", bestTime, numSymbols, numAllocs);
+    if (!symbols.lines().empty())
+    {
+        printf("%s: %llu line numbers, %.2f bytes each\n", input.name.c_str(),
+            (unsigned long long)symbols.lines().size(),
+            (double)symbols.lines().dataSize() / (double)symbols.lines().size());
+    }
+    bool ok = true;
+    if ((input.minRate > 0.0) && (rate < input.minRate))
+    {
+        printf("%s: parsing at %.2f Mlines/s, below the floor of %.2f Mlines/s\n",
+            input.name.c_str(), rate, input.minRate);
+        ok = false;
+    }
+    if (bopts.verify)
+    {
+        MapRef::VerifyStats vstats;
+        MapRef::clearVerifyStats(vstats);
+        MapRef::verifyMap(input.name, input.start, input.start + input.size, BENCH_MIN_LINE_LEN,
+            segments, symbols, bopts.fuzzLines, 1, vstats);
+        printf("%s: verified %llu lines, %llu symbols, %llu line numbers, %llu fuzzed lines; %llu mismatches\n",
+            input.name.c_str(), vstats.lines, vstats.symbols, vstats.lineNumbers, vstats.fuzzed, vstats.mismatches);
+        if (vstats.mismatches > 0)
+            ok = false;
+    }
+    ok = benchWrite(input, symbols, segments, bopts) && ok;
+    if (bopts.filter != NULL)
+        ok = benchFilter(input, symbols, segments, bopts) && ok;
+    return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Measures the parser fed by the streaming reader, including file reading.
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool benchStream(const BenchInput &input, const char * fileName, const BenchOptions &bopts)
+{
+    MapFile::MAPSegmentMap segments;
+    makeBenchSegments(segments);
+    MapFile::MAPParseOptions opts;
+    opts.minLineLen = BENCH_MIN_LINE_LEN;
+    opts.segments = &segments;
+    opts.verbose = false;
+    opts.numThreads = bopts.numThreads;
+    opts.mapBase = NULL;
+    MapFile::MAPProgress progress(countProgress);
+    opts.progress = bopts.progress ? &progress : NULL;
+    opts.filter = NULL;
+    opts.lineNumbers = true;
+    double bestTime = -1.0;
+    unsigned long long numAllocs = 0;
+    unsigned long long numSymbols = 0;
+    for (unsigned int rep = 0; rep < bopts.repeats; rep++)
+    {
+        MapFile::MAPStreamReader reader;
+        MapFile::MAPSymbolTable symbols;
+        MapFile::MAPParseStats stats;
+        std::string log;
+        unsigned long long allocsBefore = g_allocCount.load();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (reader.open(fileName) != MapFile::OPEN_NO_ERROR)
+        {
+            fprintf(stderr, "%s: cannot open for streaming, error %lu\n", fileName, reader.errorCode());
+            return false;
+        }
+        if (opts.progress != NULL)
+            progress.startPhase("stream", input.size, true);
+        bool readOk = MapFile::parseMapStream(reader, opts, symbols, stats, log);
+        reader.close();
+        double elapsed = secondsSince(start);
+        numAllocs = g_allocCount.load() - allocsBefore;
+        numSymbols = symbols.size();
+        if ((bestTime < 0.0) || (elapsed < bestTime))
+            bestTime = elapsed;
+        if (!readOk)
+        {
+            fprintf(stderr, "%s: read error %lu\n", fileName, reader.errorCode());
+            return false;
+        }
+        if (stats.sectionsFound == 0)
+        {
+            fprintf(stderr, "%s: no symbol sections recognized\n", fileName);
+            return false;
+        }
+    }
+    printRow(input, "stream", bestTime, numSymbols, numAllocs);
+    return true;
+}
+
+static void usage(const char * prog)
+{
+    fprintf(stderr, "usage: %s [-n symbols] [-f msvc|borland|watcom|gcc|all] [--crlf] [--long-names]\n"
+        "          [--lines pairs] [-t threads] [-r repeats] [--stream] [--progress] [--verify]\n"
+        "          [--fuzz lines] [--min-rate [format=]Mlines] [--filter spec] [file.map ...]\n"
+        "Without files, maps are generated in memory for each requested format.\n"
+        "With --lines, generated MSVC maps get line number tables with given amount\n"
+        "of line numbers.\n"
+        "With --stream, files are also parsed through the streaming reader.\n"
+        "With --progress, parsing reports progress, as it does in the plugin.\n"
+        "With --verify, results are compared with the original sscanf() parser, on\n"
+        "the whole input and on mutated lines of it, and maps written from parsed\n"
+        "symbols are parsed again and compared with them.\n"
+        "With --filter, inputs are also parsed with an import filter, like\n"
+        "\"seg=1 addr=0x401000-0x480000 obj=*.obj name=?Draw*\"; verifying compares\n"
+        "the result with symbols of the complete parse which the filter accepts.\n"
+        "With --min-rate, parsing slower than given Mlines/s fails; the floor may be\n"
+        "given for one format only. Exit code is 1 on any failure.\n", prog);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Reads throughput floor option, either "Mlines" or "format=Mlines".
+/// @return False if the option is not valid
+/// @author TL
+/// @date 2026.10.17
+////////////////////////////////////////////////////////////////////////////////
+static bool parseMinRate(const char * arg, double * minRates, double &minRateFiles)
+{
+    const char * pEq = strchr(arg, '=');
+    char * pNumEnd;
+    double rate = strtod((pEq != NULL) ? (pEq + 1) : arg, &pNumEnd);
+    if ((*pNumEnd != '\0') || (rate < 0.0))
+        return false;
+    if (pEq == NULL)
+    {
+        for (int fmt = 0; fmt < MapGen::FMT_COUNT; fmt++)
+            minRates[fmt] = rate;
+        minRateFiles = rate;
+        return true;
+    }
+    std::string name(arg, pEq - arg);
+    MapGen::MapFormat format;
+    if (!MapGen::formatFromName(name.c_str(), format))
+        return false;
+    minRates[format] = rate;
+    return true;
+}
+
+int main(int argc, char * argv[])
+{
+    MapGen::GenOptions gopts;
+    gopts.format = MapGen::FMT_MSVC;
+    gopts.numSymbols = 1000000;
+    gopts.crlf = false;
+    gopts.longNames = false;
+    gopts.numLines = 0;
+    gopts.seed = 1;
+    bool allFormats = true;
+    BenchOptions bopts;
+    bopts.numThreads = 0;
+    bopts.repeats = 3;
+    bopts.stream = false;
+    bopts.progress = false;
+    bopts.verify = false;
+    bopts.fuzzLines = 200000;
+    bopts.filter = NULL;
+    MapFile::MAPFilter filter;
+    double minRates[MapGen::FMT_COUNT];
+    double minRateFiles = 0.0;
+    for (int fmt = 0; fmt < MapGen::FMT_COUNT; fmt++)
+        minRates[fmt] = 0.0;
+    std::vector<const char *> fileNames;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasArg = (i + 1 < argc);
+        if ((strcmp(argv[i], "-f") == 0) && hasArg)
+        {
+            i++;
+            allFormats = (strcmp(argv[i], "all") == 0);
+            if (!allFormats && !MapGen::formatFromName(argv[i], gopts.format))
+            {
+                fprintf(stderr, "unknown format '%s'\n", argv[i]);
+                return 2;
+            }
+        }
+        else if ((strcmp(argv[i], "-n") == 0) && hasArg)
+            gopts.numSymbols = strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "-t") == 0) && hasArg)
+            bopts.numThreads = (unsigned int)strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "-r") == 0) && hasArg)
+            bopts.repeats = (unsigned int)strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "--crlf") == 0)
+            gopts.crlf = true;
+        else if (strcmp(argv[i], "--long-names") == 0)
+            gopts.longNames = true;
+        else if ((strcmp(argv[i], "--lines") == 0) && hasArg)
+            gopts.numLines = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "--stream") == 0)
+            bopts.stream = true;
+        else if (strcmp(argv[i], "--progress") == 0)
+            bopts.progress = true;
+        else if (strcmp(argv[i], "--verify") == 0)
+            bopts.verify = true;
+        else if ((strcmp(argv[i], "--fuzz") == 0) && hasArg)
+            bopts.fuzzLines = strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "--min-rate") == 0) && hasArg)
+        {
+            i++;
+            if (!parseMinRate(argv[i], minRates, minRateFiles))
+            {
+                fprintf(stderr, "invalid throughput floor '%s'\n", argv[i]);
+                return 2;
+            }
+        }
+        else if ((strcmp(argv[i], "--filter") == 0) && hasArg)
+        {
+            std::string error;
+            if (!filter.parse(argv[++i], error))
+            {
+                fprintf(stderr, "invalid filter: %s\n", error.c_str());
+                return 2;
+            }
+            bopts.filter = filter.empty() ? NULL : &filter;
+        }
+        else if (argv[i][0] != '-')
+            fileNames.push_back(argv[i]);
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (bopts.repeats < 1)
+        bopts.repeats = 1;
+
+    printf("line scanner: %s\n", MapFile::getLineScannerName());
+    printHeader();
+    bool ok = true;
+    if (!fileNames.empty())
+    {
+        for (size_t i = 0; i < fileNames.size(); i++)
+        {
+            char * mapAddr = NULL;
+            size_t mapSize = INVALID_MAPFILE_SIZE;
+            if (MapFile::openMAP(fileNames[i], mapAddr, mapSize) != MapFile::OPEN_NO_ERROR)
+            {
+                fprintf(stderr, "%s: cannot open, error %lu\n", fileNames[i],
+                    (unsigned long)MapFile::getLastErrorCode());
+                ok = false;
+                continue;
+            }
+            BenchInput input;
+            input.name = fileNames[i];
+            input.start = (const char *)mapAddr;
+            input.size = mapSize;
+            input.numLines = countLines(input.start, input.start + input.size);
+            input.minRate = minRateFiles;
+            ok = benchInput(input, bopts) && ok;
+            MapFile::closeMAP(mapAddr, mapSize);
+            if (bopts.stream)
+                ok = benchStream(input, fileNames[i], bopts) && ok;
+        }
+        if (bopts.progress)
+            printf("progress reports: %lu\n", g_progressReports);
+        return ok ? 0 : 1;
+    }
+
+    for (int fmt = 0; fmt < MapGen::FMT_COUNT; fmt++)
+    {
+        if (!allFormats && (fmt != gopts.format))
+            continue;
+        MapGen::GenOptions fmtOpts = gopts;
+        fmtOpts.format = (MapGen::MapFormat)fmt;
+        std::string content;
+        MapGen::generateMap(fmtOpts, content);
+        BenchInput input;
+        input.name = std::string(MapGen::formatName(fmtOpts.format)) +
+            (gopts.longNames ? "/long" : "") + (gopts.crlf ? "/crlf" : "") +
+            (((gopts.numLines > 0) && (fmt == MapGen::FMT_MSVC)) ? "/lines" : "");
+        input.start = content.data();
+        input.size = content.size();
+        input.numLines = countLines(input.start, input.start + input.size);
+        input.minRate = minRates[fmt];
+        ok = benchInput(input, bopts) && ok;
+    }
+    if (bopts.progress)
+        printf("progress reports: %lu\n", g_progressReports);
+    return ok ? 0 : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
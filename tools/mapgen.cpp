@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @file mapgen.cpp
+///     Synthetic MAP file generator tool.
+/// @par Purpose:
+///     Command line front-end for the MAP file generator.
+/// @author TL <mefistotelis@gmail.com>
+/// @date 2026.10.17 - 2026.10.17
+/// @par  Copying and copyrights:
+///     This program is free software; you can redistribute it and/or modify
+///     it under the terms of the GNU General Public License as published by
+///     the Free Software Foundation; either version 2 of the License, or
+///     (at your option) any later version.
+////////////////////////////////////////////////////////////////////////////////
+
+#include  <cstdio>
+#include  <cstdlib>
+#include  <cstring>
+#include  <string>
+
+#include  "MAPGenerator.h"
+
+static void usage(const char * prog)
+{
+    fprintf(stderr, "usage: %s [-f msvc|borland|watcom|gcc] [-n symbols] [-s seed]\n"
+        "          [--crlf] [--long-names] [--lines pairs] [-o output.map]\n", prog);
+}
+
+int main(int argc, char * argv[])
+{
+    MapGen::GenOptions opts;
+    opts.format = MapGen::FMT_MSVC;
+    opts.numSymbols = 10000;
+    opts.crlf = false;
+    opts.longNames = false;
+    opts.numLines = 0;
+    opts.seed = 1;
+    const char * outName = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasArg = (i + 1 < argc);
+        if ((strcmp(argv[i], "-f") == 0) && hasArg)
+        {
+            if (!MapGen::formatFromName(argv[++i], opts.format))
+            {
+                fprintf(stderr, "unknown format '%s'\n", argv[i]);
+                return 2;
+            }
+        }
+        else if ((strcmp(argv[i], "-n") == 0) && hasArg)
+            opts.numSymbols = strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "-s") == 0) && hasArg)
+            opts.seed = strtoul(argv[++i], NULL, 0);
+        else if ((strcmp(argv[i], "-o") == 0) && hasArg)
+            outName = argv[++i];
+        else if (strcmp(argv[i], "--crlf") == 0)
+            opts.crlf = true;
+        else if (strcmp(argv[i], "--long-names") == 0)
+            opts.longNames = true;
+        else if ((strcmp(argv[i], "--lines") == 0) && hasArg)
+            opts.numLines = strtoul(argv[++i], NULL, 0);
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    std::string content;
+    MapGen::generateMap(opts, content);
+
+    FILE * fp = (outName != NULL) ? fopen(outName, "wb") : stdout;
+    if (fp == NULL)
+    {
+        perror(outName);
+        return 1;
+    }
+    size_t written = fwrite(content.data(), 1, content.size(), fp);
+    if (fp != stdout)
+        fclose(fp);
+    if (written != content.size())
+    {
+        fprintf(stderr, "write failed\n");
+        return 1;
+    }
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////